@@ -0,0 +1,13 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_prof_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("_deps/fmt-build")
+subdirs("lib8080")
+subdirs("recompiler")
+subdirs("tester")
+subdirs("bench")
+subdirs("tracedump")
+subdirs("capi")
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/bench/main.cpp" "bench/CMakeFiles/bench.dir/main.cpp.o" "gcc" "bench/CMakeFiles/bench.dir/main.cpp.o.d"
+  "/root/repo/_prof_build/bench/test8080_native.cpp" "bench/CMakeFiles/bench.dir/test8080_native.cpp.o" "gcc" "bench/CMakeFiles/bench.dir/test8080_native.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_prof_build/lib8080/CMakeFiles/i8080.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,14 @@
+file(REMOVE_RECURSE
+  "../bin/bench"
+  "../bin/bench.pdb"
+  "CMakeFiles/bench.dir/main.cpp.o"
+  "CMakeFiles/bench.dir/main.cpp.o.d"
+  "CMakeFiles/bench.dir/test8080_native.cpp.o"
+  "CMakeFiles/bench.dir/test8080_native.cpp.o.d"
+  "test8080_native.cpp"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/bench
+# Build directory: /root/repo/_prof_build/bench
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[perf_test8080]=] "/root/repo/_prof_build/bin/bench" "--filter" "macro/test8080" "--repeat" "7" "--min-time" "0.25" "--reference" "macro/alu" "--baseline" "/root/repo/bench/baseline.json" "--tolerance" "0.3")
+set_tests_properties([=[perf_test8080]=] PROPERTIES  LABELS "perf" RUN_SERIAL "TRUE" _BACKTRACE_TRIPLES "/root/repo/bench/CMakeLists.txt;38;add_test;/root/repo/bench/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/crun"
+  "../bin/crun.pdb"
+  "CMakeFiles/crun.dir/crun.c.o"
+  "CMakeFiles/crun.dir/crun.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/crun.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../lib/libi8080_c.pdb"
+  "../lib/libi8080_c.so"
+  "../lib/libi8080_c.so.1"
+  "../lib/libi8080_c.so.1.0"
+  "CMakeFiles/i8080_c.dir/capi.cpp.o"
+  "CMakeFiles/i8080_c.dir/capi.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/i8080_c.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
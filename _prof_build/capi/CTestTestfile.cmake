@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/capi
+# Build directory: /root/repo/_prof_build/capi
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[capi_test8080]=] "/root/repo/_prof_build/bin/crun" "/root/repo/resources/test8080.com")
+set_tests_properties([=[capi_test8080]=] PROPERTIES  FAIL_REGULAR_EXPRESSION "CPU HAS FAILED" PASS_REGULAR_EXPRESSION "CPU IS OPERATIONAL" _BACKTRACE_TRIPLES "/root/repo/capi/CMakeLists.txt;42;add_test;/root/repo/capi/CMakeLists.txt;0;")
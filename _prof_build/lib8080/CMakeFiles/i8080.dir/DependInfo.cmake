@@ -0,0 +1,43 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/lib8080/asm.cpp" "lib8080/CMakeFiles/i8080.dir/asm.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/asm.cpp.o.d"
+  "/root/repo/lib8080/blockcosts.cpp" "lib8080/CMakeFiles/i8080.dir/blockcosts.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/blockcosts.cpp.o.d"
+  "/root/repo/lib8080/breakpoints.cpp" "lib8080/CMakeFiles/i8080.dir/breakpoints.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/breakpoints.cpp.o.d"
+  "/root/repo/lib8080/bus.cpp" "lib8080/CMakeFiles/i8080.dir/bus.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/bus.cpp.o.d"
+  "/root/repo/lib8080/callgraph.cpp" "lib8080/CMakeFiles/i8080.dir/callgraph.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/callgraph.cpp.o.d"
+  "/root/repo/lib8080/cosim.cpp" "lib8080/CMakeFiles/i8080.dir/cosim.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/cosim.cpp.o.d"
+  "/root/repo/lib8080/cpm.cpp" "lib8080/CMakeFiles/i8080.dir/cpm.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/cpm.cpp.o.d"
+  "/root/repo/lib8080/cpu.cpp" "lib8080/CMakeFiles/i8080.dir/cpu.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/cpu.cpp.o.d"
+  "/root/repo/lib8080/disasm.cpp" "lib8080/CMakeFiles/i8080.dir/disasm.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/disasm.cpp.o.d"
+  "/root/repo/lib8080/gdbstub.cpp" "lib8080/CMakeFiles/i8080.dir/gdbstub.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/gdbstub.cpp.o.d"
+  "/root/repo/lib8080/heatmap.cpp" "lib8080/CMakeFiles/i8080.dir/heatmap.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/heatmap.cpp.o.d"
+  "/root/repo/lib8080/imagecache.cpp" "lib8080/CMakeFiles/i8080.dir/imagecache.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/imagecache.cpp.o.d"
+  "/root/repo/lib8080/machine.cpp" "lib8080/CMakeFiles/i8080.dir/machine.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/machine.cpp.o.d"
+  "/root/repo/lib8080/metrics.cpp" "lib8080/CMakeFiles/i8080.dir/metrics.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/metrics.cpp.o.d"
+  "/root/repo/lib8080/model.cpp" "lib8080/CMakeFiles/i8080.dir/model.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/model.cpp.o.d"
+  "/root/repo/lib8080/pacer.cpp" "lib8080/CMakeFiles/i8080.dir/pacer.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/pacer.cpp.o.d"
+  "/root/repo/lib8080/profile.cpp" "lib8080/CMakeFiles/i8080.dir/profile.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/profile.cpp.o.d"
+  "/root/repo/lib8080/recompiler.cpp" "lib8080/CMakeFiles/i8080.dir/recompiler.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/recompiler.cpp.o.d"
+  "/root/repo/lib8080/sampler.cpp" "lib8080/CMakeFiles/i8080.dir/sampler.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/sampler.cpp.o.d"
+  "/root/repo/lib8080/scheduler.cpp" "lib8080/CMakeFiles/i8080.dir/scheduler.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/scheduler.cpp.o.d"
+  "/root/repo/lib8080/symbols.cpp" "lib8080/CMakeFiles/i8080.dir/symbols.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/symbols.cpp.o.d"
+  "/root/repo/lib8080/system.cpp" "lib8080/CMakeFiles/i8080.dir/system.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/system.cpp.o.d"
+  "/root/repo/lib8080/timetravel.cpp" "lib8080/CMakeFiles/i8080.dir/timetravel.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/timetravel.cpp.o.d"
+  "/root/repo/lib8080/trace.cpp" "lib8080/CMakeFiles/i8080.dir/trace.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/trace.cpp.o.d"
+  "/root/repo/lib8080/workload.cpp" "lib8080/CMakeFiles/i8080.dir/workload.cpp.o" "gcc" "lib8080/CMakeFiles/i8080.dir/workload.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,59 @@
+file(REMOVE_RECURSE
+  "../lib/libi8080.a"
+  "../lib/libi8080.pdb"
+  "CMakeFiles/i8080.dir/asm.cpp.o"
+  "CMakeFiles/i8080.dir/asm.cpp.o.d"
+  "CMakeFiles/i8080.dir/blockcosts.cpp.o"
+  "CMakeFiles/i8080.dir/blockcosts.cpp.o.d"
+  "CMakeFiles/i8080.dir/breakpoints.cpp.o"
+  "CMakeFiles/i8080.dir/breakpoints.cpp.o.d"
+  "CMakeFiles/i8080.dir/bus.cpp.o"
+  "CMakeFiles/i8080.dir/bus.cpp.o.d"
+  "CMakeFiles/i8080.dir/callgraph.cpp.o"
+  "CMakeFiles/i8080.dir/callgraph.cpp.o.d"
+  "CMakeFiles/i8080.dir/cosim.cpp.o"
+  "CMakeFiles/i8080.dir/cosim.cpp.o.d"
+  "CMakeFiles/i8080.dir/cpm.cpp.o"
+  "CMakeFiles/i8080.dir/cpm.cpp.o.d"
+  "CMakeFiles/i8080.dir/cpu.cpp.o"
+  "CMakeFiles/i8080.dir/cpu.cpp.o.d"
+  "CMakeFiles/i8080.dir/disasm.cpp.o"
+  "CMakeFiles/i8080.dir/disasm.cpp.o.d"
+  "CMakeFiles/i8080.dir/gdbstub.cpp.o"
+  "CMakeFiles/i8080.dir/gdbstub.cpp.o.d"
+  "CMakeFiles/i8080.dir/heatmap.cpp.o"
+  "CMakeFiles/i8080.dir/heatmap.cpp.o.d"
+  "CMakeFiles/i8080.dir/imagecache.cpp.o"
+  "CMakeFiles/i8080.dir/imagecache.cpp.o.d"
+  "CMakeFiles/i8080.dir/machine.cpp.o"
+  "CMakeFiles/i8080.dir/machine.cpp.o.d"
+  "CMakeFiles/i8080.dir/metrics.cpp.o"
+  "CMakeFiles/i8080.dir/metrics.cpp.o.d"
+  "CMakeFiles/i8080.dir/model.cpp.o"
+  "CMakeFiles/i8080.dir/model.cpp.o.d"
+  "CMakeFiles/i8080.dir/pacer.cpp.o"
+  "CMakeFiles/i8080.dir/pacer.cpp.o.d"
+  "CMakeFiles/i8080.dir/profile.cpp.o"
+  "CMakeFiles/i8080.dir/profile.cpp.o.d"
+  "CMakeFiles/i8080.dir/recompiler.cpp.o"
+  "CMakeFiles/i8080.dir/recompiler.cpp.o.d"
+  "CMakeFiles/i8080.dir/sampler.cpp.o"
+  "CMakeFiles/i8080.dir/sampler.cpp.o.d"
+  "CMakeFiles/i8080.dir/scheduler.cpp.o"
+  "CMakeFiles/i8080.dir/scheduler.cpp.o.d"
+  "CMakeFiles/i8080.dir/symbols.cpp.o"
+  "CMakeFiles/i8080.dir/symbols.cpp.o.d"
+  "CMakeFiles/i8080.dir/system.cpp.o"
+  "CMakeFiles/i8080.dir/system.cpp.o.d"
+  "CMakeFiles/i8080.dir/timetravel.cpp.o"
+  "CMakeFiles/i8080.dir/timetravel.cpp.o.d"
+  "CMakeFiles/i8080.dir/trace.cpp.o"
+  "CMakeFiles/i8080.dir/trace.cpp.o.d"
+  "CMakeFiles/i8080.dir/workload.cpp.o"
+  "CMakeFiles/i8080.dir/workload.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/i8080.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
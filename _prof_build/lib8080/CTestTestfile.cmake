@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/lib8080
+# Build directory: /root/repo/_prof_build/lib8080
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
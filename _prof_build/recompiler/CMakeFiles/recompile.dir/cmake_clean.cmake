@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/recompile"
+  "../bin/recompile.pdb"
+  "CMakeFiles/recompile.dir/main.cpp.o"
+  "CMakeFiles/recompile.dir/main.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/recompile.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
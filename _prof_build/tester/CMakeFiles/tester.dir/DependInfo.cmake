@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tester/main.cpp" "tester/CMakeFiles/tester.dir/main.cpp.o" "gcc" "tester/CMakeFiles/tester.dir/main.cpp.o.d"
+  "/root/repo/_prof_build/tester/test8080_native.cpp" "tester/CMakeFiles/tester.dir/test8080_native.cpp.o" "gcc" "tester/CMakeFiles/tester.dir/test8080_native.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_prof_build/lib8080/CMakeFiles/i8080.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,14 @@
+file(REMOVE_RECURSE
+  "../bin/tester"
+  "../bin/tester.pdb"
+  "CMakeFiles/tester.dir/main.cpp.o"
+  "CMakeFiles/tester.dir/main.cpp.o.d"
+  "CMakeFiles/tester.dir/test8080_native.cpp.o"
+  "CMakeFiles/tester.dir/test8080_native.cpp.o.d"
+  "test8080_native.cpp"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tester.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
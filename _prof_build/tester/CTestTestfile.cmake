@@ -0,0 +1,71 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tester
+# Build directory: /root/repo/_prof_build/tester
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[test8080]=] "/root/repo/_prof_build/bin/tester" "/root/repo/resources/test8080.com")
+set_tests_properties([=[test8080]=] PROPERTIES  FAIL_REGULAR_EXPRESSION "CPU HAS FAILED" PASS_REGULAR_EXPRESSION "CPU IS OPERATIONAL" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;12;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[realtime_test8080]=] "/root/repo/_prof_build/bin/tester" "--realtime" "/root/repo/resources/test8080.com" "100000")
+set_tests_properties([=[realtime_test8080]=] PROPERTIES  PASS_REGULAR_EXPRESSION "CPU IS OPERATIONAL.*Paced at 100000 Hz: 48 slices" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;22;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[realtime_zero_clock]=] "/root/repo/_prof_build/bin/tester" "--realtime" "/root/repo/resources/test8080.com" "0")
+set_tests_properties([=[realtime_zero_clock]=] PROPERTIES  PASS_REGULAR_EXPRESSION "Invalid pacer clock: 0 Hz" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;32;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[metrics_test8080]=] "/root/repo/_prof_build/bin/tester" "--metrics" "/root/repo/resources/test8080.com" "/root/repo/_prof_build/tester/test8080.prom")
+set_tests_properties([=[metrics_test8080]=] PROPERTIES  PASS_REGULAR_EXPRESSION "hits_total{[^}]*} 4
+.*misses_total{[^}]*} 174
+.*port=\"0\"} 1.* samples in 13 families, 0 format errors" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;42;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[cosim]=] "/root/repo/_prof_build/bin/tester" "--cosim" "64" "20000")
+set_tests_properties([=[cosim]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;55;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[cosim_fast]=] "/root/repo/_prof_build/bin/tester" "--cosim" "16" "20000" "fast")
+set_tests_properties([=[cosim_fast]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;60;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[batch]=] "/root/repo/_prof_build/bin/tester" "--batch" "/root/repo/resources")
+set_tests_properties([=[batch]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;65;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[batch_shared_roms]=] "/root/repo/_prof_build/bin/tester" "--batch" "--shared-roms" "/root/repo/resources")
+set_tests_properties([=[batch_shared_roms]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;70;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[native_test8080]=] "/root/repo/_prof_build/bin/tester" "--native" "/root/repo/resources/test8080.com")
+set_tests_properties([=[native_test8080]=] PROPERTIES  FAIL_REGULAR_EXPRESSION "CPU HAS FAILED" PASS_REGULAR_EXPRESSION "CPU IS OPERATIONAL" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;77;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[cosim_native_test8080]=] "/root/repo/_prof_build/bin/tester" "--cosim-native" "/root/repo/resources/test8080.com")
+set_tests_properties([=[cosim_native_test8080]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;87;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[disasm_test8080]=] "/root/repo/_prof_build/bin/tester" "--disasm" "/root/repo/resources/test8080.com" "/root/repo/resources/test8080.txt")
+set_tests_properties([=[disasm_test8080]=] PROPERTIES  PASS_REGULAR_EXPRESSION "[1-9][0-9]* listing instructions, 0 mismatches" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;92;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[disasm_aliases]=] "/root/repo/_prof_build/bin/tester" "--disasm" "/root/repo/resources/disasm/aliases.com")
+set_tests_properties([=[disasm_aliases]=] PROPERTIES  PASS_REGULAR_EXPRESSION "NOP8 L0107
+.* NOP6 L010A
+ 0106 00 +DB 0x00
+.*L0107: +NOP7
+ 0108 0000 +DB.*L010A: +HLT" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;103;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[heatmap_test8080]=] "/root/repo/_prof_build/bin/tester" "--heatmap" "/root/repo/resources/test8080.com" "/root/repo/_prof_build/tester/test8080_heatmap.csv" "1000")
+set_tests_properties([=[heatmap_test8080]=] PROPERTIES  PASS_REGULAR_EXPRESSION "8 pages touched: 77 reads, 60 writes, 651 fetches.*0x0700-07ff +36 +36 +0
+.*over 5 windows" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;116;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[reverse_test8080]=] "/root/repo/_prof_build/bin/tester" "--reverse" "/root/repo/resources/test8080.com")
+set_tests_properties([=[reverse_test8080]=] PROPERTIES  PASS_REGULAR_EXPRESSION "instructions and 0 interrupts reverse-stepped over [1-9][0-9]* checkpoints, 0 mismatches" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;130;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[reverse_interrupts]=] "/root/repo/_prof_build/bin/tester" "--reverse" "/root/repo/resources/scheduler/timer.com" "16")
+set_tests_properties([=[reverse_interrupts]=] PROPERTIES  PASS_REGULAR_EXPRESSION "instructions and 3 interrupts reverse-stepped over [1-9][0-9]* checkpoints, 0 mismatches" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;141;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[scheduler_timer]=] "/root/repo/_prof_build/bin/tester" "--timer" "/root/repo/resources/scheduler/timer.com" "1000")
+set_tests_properties([=[scheduler_timer]=] PROPERTIES  PASS_REGULAR_EXPRESSION "3 timer interrupts raised.*CPU ran 30[0-9][0-9] cycles" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;151;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[system_pingpong]=] "/root/repo/_prof_build/bin/tester" "--system" "/root/repo/resources/system/pingpong.com" "1000")
+set_tests_properties([=[system_pingpong]=] PROPERTIES  PASS_REGULAR_EXPRESSION "2 CPUs ran 1000 quanta of 1000 cycles, ball passed 200 times" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;161;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[system_zero_quantum]=] "/root/repo/_prof_build/bin/tester" "--system" "/root/repo/resources/system/pingpong.com" "0")
+set_tests_properties([=[system_zero_quantum]=] PROPERTIES  PASS_REGULAR_EXPRESSION "Invalid system quantum: 0" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;171;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[watch_test8080]=] "/root/repo/_prof_build/bin/tester" "--watch" "/root/repo/resources/test8080.com" "0x06bf" "value == 0xaa")
+set_tests_properties([=[watch_test8080]=] PROPERTIES  PASS_REGULAR_EXPRESSION "Write at 0x06bf value=0xaa pc=0x052e.*2 hits" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;181;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[cpm_test8080]=] "/root/repo/_prof_build/bin/tester" "--cpm" "/root/repo/resources/test8080.com" "/root/repo/_prof_build/tester")
+set_tests_properties([=[cpm_test8080]=] PROPERTIES  FAIL_REGULAR_EXPRESSION "CPU HAS FAILED" PASS_REGULAR_EXPRESSION "CPU IS OPERATIONAL" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;191;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[cpm_fileio]=] "/root/repo/_prof_build/bin/tester" "--cpm" "/root/repo/resources/cpm/fileio.com" "/root/repo/_prof_build/tester")
+set_tests_properties([=[cpm_fileio]=] PROPERTIES  FAIL_REGULAR_EXPRESSION "FILE IO FAILED" PASS_REGULAR_EXPRESSION "FILE IO OK" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;201;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[workloads]=] "/root/repo/_prof_build/bin/tester" "--workload" "all")
+set_tests_properties([=[workloads]=] PROPERTIES  PASS_REGULAR_EXPRESSION "12 of 12 runs halted" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;212;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[callgraph_skipret]=] "/root/repo/_prof_build/bin/tester" "--callgraph" "/root/repo/resources/callgraph/skipret.com" "/root/repo/resources/callgraph/skipret.txt" "/root/repo/_prof_build/tester/skipret.callgrind")
+set_tests_properties([=[callgraph_skipret]=] PROPERTIES  PASS_REGULAR_EXPRESSION " 37 +17 +1  OUTER.* 20 +20 +1  INNER" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;219;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[callgraph_aliases]=] "/root/repo/_prof_build/bin/tester" "--callgraph" "/root/repo/resources/callgraph/aliases.com" "/root/repo/resources/callgraph/aliases.txt" "/root/repo/_prof_build/tester/aliases.callgrind")
+set_tests_properties([=[callgraph_aliases]=] PROPERTIES  PASS_REGULAR_EXPRESSION "-> INNER \\(1 calls, 17 cycles\\)
+ +17 +17 +1  INNER" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;232;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[machine_pool]=] "/root/repo/_prof_build/bin/tester" "--pool" "4")
+set_tests_properties([=[machine_pool]=] PROPERTIES  PASS_REGULAR_EXPRESSION "checks on a pool of 4, 0 failures" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;245;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[gdb_script_test8080]=] "/root/repo/_prof_build/bin/tester" "--gdb-script" "/root/repo/resources/test8080.com" "/root/repo/_prof_build/tester/gdb_script.sock")
+set_tests_properties([=[gdb_script_test8080]=] PROPERTIES  PASS_REGULAR_EXPRESSION "9 packets exchanged, 0 mismatches, 0 stops the debugger did not ask for" TIMEOUT "30" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;255;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[profile_test8080]=] "/usr/bin/cmake" "-DTESTER=/root/repo/_prof_build/bin/tester" "-DROM=/root/repo/resources/test8080.com" "-DLISTING=/root/repo/resources/test8080.txt" "-DFOLDED=/root/repo/_prof_build/tester/test8080.folded" "-DSYMBOLS=MOVI,CPOI,CMI,CPUOK" "-P" "/root/repo/tester/check_profile.cmake")
+set_tests_properties([=[profile_test8080]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;270;add_test;/root/repo/tester/CMakeLists.txt;0;")
+add_test([=[opcode_profile_test8080]=] "/root/repo/_prof_build/bin/tester" "--opcode-profile" "/root/repo/resources/test8080.com")
+set_tests_properties([=[opcode_profile_test8080]=] PROPERTIES  PASS_REGULAR_EXPRESSION "0xc4   CNZ +77 [^
+]* 853 .*651 of 651 instructions and 4924 of 4924 cycles profiled" _BACKTRACE_TRIPLES "/root/repo/tester/CMakeLists.txt;283;add_test;/root/repo/tester/CMakeLists.txt;0;")
@@ -0,0 +1,3493 @@
+// Generated by the i8080 recompiler, do not edit
+
+#include <i8080/native.h>
+
+#include <utility>
+
+using namespace i8080::native;
+
+namespace
+{
+const uint8_t IMAGE[] = {
+    0xc3, 0xb2, 0x01, 0x4d, 0x49, 0x43, 0x52, 0x4f, 0x43, 0x4f, 0x53, 0x4d, 0x20, 0x41, 0x53, 0x53,
+    0x4f, 0x43, 0x49, 0x41, 0x54, 0x45, 0x53, 0x20, 0x38, 0x30, 0x38, 0x30, 0x2f, 0x38, 0x30, 0x38,
+    0x35, 0x20, 0x43, 0x50, 0x55, 0x20, 0x44, 0x49, 0x41, 0x47, 0x4e, 0x4f, 0x53, 0x54, 0x49, 0x43,
+    0x0d, 0x0a, 0x20, 0x56, 0x45, 0x52, 0x53, 0x49, 0x4f, 0x4e, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x20,
+    0x28, 0x43, 0x29, 0x20, 0x31, 0x39, 0x38, 0x30, 0x0d, 0x0a, 0x24, 0xd5, 0xeb, 0x0e, 0x09, 0xcd,
+    0x05, 0x00, 0xd1, 0xc9, 0x0e, 0x02, 0xcd, 0x05, 0x00, 0xc9, 0xf5, 0xcd, 0x6a, 0x01, 0x5f, 0xcd,
+    0x54, 0x01, 0xf1, 0xcd, 0x6e, 0x01, 0x5f, 0xc3, 0x54, 0x01, 0x0f, 0x0f, 0x0f, 0x0f, 0xe6, 0x0f,
+    0xfe, 0x0a, 0xfa, 0x77, 0x01, 0xc6, 0x07, 0xc6, 0x30, 0xc9, 0x0d, 0x0a, 0x20, 0x43, 0x50, 0x55,
+    0x20, 0x49, 0x53, 0x20, 0x4f, 0x50, 0x45, 0x52, 0x41, 0x54, 0x49, 0x4f, 0x4e, 0x41, 0x4c, 0x24,
+    0x0d, 0x0a, 0x20, 0x43, 0x50, 0x55, 0x20, 0x48, 0x41, 0x53, 0x20, 0x46, 0x41, 0x49, 0x4c, 0x45,
+    0x44, 0x21, 0x20, 0x20, 0x20, 0x20, 0x45, 0x52, 0x52, 0x4f, 0x52, 0x20, 0x45, 0x58, 0x49, 0x54,
+    0x3d, 0x24, 0x31, 0xbd, 0x07, 0x21, 0x03, 0x01, 0xcd, 0x4b, 0x01, 0xe6, 0x00, 0xca, 0xc3, 0x01,
+    0xcd, 0xa0, 0x06, 0xd2, 0xc9, 0x01, 0xcd, 0xa0, 0x06, 0xea, 0xcf, 0x01, 0xcd, 0xa0, 0x06, 0xf2,
+    0xd5, 0x01, 0xcd, 0xa0, 0x06, 0xc2, 0xe4, 0x01, 0xda, 0xe4, 0x01, 0xe2, 0xe4, 0x01, 0xfa, 0xe4,
+    0x01, 0xc3, 0xe7, 0x01, 0xcd, 0xa0, 0x06, 0xc6, 0x06, 0xc2, 0xef, 0x01, 0xcd, 0xa0, 0x06, 0xda,
+    0xf8, 0x01, 0xe2, 0xf8, 0x01, 0xf2, 0xfb, 0x01, 0xcd, 0xa0, 0x06, 0xc6, 0x70, 0xe2, 0x03, 0x02,
+    0xcd, 0xa0, 0x06, 0xfa, 0x0c, 0x02, 0xca, 0x0c, 0x02, 0xd2, 0x0f, 0x02, 0xcd, 0xa0, 0x06, 0xc6,
+    0x81, 0xfa, 0x17, 0x02, 0xcd, 0xa0, 0x06, 0xca, 0x20, 0x02, 0xda, 0x20, 0x02, 0xe2, 0x23, 0x02,
+    0xcd, 0xa0, 0x06, 0xc6, 0xfe, 0xda, 0x2b, 0x02, 0xcd, 0xa0, 0x06, 0xca, 0x34, 0x02, 0xe2, 0x34,
+    0x02, 0xfa, 0x37, 0x02, 0xcd, 0xa0, 0x06, 0xfe, 0x00, 0xda, 0x4f, 0x02, 0xca, 0x4f, 0x02, 0xfe,
+    0xf5, 0xda, 0x4f, 0x02, 0xc2, 0x4f, 0x02, 0xfe, 0xff, 0xca, 0x4f, 0x02, 0xda, 0x52, 0x02, 0xcd,
+    0xa0, 0x06, 0xce, 0x0a, 0xce, 0x0a, 0xfe, 0x0b, 0xca, 0x5e, 0x02, 0xcd, 0xa0, 0x06, 0xd6, 0x0c,
+    0xd6, 0x0f, 0xfe, 0xf0, 0xca, 0x6a, 0x02, 0xcd, 0xa0, 0x06, 0xde, 0xf1, 0xde, 0x0e, 0xfe, 0xf0,
+    0xca, 0x76, 0x02, 0xcd, 0xa0, 0x06, 0xe6, 0x55, 0xfe, 0x50, 0xca, 0x80, 0x02, 0xcd, 0xa0, 0x06,
+    0xf6, 0x3a, 0xfe, 0x7a, 0xca, 0x8a, 0x02, 0xcd, 0xa0, 0x06, 0xee, 0x0f, 0xfe, 0x75, 0xca, 0x94,
+    0x02, 0xcd, 0xa0, 0x06, 0xe6, 0x00, 0xdc, 0xa0, 0x06, 0xe4, 0xa0, 0x06, 0xfc, 0xa0, 0x06, 0xc4,
+    0xa0, 0x06, 0xfe, 0x00, 0xca, 0xaa, 0x02, 0xcd, 0xa0, 0x06, 0xd6, 0x77, 0xd4, 0xa0, 0x06, 0xec,
+    0xa0, 0x06, 0xf4, 0xa0, 0x06, 0xcc, 0xa0, 0x06, 0xfe, 0x89, 0xca, 0xc0, 0x02, 0xcd, 0xa0, 0x06,
+    0xe6, 0xff, 0xe4, 0xcd, 0x02, 0xfe, 0xd9, 0xca, 0x2a, 0x03, 0xcd, 0xa0, 0x06, 0xe8, 0xc6, 0x10,
+    0xec, 0xd9, 0x02, 0xc6, 0x02, 0xe0, 0xcd, 0xa0, 0x06, 0xe0, 0xc6, 0x20, 0xfc, 0xe5, 0x02, 0xc6,
+    0x04, 0xe8, 0xcd, 0xa0, 0x06, 0xf0, 0xc6, 0x80, 0xf4, 0xf1, 0x02, 0xc6, 0x80, 0xf8, 0xcd, 0xa0,
+    0x06, 0xf8, 0xc6, 0x40, 0xd4, 0xfd, 0x02, 0xc6, 0x40, 0xf0, 0xcd, 0xa0, 0x06, 0xd8, 0xc6, 0x8f,
+    0xdc, 0x09, 0x03, 0xd6, 0x02, 0xd0, 0xcd, 0xa0, 0x06, 0xd0, 0xc6, 0xf7, 0xc4, 0x15, 0x03, 0xc6,
+    0xfe, 0xd8, 0xcd, 0xa0, 0x06, 0xc8, 0xc6, 0x01, 0xcc, 0x21, 0x03, 0xc6, 0xd0, 0xc0, 0xcd, 0xa0,
+    0x06, 0xc0, 0xc6, 0x47, 0xfe, 0x47, 0xc8, 0xcd, 0xa0, 0x06, 0x3e, 0x77, 0x3c, 0x47, 0x04, 0x48,
+    0x0d, 0x51, 0x5a, 0x63, 0x6c, 0x7d, 0x3d, 0x4f, 0x59, 0x6b, 0x45, 0x50, 0x62, 0x7c, 0x57, 0x14,
+    0x6a, 0x4d, 0x0c, 0x61, 0x44, 0x05, 0x58, 0x7b, 0x5f, 0x1c, 0x43, 0x60, 0x24, 0x4c, 0x69, 0x55,
+    0x15, 0x7a, 0x67, 0x25, 0x54, 0x42, 0x68, 0x2c, 0x5d, 0x1d, 0x4b, 0x79, 0x6f, 0x2d, 0x65, 0x5c,
+    0x53, 0x4a, 0x41, 0x78, 0xfe, 0x77, 0xc4, 0xa0, 0x06, 0xaf, 0x06, 0x01, 0x0e, 0x03, 0x16, 0x07,
+    0x1e, 0x0f, 0x26, 0x1f, 0x2e, 0x3f, 0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x87, 0xfe, 0xf0, 0xc4,
+    0xa0, 0x06, 0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0xfe, 0x78, 0xc4, 0xa0, 0x06, 0x97, 0xc4, 0xa0,
+    0x06, 0x3e, 0x80, 0x87, 0x06, 0x01, 0x0e, 0x02, 0x16, 0x03, 0x1e, 0x04, 0x26, 0x05, 0x2e, 0x06,
+    0x88, 0x06, 0x80, 0x80, 0x80, 0x89, 0x80, 0x80, 0x8a, 0x80, 0x80, 0x8b, 0x80, 0x80, 0x8c, 0x80,
+    0x80, 0x8d, 0x80, 0x80, 0x8f, 0xfe, 0x37, 0xc4, 0xa0, 0x06, 0x3e, 0x80, 0x87, 0x06, 0x01, 0x98,
+    0x06, 0xff, 0x80, 0x99, 0x80, 0x9a, 0x80, 0x9b, 0x80, 0x9c, 0x80, 0x9d, 0xfe, 0xe0, 0xc4, 0xa0,
+    0x06, 0x3e, 0x80, 0x87, 0x9f, 0xfe, 0xff, 0xc4, 0xa0, 0x06, 0x3e, 0xff, 0x06, 0xfe, 0x0e, 0xfc,
+    0x16, 0xef, 0x1e, 0x7f, 0x26, 0xf4, 0x2e, 0xbf, 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa7, 0xfe,
+    0x24, 0xc4, 0xa0, 0x06, 0xaf, 0x06, 0x01, 0x0e, 0x02, 0x16, 0x04, 0x1e, 0x08, 0x26, 0x10, 0x2e,
+    0x20, 0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0xb5, 0xb7, 0xfe, 0x3f, 0xc4, 0xa0, 0x06, 0x3e, 0x00, 0x26,
+    0x8f, 0x2e, 0x4f, 0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xfe, 0xcf, 0xc4, 0xa0, 0x06, 0xaf, 0xc4,
+    0xa0, 0x06, 0x06, 0x44, 0x0e, 0x45, 0x16, 0x46, 0x1e, 0x47, 0x26, 0x06, 0x2e, 0xbf, 0x70, 0x06,
+    0x00, 0x46, 0x3e, 0x44, 0xb8, 0xc4, 0xa0, 0x06, 0x71, 0x0e, 0x00, 0x4e, 0x3e, 0x45, 0xb9, 0xc4,
+    0xa0, 0x06, 0x72, 0x16, 0x00, 0x56, 0x3e, 0x46, 0xba, 0xc4, 0xa0, 0x06, 0x73, 0x1e, 0x00, 0x5e,
+    0x3e, 0x47, 0xbb, 0xc4, 0xa0, 0x06, 0x74, 0x26, 0x06, 0x2e, 0xbf, 0x66, 0x3e, 0x06, 0xbc, 0xc4,
+    0xa0, 0x06, 0x75, 0x26, 0x06, 0x2e, 0xbf, 0x6e, 0x3e, 0xbf, 0xbd, 0xc4, 0xa0, 0x06, 0x26, 0x06,
+    0x2e, 0xbf, 0x3e, 0x32, 0x77, 0xbe, 0xc4, 0xa0, 0x06, 0x86, 0xfe, 0x64, 0xc4, 0xa0, 0x06, 0xaf,
+    0x7e, 0xfe, 0x32, 0xc4, 0xa0, 0x06, 0x26, 0x06, 0x2e, 0xbf, 0x7e, 0x96, 0xc4, 0xa0, 0x06, 0x3e,
+    0x80, 0x87, 0x8e, 0xfe, 0x33, 0xc4, 0xa0, 0x06, 0x3e, 0x80, 0x87, 0x9e, 0xfe, 0xcd, 0xc4, 0xa0,
+    0x06, 0xa6, 0xc4, 0xa0, 0x06, 0x3e, 0x25, 0xb6, 0xfe, 0x37, 0xc4, 0xa0, 0x06, 0xae, 0xfe, 0x05,
+    0xc4, 0xa0, 0x06, 0x36, 0x55, 0x34, 0x35, 0x86, 0xfe, 0x5a, 0xc4, 0xa0, 0x06, 0x01, 0xff, 0x12,
+    0x11, 0xff, 0x12, 0x21, 0xff, 0x12, 0x03, 0x13, 0x23, 0x3e, 0x13, 0xb8, 0xc4, 0xa0, 0x06, 0xba,
+    0xc4, 0xa0, 0x06, 0xbc, 0xc4, 0xa0, 0x06, 0x3e, 0x00, 0xb9, 0xc4, 0xa0, 0x06, 0xbb, 0xc4, 0xa0,
+    0x06, 0xbd, 0xc4, 0xa0, 0x06, 0x0b, 0x1b, 0x2b, 0x3e, 0x12, 0xb8, 0xc4, 0xa0, 0x06, 0xba, 0xc4,
+    0xa0, 0x06, 0xbc, 0xc4, 0xa0, 0x06, 0x3e, 0xff, 0xb9, 0xc4, 0xa0, 0x06, 0xbb, 0xc4, 0xa0, 0x06,
+    0xbd, 0xc4, 0xa0, 0x06, 0x32, 0xbf, 0x06, 0xaf, 0x3a, 0xbf, 0x06, 0xfe, 0xff, 0xc4, 0xa0, 0x06,
+    0x2a, 0xbd, 0x06, 0x22, 0xbf, 0x06, 0x3a, 0xbd, 0x06, 0x47, 0x3a, 0xbf, 0x06, 0xb8, 0xc4, 0xa0,
+    0x06, 0x3a, 0xbe, 0x06, 0x47, 0x3a, 0xc0, 0x06, 0xb8, 0xc4, 0xa0, 0x06, 0x3e, 0xaa, 0x32, 0xbf,
+    0x06, 0x44, 0x4d, 0xaf, 0x0a, 0xfe, 0xaa, 0xc4, 0xa0, 0x06, 0x3c, 0x02, 0x3a, 0xbf, 0x06, 0xfe,
+    0xab, 0xc4, 0xa0, 0x06, 0x3e, 0x77, 0x32, 0xbf, 0x06, 0x2a, 0xbd, 0x06, 0x11, 0x00, 0x00, 0xeb,
+    0xaf, 0x1a, 0xfe, 0x77, 0xc4, 0xa0, 0x06, 0xaf, 0x84, 0x85, 0xc4, 0xa0, 0x06, 0x3e, 0xcc, 0x12,
+    0x3a, 0xbf, 0x06, 0xfe, 0xcc, 0x12, 0x3a, 0xbf, 0x06, 0xfe, 0xcc, 0xc4, 0xa0, 0x06, 0x21, 0x77,
+    0x77, 0x29, 0x3e, 0xee, 0xbc, 0xc4, 0xa0, 0x06, 0xbd, 0xc4, 0xa0, 0x06, 0x21, 0x55, 0x55, 0x01,
+    0xff, 0xff, 0x09, 0x3e, 0x55, 0xd4, 0xa0, 0x06, 0xbc, 0xc4, 0xa0, 0x06, 0x3e, 0x54, 0xbd, 0xc4,
+    0xa0, 0x06, 0x21, 0xaa, 0xaa, 0x11, 0x33, 0x33, 0x19, 0x3e, 0xdd, 0xbc, 0xc4, 0xa0, 0x06, 0xbd,
+    0xc4, 0xa0, 0x06, 0x37, 0xd4, 0xa0, 0x06, 0x3f, 0xdc, 0xa0, 0x06, 0x3e, 0xaa, 0x2f, 0xfe, 0x55,
+    0xc4, 0xa0, 0x06, 0xb7, 0x27, 0xfe, 0x55, 0xc4, 0xa0, 0x06, 0x3e, 0x88, 0x87, 0x27, 0xfe, 0x76,
+    0xc4, 0xa0, 0x06, 0xaf, 0x3e, 0xaa, 0x27, 0xd4, 0xa0, 0x06, 0xfe, 0x10, 0xc4, 0xa0, 0x06, 0xaf,
+    0x3e, 0x9a, 0x27, 0xd4, 0xa0, 0x06, 0xc4, 0xa0, 0x06, 0x37, 0x3e, 0x42, 0x07, 0xdc, 0xa0, 0x06,
+    0x07, 0xd4, 0xa0, 0x06, 0xfe, 0x09, 0xc4, 0xa0, 0x06, 0x0f, 0xd4, 0xa0, 0x06, 0x0f, 0xfe, 0x42,
+    0xc4, 0xa0, 0x06, 0x17, 0x17, 0xd4, 0xa0, 0x06, 0xfe, 0x08, 0xc4, 0xa0, 0x06, 0x1f, 0x1f, 0xdc,
+    0xa0, 0x06, 0xfe, 0x02, 0xc4, 0xa0, 0x06, 0x01, 0x34, 0x12, 0x11, 0xaa, 0xaa, 0x21, 0x55, 0x55,
+    0xaf, 0xc5, 0xd5, 0xe5, 0xf5, 0x01, 0x00, 0x00, 0x11, 0x00, 0x00, 0x21, 0x00, 0x00, 0x3e, 0xc0,
+    0xc6, 0xf0, 0xf1, 0xe1, 0xd1, 0xc1, 0xdc, 0xa0, 0x06, 0xc4, 0xa0, 0x06, 0xe4, 0xa0, 0x06, 0xfc,
+    0xa0, 0x06, 0x3e, 0x12, 0xb8, 0xc4, 0xa0, 0x06, 0x3e, 0x34, 0xb9, 0xc4, 0xa0, 0x06, 0x3e, 0xaa,
+    0xba, 0xc4, 0xa0, 0x06, 0xbb, 0xc4, 0xa0, 0x06, 0x3e, 0x55, 0xbc, 0xc4, 0xa0, 0x06, 0xbd, 0xc4,
+    0xa0, 0x06, 0x21, 0x00, 0x00, 0x39, 0x22, 0xc4, 0x06, 0x31, 0xc3, 0x06, 0x3b, 0x3b, 0x33, 0x3b,
+    0x3e, 0x55, 0x32, 0xc1, 0x06, 0x2f, 0x32, 0xc2, 0x06, 0xc1, 0xb8, 0xc4, 0xa0, 0x06, 0x2f, 0xb9,
+    0xc4, 0xa0, 0x06, 0x21, 0xc3, 0x06, 0xf9, 0x21, 0x33, 0x77, 0x3b, 0x3b, 0xe3, 0x3a, 0xc2, 0x06,
+    0xfe, 0x77, 0xc4, 0xa0, 0x06, 0x3a, 0xc1, 0x06, 0xfe, 0x33, 0xc4, 0xa0, 0x06, 0x3e, 0x55, 0xbd,
+    0xc4, 0xa0, 0x06, 0x2f, 0xbc, 0xc4, 0xa0, 0x06, 0x2a, 0xc4, 0x06, 0xf9, 0x21, 0xb4, 0x06, 0xe9,
+    0x21, 0x90, 0x01, 0xcd, 0x4b, 0x01, 0xe1, 0xe5, 0x7c, 0xcd, 0x5a, 0x01, 0xe1, 0x7d, 0xcd, 0x5a,
+    0x01, 0xc3, 0x00, 0x00, 0x21, 0x7a, 0x01, 0xcd, 0x4b, 0x01, 0xc3, 0x00, 0x00, 0xbf, 0x06, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+uint32_t block_0100(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0100    JMP 0x01b2
+    s.cycle += 10;
+    s.pc = 0x01b2;
+    return 1;
+}
+
+uint32_t block_014b(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    push(s, bus, s.de); // 0x014b    PUSH D
+    std::swap(s.de, s.hl); // 0x014c    XCHG
+    s.c = 0x09; // 0x014d    MVI C, 0x0009
+    // 0x014f    CALL 0x0005
+    s.cycle += 39;
+    push(s, bus, 0x0152);
+    s.pc = 0x0005;
+    return 4;
+}
+
+uint32_t block_0152(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    pop(s, bus, s.de); // 0x0152    POP D
+    // 0x0153    RET
+    s.cycle += 20;
+    pop(s, bus, s.pc);
+    return 2;
+}
+
+uint32_t block_0154(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.c = 0x02; // 0x0154    MVI C, 0x0002
+    // 0x0156    CALL 0x0005
+    s.cycle += 24;
+    push(s, bus, 0x0159);
+    s.pc = 0x0005;
+    return 2;
+}
+
+uint32_t block_0159(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0159    RET
+    s.cycle += 10;
+    pop(s, bus, s.pc);
+    return 1;
+}
+
+uint32_t block_015a(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    push_psw(s, bus); // 0x015a    PUSH PSW
+    // 0x015b    CALL 0x016a
+    s.cycle += 28;
+    push(s, bus, 0x015e);
+    s.pc = 0x016a;
+    return 2;
+}
+
+uint32_t block_015e(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.e = s.a; // 0x015e    MOV E, A
+    // 0x015f    CALL 0x0154
+    s.cycle += 22;
+    push(s, bus, 0x0162);
+    s.pc = 0x0154;
+    return 2;
+}
+
+uint32_t block_0162(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    pop_psw(s, bus); // 0x0162    POP PSW
+    // 0x0163    CALL 0x016e
+    s.cycle += 27;
+    push(s, bus, 0x0166);
+    s.pc = 0x016e;
+    return 2;
+}
+
+uint32_t block_0166(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.e = s.a; // 0x0166    MOV E, A
+    // 0x0167    JMP 0x0154
+    s.cycle += 15;
+    s.pc = 0x0154;
+    return 2;
+}
+
+uint32_t block_016a(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    rrc(s); // 0x016a    RRC
+    rrc(s); // 0x016b    RRC
+    rrc(s); // 0x016c    RRC
+    rrc(s); // 0x016d    RRC
+    s.cycle += 16;
+    s.pc = 0x016e;
+    return 4;
+}
+
+uint32_t block_016e(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    ana(s, 0x0f); // 0x016e    ANI 0x000f
+    cmp(s, 0x0a); // 0x0170    CPI 0x000a
+    // 0x0172    JM 0x0177
+    s.cycle += 24;
+    s.pc = s.flags.sign ? 0x0177 : 0x0175;
+    return 3;
+}
+
+uint32_t block_0175(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x07); // 0x0175    ADI 0x0007
+    s.cycle += 7;
+    s.pc = 0x0177;
+    return 1;
+}
+
+uint32_t block_0177(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x30); // 0x0177    ADI 0x0030
+    // 0x0179    RET
+    s.cycle += 17;
+    pop(s, bus, s.pc);
+    return 2;
+}
+
+uint32_t block_01b2(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.sp = 0x07bd; // 0x01b2    LXI SP, 0x07bd
+    s.hl = 0x0103; // 0x01b5    LXI H, 0x0103
+    // 0x01b8    CALL 0x014b
+    s.cycle += 37;
+    push(s, bus, 0x01bb);
+    s.pc = 0x014b;
+    return 3;
+}
+
+uint32_t block_01bb(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    ana(s, 0x00); // 0x01bb    ANI 0x0000
+    // 0x01bd    JZ 0x01c3
+    s.cycle += 17;
+    s.pc = s.flags.zero ? 0x01c3 : 0x01c0;
+    return 2;
+}
+
+uint32_t block_01c0(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01c0    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x01c3);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_01c3(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01c3    JNC 0x01c9
+    s.cycle += 10;
+    s.pc = !s.flags.carry ? 0x01c9 : 0x01c6;
+    return 1;
+}
+
+uint32_t block_01c6(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01c6    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x01c9);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_01c9(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01c9    JPE 0x01cf
+    s.cycle += 10;
+    s.pc = s.flags.parity ? 0x01cf : 0x01cc;
+    return 1;
+}
+
+uint32_t block_01cc(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01cc    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x01cf);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_01cf(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01cf    JP 0x01d5
+    s.cycle += 10;
+    s.pc = !s.flags.sign ? 0x01d5 : 0x01d2;
+    return 1;
+}
+
+uint32_t block_01d2(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01d2    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x01d5);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_01d5(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01d5    JNZ 0x01e4
+    s.cycle += 10;
+    s.pc = !s.flags.zero ? 0x01e4 : 0x01d8;
+    return 1;
+}
+
+uint32_t block_01d8(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01d8    JC 0x01e4
+    s.cycle += 10;
+    s.pc = s.flags.carry ? 0x01e4 : 0x01db;
+    return 1;
+}
+
+uint32_t block_01db(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01db    JPO 0x01e4
+    s.cycle += 10;
+    s.pc = !s.flags.parity ? 0x01e4 : 0x01de;
+    return 1;
+}
+
+uint32_t block_01de(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01de    JM 0x01e4
+    s.cycle += 10;
+    s.pc = s.flags.sign ? 0x01e4 : 0x01e1;
+    return 1;
+}
+
+uint32_t block_01e1(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01e1    JMP 0x01e7
+    s.cycle += 10;
+    s.pc = 0x01e7;
+    return 1;
+}
+
+uint32_t block_01e4(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01e4    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x01e7);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_01e7(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x06); // 0x01e7    ADI 0x0006
+    // 0x01e9    JNZ 0x01ef
+    s.cycle += 17;
+    s.pc = !s.flags.zero ? 0x01ef : 0x01ec;
+    return 2;
+}
+
+uint32_t block_01ec(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01ec    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x01ef);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_01ef(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01ef    JC 0x01f8
+    s.cycle += 10;
+    s.pc = s.flags.carry ? 0x01f8 : 0x01f2;
+    return 1;
+}
+
+uint32_t block_01f2(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01f2    JPO 0x01f8
+    s.cycle += 10;
+    s.pc = !s.flags.parity ? 0x01f8 : 0x01f5;
+    return 1;
+}
+
+uint32_t block_01f5(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01f5    JP 0x01fb
+    s.cycle += 10;
+    s.pc = !s.flags.sign ? 0x01fb : 0x01f8;
+    return 1;
+}
+
+uint32_t block_01f8(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x01f8    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x01fb);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_01fb(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x70); // 0x01fb    ADI 0x0070
+    // 0x01fd    JPO 0x0203
+    s.cycle += 17;
+    s.pc = !s.flags.parity ? 0x0203 : 0x0200;
+    return 2;
+}
+
+uint32_t block_0200(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0200    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x0203);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_0203(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0203    JM 0x020c
+    s.cycle += 10;
+    s.pc = s.flags.sign ? 0x020c : 0x0206;
+    return 1;
+}
+
+uint32_t block_0206(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0206    JZ 0x020c
+    s.cycle += 10;
+    s.pc = s.flags.zero ? 0x020c : 0x0209;
+    return 1;
+}
+
+uint32_t block_0209(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0209    JNC 0x020f
+    s.cycle += 10;
+    s.pc = !s.flags.carry ? 0x020f : 0x020c;
+    return 1;
+}
+
+uint32_t block_020c(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x020c    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x020f);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_020f(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x81); // 0x020f    ADI 0x0081
+    // 0x0211    JM 0x0217
+    s.cycle += 17;
+    s.pc = s.flags.sign ? 0x0217 : 0x0214;
+    return 2;
+}
+
+uint32_t block_0214(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0214    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x0217);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_0217(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0217    JZ 0x0220
+    s.cycle += 10;
+    s.pc = s.flags.zero ? 0x0220 : 0x021a;
+    return 1;
+}
+
+uint32_t block_021a(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x021a    JC 0x0220
+    s.cycle += 10;
+    s.pc = s.flags.carry ? 0x0220 : 0x021d;
+    return 1;
+}
+
+uint32_t block_021d(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x021d    JPO 0x0223
+    s.cycle += 10;
+    s.pc = !s.flags.parity ? 0x0223 : 0x0220;
+    return 1;
+}
+
+uint32_t block_0220(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0220    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x0223);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_0223(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0xfe); // 0x0223    ADI 0x00fe
+    // 0x0225    JC 0x022b
+    s.cycle += 17;
+    s.pc = s.flags.carry ? 0x022b : 0x0228;
+    return 2;
+}
+
+uint32_t block_0228(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0228    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x022b);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_022b(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x022b    JZ 0x0234
+    s.cycle += 10;
+    s.pc = s.flags.zero ? 0x0234 : 0x022e;
+    return 1;
+}
+
+uint32_t block_022e(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x022e    JPO 0x0234
+    s.cycle += 10;
+    s.pc = !s.flags.parity ? 0x0234 : 0x0231;
+    return 1;
+}
+
+uint32_t block_0231(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0231    JM 0x0237
+    s.cycle += 10;
+    s.pc = s.flags.sign ? 0x0237 : 0x0234;
+    return 1;
+}
+
+uint32_t block_0234(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0234    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x0237);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_0237(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, 0x00); // 0x0237    CPI 0x0000
+    // 0x0239    JC 0x024f
+    s.cycle += 17;
+    s.pc = s.flags.carry ? 0x024f : 0x023c;
+    return 2;
+}
+
+uint32_t block_023c(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x023c    JZ 0x024f
+    s.cycle += 10;
+    s.pc = s.flags.zero ? 0x024f : 0x023f;
+    return 1;
+}
+
+uint32_t block_023f(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, 0xf5); // 0x023f    CPI 0x00f5
+    // 0x0241    JC 0x024f
+    s.cycle += 17;
+    s.pc = s.flags.carry ? 0x024f : 0x0244;
+    return 2;
+}
+
+uint32_t block_0244(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0244    JNZ 0x024f
+    s.cycle += 10;
+    s.pc = !s.flags.zero ? 0x024f : 0x0247;
+    return 1;
+}
+
+uint32_t block_0247(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, 0xff); // 0x0247    CPI 0x00ff
+    // 0x0249    JZ 0x024f
+    s.cycle += 17;
+    s.pc = s.flags.zero ? 0x024f : 0x024c;
+    return 2;
+}
+
+uint32_t block_024c(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x024c    JC 0x0252
+    s.cycle += 10;
+    s.pc = s.flags.carry ? 0x0252 : 0x024f;
+    return 1;
+}
+
+uint32_t block_024f(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x024f    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x0252);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_0252(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    adc(s, 0x0a); // 0x0252    ACI 0x000a
+    adc(s, 0x0a); // 0x0254    ACI 0x000a
+    cmp(s, 0x0b); // 0x0256    CPI 0x000b
+    // 0x0258    JZ 0x025e
+    s.cycle += 31;
+    s.pc = s.flags.zero ? 0x025e : 0x025b;
+    return 4;
+}
+
+uint32_t block_025b(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x025b    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x025e);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_025e(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    sub(s, 0x0c); // 0x025e    SUI 0x000c
+    sub(s, 0x0f); // 0x0260    SUI 0x000f
+    cmp(s, 0xf0); // 0x0262    CPI 0x00f0
+    // 0x0264    JZ 0x026a
+    s.cycle += 31;
+    s.pc = s.flags.zero ? 0x026a : 0x0267;
+    return 4;
+}
+
+uint32_t block_0267(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0267    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x026a);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_026a(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    sbb(s, 0xf1); // 0x026a    SBI 0x00f1
+    sbb(s, 0x0e); // 0x026c    SBI 0x000e
+    cmp(s, 0xf0); // 0x026e    CPI 0x00f0
+    // 0x0270    JZ 0x0276
+    s.cycle += 31;
+    s.pc = s.flags.zero ? 0x0276 : 0x0273;
+    return 4;
+}
+
+uint32_t block_0273(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0273    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x0276);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_0276(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    ana(s, 0x55); // 0x0276    ANI 0x0055
+    cmp(s, 0x50); // 0x0278    CPI 0x0050
+    // 0x027a    JZ 0x0280
+    s.cycle += 24;
+    s.pc = s.flags.zero ? 0x0280 : 0x027d;
+    return 3;
+}
+
+uint32_t block_027d(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x027d    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x0280);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_0280(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    ora(s, 0x3a); // 0x0280    ORI 0x003a
+    cmp(s, 0x7a); // 0x0282    CPI 0x007a
+    // 0x0284    JZ 0x028a
+    s.cycle += 24;
+    s.pc = s.flags.zero ? 0x028a : 0x0287;
+    return 3;
+}
+
+uint32_t block_0287(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0287    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x028a);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_028a(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    xra(s, 0x0f); // 0x028a    XRI 0x000f
+    cmp(s, 0x75); // 0x028c    CPI 0x0075
+    // 0x028e    JZ 0x0294
+    s.cycle += 24;
+    s.pc = s.flags.zero ? 0x0294 : 0x0291;
+    return 3;
+}
+
+uint32_t block_0291(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0291    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x0294);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_0294(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    ana(s, 0x00); // 0x0294    ANI 0x0000
+    // 0x0296    CC 0x06a0
+    s.cycle += 18;
+    if (s.flags.carry) {
+        push(s, bus, 0x0299);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0299;
+    }
+    return 2;
+}
+
+uint32_t block_0299(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0299    CPO 0x06a0
+    s.cycle += 11;
+    if (!s.flags.parity) {
+        push(s, bus, 0x029c);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x029c;
+    }
+    return 1;
+}
+
+uint32_t block_029c(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x029c    CM 0x06a0
+    s.cycle += 11;
+    if (s.flags.sign) {
+        push(s, bus, 0x029f);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x029f;
+    }
+    return 1;
+}
+
+uint32_t block_029f(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x029f    CNZ 0x06a0
+    s.cycle += 11;
+    if (!s.flags.zero) {
+        push(s, bus, 0x02a2);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02a2;
+    }
+    return 1;
+}
+
+uint32_t block_02a2(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, 0x00); // 0x02a2    CPI 0x0000
+    // 0x02a4    JZ 0x02aa
+    s.cycle += 17;
+    s.pc = s.flags.zero ? 0x02aa : 0x02a7;
+    return 2;
+}
+
+uint32_t block_02a7(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02a7    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x02aa);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_02aa(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    sub(s, 0x77); // 0x02aa    SUI 0x0077
+    // 0x02ac    CNC 0x06a0
+    s.cycle += 18;
+    if (!s.flags.carry) {
+        push(s, bus, 0x02af);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02af;
+    }
+    return 2;
+}
+
+uint32_t block_02af(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02af    CPE 0x06a0
+    s.cycle += 11;
+    if (s.flags.parity) {
+        push(s, bus, 0x02b2);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02b2;
+    }
+    return 1;
+}
+
+uint32_t block_02b2(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02b2    CP 0x06a0
+    s.cycle += 11;
+    if (!s.flags.sign) {
+        push(s, bus, 0x02b5);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02b5;
+    }
+    return 1;
+}
+
+uint32_t block_02b5(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02b5    CZ 0x06a0
+    s.cycle += 11;
+    if (s.flags.zero) {
+        push(s, bus, 0x02b8);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02b8;
+    }
+    return 1;
+}
+
+uint32_t block_02b8(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, 0x89); // 0x02b8    CPI 0x0089
+    // 0x02ba    JZ 0x02c0
+    s.cycle += 17;
+    s.pc = s.flags.zero ? 0x02c0 : 0x02bd;
+    return 2;
+}
+
+uint32_t block_02bd(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02bd    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x02c0);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_02c0(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    ana(s, 0xff); // 0x02c0    ANI 0x00ff
+    // 0x02c2    CPO 0x02cd
+    s.cycle += 18;
+    if (!s.flags.parity) {
+        push(s, bus, 0x02c5);
+        s.pc = 0x02cd;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02c5;
+    }
+    return 2;
+}
+
+uint32_t block_02c5(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, 0xd9); // 0x02c5    CPI 0x00d9
+    // 0x02c7    JZ 0x032a
+    s.cycle += 17;
+    s.pc = s.flags.zero ? 0x032a : 0x02ca;
+    return 2;
+}
+
+uint32_t block_02ca(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02ca    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x02cd);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_02cd(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02cd    RPE
+    s.cycle += 5;
+    if (s.flags.parity) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02ce;
+    }
+    return 1;
+}
+
+uint32_t block_02ce(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x10); // 0x02ce    ADI 0x0010
+    // 0x02d0    CPE 0x02d9
+    s.cycle += 18;
+    if (s.flags.parity) {
+        push(s, bus, 0x02d3);
+        s.pc = 0x02d9;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02d3;
+    }
+    return 2;
+}
+
+uint32_t block_02d3(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x02); // 0x02d3    ADI 0x0002
+    // 0x02d5    RPO
+    s.cycle += 12;
+    if (!s.flags.parity) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02d6;
+    }
+    return 2;
+}
+
+uint32_t block_02d6(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02d6    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x02d9);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_02d9(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02d9    RPO
+    s.cycle += 5;
+    if (!s.flags.parity) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02da;
+    }
+    return 1;
+}
+
+uint32_t block_02da(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x20); // 0x02da    ADI 0x0020
+    // 0x02dc    CM 0x02e5
+    s.cycle += 18;
+    if (s.flags.sign) {
+        push(s, bus, 0x02df);
+        s.pc = 0x02e5;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02df;
+    }
+    return 2;
+}
+
+uint32_t block_02df(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x04); // 0x02df    ADI 0x0004
+    // 0x02e1    RPE
+    s.cycle += 12;
+    if (s.flags.parity) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02e2;
+    }
+    return 2;
+}
+
+uint32_t block_02e2(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02e2    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x02e5);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_02e5(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02e5    RP
+    s.cycle += 5;
+    if (!s.flags.sign) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02e6;
+    }
+    return 1;
+}
+
+uint32_t block_02e6(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x80); // 0x02e6    ADI 0x0080
+    // 0x02e8    CP 0x02f1
+    s.cycle += 18;
+    if (!s.flags.sign) {
+        push(s, bus, 0x02eb);
+        s.pc = 0x02f1;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02eb;
+    }
+    return 2;
+}
+
+uint32_t block_02eb(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x80); // 0x02eb    ADI 0x0080
+    // 0x02ed    RM
+    s.cycle += 12;
+    if (s.flags.sign) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02ee;
+    }
+    return 2;
+}
+
+uint32_t block_02ee(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02ee    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x02f1);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_02f1(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02f1    RM
+    s.cycle += 5;
+    if (s.flags.sign) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02f2;
+    }
+    return 1;
+}
+
+uint32_t block_02f2(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x40); // 0x02f2    ADI 0x0040
+    // 0x02f4    CNC 0x02fd
+    s.cycle += 18;
+    if (!s.flags.carry) {
+        push(s, bus, 0x02f7);
+        s.pc = 0x02fd;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02f7;
+    }
+    return 2;
+}
+
+uint32_t block_02f7(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x40); // 0x02f7    ADI 0x0040
+    // 0x02f9    RP
+    s.cycle += 12;
+    if (!s.flags.sign) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02fa;
+    }
+    return 2;
+}
+
+uint32_t block_02fa(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02fa    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x02fd);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_02fd(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x02fd    RC
+    s.cycle += 5;
+    if (s.flags.carry) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x02fe;
+    }
+    return 1;
+}
+
+uint32_t block_02fe(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x8f); // 0x02fe    ADI 0x008f
+    s.cycle += 7;
+    s.pc = 0x0300;
+    return 1;
+}
+
+uint32_t block_0300(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0300    CC 0x0309
+    s.cycle += 11;
+    if (s.flags.carry) {
+        push(s, bus, 0x0303);
+        s.pc = 0x0309;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0303;
+    }
+    return 1;
+}
+
+uint32_t block_0303(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    sub(s, 0x02); // 0x0303    SUI 0x0002
+    // 0x0305    RNC
+    s.cycle += 12;
+    if (!s.flags.carry) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0306;
+    }
+    return 2;
+}
+
+uint32_t block_0306(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0306    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x0309);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_0309(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0309    RNC
+    s.cycle += 5;
+    if (!s.flags.carry) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x030a;
+    }
+    return 1;
+}
+
+uint32_t block_030a(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0xf7); // 0x030a    ADI 0x00f7
+    // 0x030c    CNZ 0x0315
+    s.cycle += 18;
+    if (!s.flags.zero) {
+        push(s, bus, 0x030f);
+        s.pc = 0x0315;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x030f;
+    }
+    return 2;
+}
+
+uint32_t block_030f(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0xfe); // 0x030f    ADI 0x00fe
+    // 0x0311    RC
+    s.cycle += 12;
+    if (s.flags.carry) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0312;
+    }
+    return 2;
+}
+
+uint32_t block_0312(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0312    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x0315);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_0315(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0315    RZ
+    s.cycle += 5;
+    if (s.flags.zero) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0316;
+    }
+    return 1;
+}
+
+uint32_t block_0316(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x01); // 0x0316    ADI 0x0001
+    // 0x0318    CZ 0x0321
+    s.cycle += 18;
+    if (s.flags.zero) {
+        push(s, bus, 0x031b);
+        s.pc = 0x0321;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x031b;
+    }
+    return 2;
+}
+
+uint32_t block_031b(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0xd0); // 0x031b    ADI 0x00d0
+    // 0x031d    RNZ
+    s.cycle += 12;
+    if (!s.flags.zero) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x031e;
+    }
+    return 2;
+}
+
+uint32_t block_031e(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x031e    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x0321);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_0321(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0321    RNZ
+    s.cycle += 5;
+    if (!s.flags.zero) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0322;
+    }
+    return 1;
+}
+
+uint32_t block_0322(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, 0x47); // 0x0322    ADI 0x0047
+    cmp(s, 0x47); // 0x0324    CPI 0x0047
+    // 0x0326    RZ
+    s.cycle += 19;
+    if (s.flags.zero) {
+        pop(s, bus, s.pc);
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0327;
+    }
+    return 3;
+}
+
+uint32_t block_0327(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0327    CALL 0x06a0
+    s.cycle += 17;
+    push(s, bus, 0x032a);
+    s.pc = 0x06a0;
+    return 1;
+}
+
+uint32_t block_032a(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x77; // 0x032a    MVI A, 0x0077
+    inr(s, s.a); // 0x032c    INR A
+    s.b = s.a; // 0x032d    MOV B, A
+    inr(s, s.b); // 0x032e    INR B
+    s.c = s.b; // 0x032f    MOV C, B
+    dcr(s, s.c); // 0x0330    DCR C
+    s.d = s.c; // 0x0331    MOV D, C
+    s.e = s.d; // 0x0332    MOV E, D
+    s.h = s.e; // 0x0333    MOV H, E
+    s.l = s.h; // 0x0334    MOV L, H
+    s.a = s.l; // 0x0335    MOV A, L
+    dcr(s, s.a); // 0x0336    DCR A
+    s.c = s.a; // 0x0337    MOV C, A
+    s.e = s.c; // 0x0338    MOV E, C
+    s.l = s.e; // 0x0339    MOV L, E
+    s.b = s.l; // 0x033a    MOV B, L
+    s.d = s.b; // 0x033b    MOV D, B
+    s.h = s.d; // 0x033c    MOV H, D
+    s.a = s.h; // 0x033d    MOV A, H
+    s.d = s.a; // 0x033e    MOV D, A
+    inr(s, s.d); // 0x033f    INR D
+    s.l = s.d; // 0x0340    MOV L, D
+    s.c = s.l; // 0x0341    MOV C, L
+    inr(s, s.c); // 0x0342    INR C
+    s.h = s.c; // 0x0343    MOV H, C
+    s.b = s.h; // 0x0344    MOV B, H
+    dcr(s, s.b); // 0x0345    DCR B
+    s.e = s.b; // 0x0346    MOV E, B
+    s.a = s.e; // 0x0347    MOV A, E
+    s.e = s.a; // 0x0348    MOV E, A
+    inr(s, s.e); // 0x0349    INR E
+    s.b = s.e; // 0x034a    MOV B, E
+    s.h = s.b; // 0x034b    MOV H, B
+    inr(s, s.h); // 0x034c    INR H
+    s.c = s.h; // 0x034d    MOV C, H
+    s.l = s.c; // 0x034e    MOV L, C
+    s.d = s.l; // 0x034f    MOV D, L
+    dcr(s, s.d); // 0x0350    DCR D
+    s.a = s.d; // 0x0351    MOV A, D
+    s.h = s.a; // 0x0352    MOV H, A
+    dcr(s, s.h); // 0x0353    DCR H
+    s.d = s.h; // 0x0354    MOV D, H
+    s.b = s.d; // 0x0355    MOV B, D
+    s.l = s.b; // 0x0356    MOV L, B
+    inr(s, s.l); // 0x0357    INR L
+    s.e = s.l; // 0x0358    MOV E, L
+    dcr(s, s.e); // 0x0359    DCR E
+    s.c = s.e; // 0x035a    MOV C, E
+    s.a = s.c; // 0x035b    MOV A, C
+    s.l = s.a; // 0x035c    MOV L, A
+    dcr(s, s.l); // 0x035d    DCR L
+    s.h = s.l; // 0x035e    MOV H, L
+    s.e = s.h; // 0x035f    MOV E, H
+    s.d = s.e; // 0x0360    MOV D, E
+    s.c = s.d; // 0x0361    MOV C, D
+    s.b = s.c; // 0x0362    MOV B, C
+    s.a = s.b; // 0x0363    MOV A, B
+    cmp(s, 0x77); // 0x0364    CPI 0x0077
+    // 0x0366    CNZ 0x06a0
+    s.cycle += 305;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0369);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0369;
+    }
+    return 59;
+}
+
+uint32_t block_0369(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    xra(s, s.a); // 0x0369    XRA A
+    s.b = 0x01; // 0x036a    MVI B, 0x0001
+    s.c = 0x03; // 0x036c    MVI C, 0x0003
+    s.d = 0x07; // 0x036e    MVI D, 0x0007
+    s.e = 0x0f; // 0x0370    MVI E, 0x000f
+    s.h = 0x1f; // 0x0372    MVI H, 0x001f
+    s.l = 0x3f; // 0x0374    MVI L, 0x003f
+    add(s, s.b); // 0x0376    ADD B
+    add(s, s.c); // 0x0377    ADD C
+    add(s, s.d); // 0x0378    ADD D
+    add(s, s.e); // 0x0379    ADD E
+    add(s, s.h); // 0x037a    ADD H
+    add(s, s.l); // 0x037b    ADD L
+    add(s, s.a); // 0x037c    ADD A
+    cmp(s, 0xf0); // 0x037d    CPI 0x00f0
+    // 0x037f    CNZ 0x06a0
+    s.cycle += 92;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0382);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0382;
+    }
+    return 16;
+}
+
+uint32_t block_0382(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    sub(s, s.b); // 0x0382    SUB B
+    sub(s, s.c); // 0x0383    SUB C
+    sub(s, s.d); // 0x0384    SUB D
+    sub(s, s.e); // 0x0385    SUB E
+    sub(s, s.h); // 0x0386    SUB H
+    sub(s, s.l); // 0x0387    SUB L
+    cmp(s, 0x78); // 0x0388    CPI 0x0078
+    // 0x038a    CNZ 0x06a0
+    s.cycle += 42;
+    if (!s.flags.zero) {
+        push(s, bus, 0x038d);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x038d;
+    }
+    return 8;
+}
+
+uint32_t block_038d(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    sub(s, s.a); // 0x038d    SUB A
+    // 0x038e    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0391);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0391;
+    }
+    return 2;
+}
+
+uint32_t block_0391(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x80; // 0x0391    MVI A, 0x0080
+    add(s, s.a); // 0x0393    ADD A
+    s.b = 0x01; // 0x0394    MVI B, 0x0001
+    s.c = 0x02; // 0x0396    MVI C, 0x0002
+    s.d = 0x03; // 0x0398    MVI D, 0x0003
+    s.e = 0x04; // 0x039a    MVI E, 0x0004
+    s.h = 0x05; // 0x039c    MVI H, 0x0005
+    s.l = 0x06; // 0x039e    MVI L, 0x0006
+    adc(s, s.b); // 0x03a0    ADC B
+    s.b = 0x80; // 0x03a1    MVI B, 0x0080
+    add(s, s.b); // 0x03a3    ADD B
+    add(s, s.b); // 0x03a4    ADD B
+    adc(s, s.c); // 0x03a5    ADC C
+    add(s, s.b); // 0x03a6    ADD B
+    add(s, s.b); // 0x03a7    ADD B
+    adc(s, s.d); // 0x03a8    ADC D
+    add(s, s.b); // 0x03a9    ADD B
+    add(s, s.b); // 0x03aa    ADD B
+    adc(s, s.e); // 0x03ab    ADC E
+    add(s, s.b); // 0x03ac    ADD B
+    add(s, s.b); // 0x03ad    ADD B
+    adc(s, s.h); // 0x03ae    ADC H
+    add(s, s.b); // 0x03af    ADD B
+    add(s, s.b); // 0x03b0    ADD B
+    adc(s, s.l); // 0x03b1    ADC L
+    add(s, s.b); // 0x03b2    ADD B
+    add(s, s.b); // 0x03b3    ADD B
+    adc(s, s.a); // 0x03b4    ADC A
+    cmp(s, 0x37); // 0x03b5    CPI 0x0037
+    // 0x03b7    CNZ 0x06a0
+    s.cycle += 154;
+    if (!s.flags.zero) {
+        push(s, bus, 0x03ba);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x03ba;
+    }
+    return 30;
+}
+
+uint32_t block_03ba(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x80; // 0x03ba    MVI A, 0x0080
+    add(s, s.a); // 0x03bc    ADD A
+    s.b = 0x01; // 0x03bd    MVI B, 0x0001
+    sbb(s, s.b); // 0x03bf    SBB B
+    s.b = 0xff; // 0x03c0    MVI B, 0x00ff
+    add(s, s.b); // 0x03c2    ADD B
+    sbb(s, s.c); // 0x03c3    SBB C
+    add(s, s.b); // 0x03c4    ADD B
+    sbb(s, s.d); // 0x03c5    SBB D
+    add(s, s.b); // 0x03c6    ADD B
+    sbb(s, s.e); // 0x03c7    SBB E
+    add(s, s.b); // 0x03c8    ADD B
+    sbb(s, s.h); // 0x03c9    SBB H
+    add(s, s.b); // 0x03ca    ADD B
+    sbb(s, s.l); // 0x03cb    SBB L
+    cmp(s, 0xe0); // 0x03cc    CPI 0x00e0
+    // 0x03ce    CNZ 0x06a0
+    s.cycle += 87;
+    if (!s.flags.zero) {
+        push(s, bus, 0x03d1);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x03d1;
+    }
+    return 17;
+}
+
+uint32_t block_03d1(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x80; // 0x03d1    MVI A, 0x0080
+    add(s, s.a); // 0x03d3    ADD A
+    sbb(s, s.a); // 0x03d4    SBB A
+    cmp(s, 0xff); // 0x03d5    CPI 0x00ff
+    // 0x03d7    CNZ 0x06a0
+    s.cycle += 33;
+    if (!s.flags.zero) {
+        push(s, bus, 0x03da);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x03da;
+    }
+    return 5;
+}
+
+uint32_t block_03da(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0xff; // 0x03da    MVI A, 0x00ff
+    s.b = 0xfe; // 0x03dc    MVI B, 0x00fe
+    s.c = 0xfc; // 0x03de    MVI C, 0x00fc
+    s.d = 0xef; // 0x03e0    MVI D, 0x00ef
+    s.e = 0x7f; // 0x03e2    MVI E, 0x007f
+    s.h = 0xf4; // 0x03e4    MVI H, 0x00f4
+    s.l = 0xbf; // 0x03e6    MVI L, 0x00bf
+    ana(s, s.b); // 0x03e8    ANA B
+    ana(s, s.c); // 0x03e9    ANA C
+    ana(s, s.d); // 0x03ea    ANA D
+    ana(s, s.e); // 0x03eb    ANA E
+    ana(s, s.h); // 0x03ec    ANA H
+    ana(s, s.l); // 0x03ed    ANA L
+    ana(s, s.a); // 0x03ee    ANA A
+    cmp(s, 0x24); // 0x03ef    CPI 0x0024
+    // 0x03f1    CNZ 0x06a0
+    s.cycle += 95;
+    if (!s.flags.zero) {
+        push(s, bus, 0x03f4);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x03f4;
+    }
+    return 16;
+}
+
+uint32_t block_03f4(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    xra(s, s.a); // 0x03f4    XRA A
+    s.b = 0x01; // 0x03f5    MVI B, 0x0001
+    s.c = 0x02; // 0x03f7    MVI C, 0x0002
+    s.d = 0x04; // 0x03f9    MVI D, 0x0004
+    s.e = 0x08; // 0x03fb    MVI E, 0x0008
+    s.h = 0x10; // 0x03fd    MVI H, 0x0010
+    s.l = 0x20; // 0x03ff    MVI L, 0x0020
+    s.cycle += 46;
+    s.pc = 0x0401;
+    return 7;
+}
+
+uint32_t block_0401(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    ora(s, s.b); // 0x0401    ORA B
+    ora(s, s.c); // 0x0402    ORA C
+    ora(s, s.d); // 0x0403    ORA D
+    ora(s, s.e); // 0x0404    ORA E
+    ora(s, s.h); // 0x0405    ORA H
+    ora(s, s.l); // 0x0406    ORA L
+    ora(s, s.a); // 0x0407    ORA A
+    cmp(s, 0x3f); // 0x0408    CPI 0x003f
+    // 0x040a    CNZ 0x06a0
+    s.cycle += 46;
+    if (!s.flags.zero) {
+        push(s, bus, 0x040d);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x040d;
+    }
+    return 9;
+}
+
+uint32_t block_040d(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x00; // 0x040d    MVI A, 0x0000
+    s.h = 0x8f; // 0x040f    MVI H, 0x008f
+    s.l = 0x4f; // 0x0411    MVI L, 0x004f
+    xra(s, s.b); // 0x0413    XRA B
+    xra(s, s.c); // 0x0414    XRA C
+    xra(s, s.d); // 0x0415    XRA D
+    xra(s, s.e); // 0x0416    XRA E
+    xra(s, s.h); // 0x0417    XRA H
+    xra(s, s.l); // 0x0418    XRA L
+    cmp(s, 0xcf); // 0x0419    CPI 0x00cf
+    // 0x041b    CNZ 0x06a0
+    s.cycle += 63;
+    if (!s.flags.zero) {
+        push(s, bus, 0x041e);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x041e;
+    }
+    return 11;
+}
+
+uint32_t block_041e(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    xra(s, s.a); // 0x041e    XRA A
+    // 0x041f    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0422);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0422;
+    }
+    return 2;
+}
+
+uint32_t block_0422(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.b = 0x44; // 0x0422    MVI B, 0x0044
+    s.c = 0x45; // 0x0424    MVI C, 0x0045
+    s.d = 0x46; // 0x0426    MVI D, 0x0046
+    s.e = 0x47; // 0x0428    MVI E, 0x0047
+    s.h = 0x06; // 0x042a    MVI H, 0x0006
+    s.l = 0xbf; // 0x042c    MVI L, 0x00bf
+    bus.mem_write(s.hl, s.b); // 0x042e    MOV M, B
+    s.b = 0x00; // 0x042f    MVI B, 0x0000
+    bus.mem_read(s.hl, s.b); // 0x0431    MOV B, M
+    s.a = 0x44; // 0x0432    MVI A, 0x0044
+    cmp(s, s.b); // 0x0434    CMP B
+    // 0x0435    CNZ 0x06a0
+    s.cycle += 85;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0438);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0438;
+    }
+    return 12;
+}
+
+uint32_t block_0438(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    bus.mem_write(s.hl, s.c); // 0x0438    MOV M, C
+    s.c = 0x00; // 0x0439    MVI C, 0x0000
+    bus.mem_read(s.hl, s.c); // 0x043b    MOV C, M
+    s.a = 0x45; // 0x043c    MVI A, 0x0045
+    cmp(s, s.c); // 0x043e    CMP C
+    // 0x043f    CNZ 0x06a0
+    s.cycle += 43;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0442);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0442;
+    }
+    return 6;
+}
+
+uint32_t block_0442(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    bus.mem_write(s.hl, s.d); // 0x0442    MOV M, D
+    s.d = 0x00; // 0x0443    MVI D, 0x0000
+    bus.mem_read(s.hl, s.d); // 0x0445    MOV D, M
+    s.a = 0x46; // 0x0446    MVI A, 0x0046
+    cmp(s, s.d); // 0x0448    CMP D
+    // 0x0449    CNZ 0x06a0
+    s.cycle += 43;
+    if (!s.flags.zero) {
+        push(s, bus, 0x044c);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x044c;
+    }
+    return 6;
+}
+
+uint32_t block_044c(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    bus.mem_write(s.hl, s.e); // 0x044c    MOV M, E
+    s.e = 0x00; // 0x044d    MVI E, 0x0000
+    bus.mem_read(s.hl, s.e); // 0x044f    MOV E, M
+    s.a = 0x47; // 0x0450    MVI A, 0x0047
+    cmp(s, s.e); // 0x0452    CMP E
+    // 0x0453    CNZ 0x06a0
+    s.cycle += 43;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0456);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0456;
+    }
+    return 6;
+}
+
+uint32_t block_0456(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    bus.mem_write(s.hl, s.h); // 0x0456    MOV M, H
+    s.h = 0x06; // 0x0457    MVI H, 0x0006
+    s.l = 0xbf; // 0x0459    MVI L, 0x00bf
+    bus.mem_read(s.hl, s.h); // 0x045b    MOV H, M
+    s.a = 0x06; // 0x045c    MVI A, 0x0006
+    cmp(s, s.h); // 0x045e    CMP H
+    // 0x045f    CNZ 0x06a0
+    s.cycle += 50;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0462);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0462;
+    }
+    return 7;
+}
+
+uint32_t block_0462(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    bus.mem_write(s.hl, s.l); // 0x0462    MOV M, L
+    s.h = 0x06; // 0x0463    MVI H, 0x0006
+    s.l = 0xbf; // 0x0465    MVI L, 0x00bf
+    bus.mem_read(s.hl, s.l); // 0x0467    MOV L, M
+    s.a = 0xbf; // 0x0468    MVI A, 0x00bf
+    cmp(s, s.l); // 0x046a    CMP L
+    // 0x046b    CNZ 0x06a0
+    s.cycle += 50;
+    if (!s.flags.zero) {
+        push(s, bus, 0x046e);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x046e;
+    }
+    return 7;
+}
+
+uint32_t block_046e(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.h = 0x06; // 0x046e    MVI H, 0x0006
+    s.l = 0xbf; // 0x0470    MVI L, 0x00bf
+    s.a = 0x32; // 0x0472    MVI A, 0x0032
+    bus.mem_write(s.hl, s.a); // 0x0474    MOV M, A
+    cmp(s, read_m(s, bus)); // 0x0475    CMP M
+    // 0x0476    CNZ 0x06a0
+    s.cycle += 46;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0479);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0479;
+    }
+    return 6;
+}
+
+uint32_t block_0479(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    add(s, read_m(s, bus)); // 0x0479    ADD M
+    cmp(s, 0x64); // 0x047a    CPI 0x0064
+    // 0x047c    CNZ 0x06a0
+    s.cycle += 25;
+    if (!s.flags.zero) {
+        push(s, bus, 0x047f);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x047f;
+    }
+    return 3;
+}
+
+uint32_t block_047f(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    xra(s, s.a); // 0x047f    XRA A
+    bus.mem_read(s.hl, s.a); // 0x0480    MOV A, M
+    cmp(s, 0x32); // 0x0481    CPI 0x0032
+    // 0x0483    CNZ 0x06a0
+    s.cycle += 29;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0486);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0486;
+    }
+    return 4;
+}
+
+uint32_t block_0486(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.h = 0x06; // 0x0486    MVI H, 0x0006
+    s.l = 0xbf; // 0x0488    MVI L, 0x00bf
+    bus.mem_read(s.hl, s.a); // 0x048a    MOV A, M
+    sub(s, read_m(s, bus)); // 0x048b    SUB M
+    // 0x048c    CNZ 0x06a0
+    s.cycle += 39;
+    if (!s.flags.zero) {
+        push(s, bus, 0x048f);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x048f;
+    }
+    return 5;
+}
+
+uint32_t block_048f(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x80; // 0x048f    MVI A, 0x0080
+    add(s, s.a); // 0x0491    ADD A
+    adc(s, read_m(s, bus)); // 0x0492    ADC M
+    cmp(s, 0x33); // 0x0493    CPI 0x0033
+    // 0x0495    CNZ 0x06a0
+    s.cycle += 36;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0498);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0498;
+    }
+    return 5;
+}
+
+uint32_t block_0498(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x80; // 0x0498    MVI A, 0x0080
+    add(s, s.a); // 0x049a    ADD A
+    sbb(s, read_m(s, bus)); // 0x049b    SBB M
+    cmp(s, 0xcd); // 0x049c    CPI 0x00cd
+    // 0x049e    CNZ 0x06a0
+    s.cycle += 36;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04a1);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04a1;
+    }
+    return 5;
+}
+
+uint32_t block_04a1(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    ana(s, read_m(s, bus)); // 0x04a1    ANA M
+    // 0x04a2    CNZ 0x06a0
+    s.cycle += 18;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04a5);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04a5;
+    }
+    return 2;
+}
+
+uint32_t block_04a5(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x25; // 0x04a5    MVI A, 0x0025
+    ora(s, read_m(s, bus)); // 0x04a7    ORA M
+    cmp(s, 0x37); // 0x04a8    CPI 0x0037
+    // 0x04aa    CNZ 0x06a0
+    s.cycle += 32;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04ad);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04ad;
+    }
+    return 4;
+}
+
+uint32_t block_04ad(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    xra(s, read_m(s, bus)); // 0x04ad    XRA M
+    cmp(s, 0x05); // 0x04ae    CPI 0x0005
+    // 0x04b0    CNZ 0x06a0
+    s.cycle += 25;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04b3);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04b3;
+    }
+    return 3;
+}
+
+uint32_t block_04b3(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    bus.mem_write(s.hl, static_cast<uint8_t>(0x55)); // 0x04b3    MVI M, 0x0055
+    { uint8_t value = read_m(s, bus); inr(s, value); bus.mem_write(s.hl, value); } // 0x04b5    INR M
+    { uint8_t value = read_m(s, bus); dcr(s, value); bus.mem_write(s.hl, value); } // 0x04b6    DCR M
+    add(s, read_m(s, bus)); // 0x04b7    ADD M
+    cmp(s, 0x5a); // 0x04b8    CPI 0x005a
+    // 0x04ba    CNZ 0x06a0
+    s.cycle += 55;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04bd);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04bd;
+    }
+    return 6;
+}
+
+uint32_t block_04bd(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.bc = 0x12ff; // 0x04bd    LXI B, 0x12ff
+    s.de = 0x12ff; // 0x04c0    LXI D, 0x12ff
+    s.hl = 0x12ff; // 0x04c3    LXI H, 0x12ff
+    s.bc++; // 0x04c6    INX B
+    s.de++; // 0x04c7    INX D
+    s.hl++; // 0x04c8    INX H
+    s.a = 0x13; // 0x04c9    MVI A, 0x0013
+    cmp(s, s.b); // 0x04cb    CMP B
+    // 0x04cc    CNZ 0x06a0
+    s.cycle += 67;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04cf);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04cf;
+    }
+    return 9;
+}
+
+uint32_t block_04cf(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, s.d); // 0x04cf    CMP D
+    // 0x04d0    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04d3);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04d3;
+    }
+    return 2;
+}
+
+uint32_t block_04d3(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, s.h); // 0x04d3    CMP H
+    // 0x04d4    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04d7);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04d7;
+    }
+    return 2;
+}
+
+uint32_t block_04d7(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x00; // 0x04d7    MVI A, 0x0000
+    cmp(s, s.c); // 0x04d9    CMP C
+    // 0x04da    CNZ 0x06a0
+    s.cycle += 22;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04dd);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04dd;
+    }
+    return 3;
+}
+
+uint32_t block_04dd(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, s.e); // 0x04dd    CMP E
+    // 0x04de    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04e1);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04e1;
+    }
+    return 2;
+}
+
+uint32_t block_04e1(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, s.l); // 0x04e1    CMP L
+    // 0x04e2    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04e5);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04e5;
+    }
+    return 2;
+}
+
+uint32_t block_04e5(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.bc--; // 0x04e5    DCX B
+    s.de--; // 0x04e6    DCX D
+    s.hl--; // 0x04e7    DCX H
+    s.a = 0x12; // 0x04e8    MVI A, 0x0012
+    cmp(s, s.b); // 0x04ea    CMP B
+    // 0x04eb    CNZ 0x06a0
+    s.cycle += 37;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04ee);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04ee;
+    }
+    return 6;
+}
+
+uint32_t block_04ee(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, s.d); // 0x04ee    CMP D
+    // 0x04ef    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04f2);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04f2;
+    }
+    return 2;
+}
+
+uint32_t block_04f2(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, s.h); // 0x04f2    CMP H
+    // 0x04f3    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04f6);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04f6;
+    }
+    return 2;
+}
+
+uint32_t block_04f6(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0xff; // 0x04f6    MVI A, 0x00ff
+    cmp(s, s.c); // 0x04f8    CMP C
+    // 0x04f9    CNZ 0x06a0
+    s.cycle += 22;
+    if (!s.flags.zero) {
+        push(s, bus, 0x04fc);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x04fc;
+    }
+    return 3;
+}
+
+uint32_t block_04fc(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, s.e); // 0x04fc    CMP E
+    // 0x04fd    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0500);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0500;
+    }
+    return 2;
+}
+
+uint32_t block_0500(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, s.l); // 0x0500    CMP L
+    // 0x0501    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0504);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0504;
+    }
+    return 2;
+}
+
+uint32_t block_0504(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    bus.mem_write(0x06bf, s.a); // 0x0504    STA 0x06bf
+    xra(s, s.a); // 0x0507    XRA A
+    bus.mem_read(0x06bf, s.a); // 0x0508    LDA 0x06bf
+    cmp(s, 0xff); // 0x050b    CPI 0x00ff
+    // 0x050d    CNZ 0x06a0
+    s.cycle += 48;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0510);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0510;
+    }
+    return 5;
+}
+
+uint32_t block_0510(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    bus.mem_read(0x06bd, s.hl); // 0x0510    LHLD 0x06bd
+    bus.mem_write(0x06bf, s.hl); // 0x0513    SHLD 0x06bf
+    bus.mem_read(0x06bd, s.a); // 0x0516    LDA 0x06bd
+    s.b = s.a; // 0x0519    MOV B, A
+    bus.mem_read(0x06bf, s.a); // 0x051a    LDA 0x06bf
+    cmp(s, s.b); // 0x051d    CMP B
+    // 0x051e    CNZ 0x06a0
+    s.cycle += 78;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0521);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0521;
+    }
+    return 7;
+}
+
+uint32_t block_0521(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    bus.mem_read(0x06be, s.a); // 0x0521    LDA 0x06be
+    s.b = s.a; // 0x0524    MOV B, A
+    bus.mem_read(0x06c0, s.a); // 0x0525    LDA 0x06c0
+    cmp(s, s.b); // 0x0528    CMP B
+    // 0x0529    CNZ 0x06a0
+    s.cycle += 46;
+    if (!s.flags.zero) {
+        push(s, bus, 0x052c);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x052c;
+    }
+    return 5;
+}
+
+uint32_t block_052c(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0xaa; // 0x052c    MVI A, 0x00aa
+    bus.mem_write(0x06bf, s.a); // 0x052e    STA 0x06bf
+    s.b = s.h; // 0x0531    MOV B, H
+    s.c = s.l; // 0x0532    MOV C, L
+    xra(s, s.a); // 0x0533    XRA A
+    bus.mem_read(s.bc, s.a); // 0x0534    LDAX B
+    cmp(s, 0xaa); // 0x0535    CPI 0x00aa
+    // 0x0537    CNZ 0x06a0
+    s.cycle += 59;
+    if (!s.flags.zero) {
+        push(s, bus, 0x053a);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x053a;
+    }
+    return 8;
+}
+
+uint32_t block_053a(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    inr(s, s.a); // 0x053a    INR A
+    bus.mem_write(s.bc, s.a); // 0x053b    STAX B
+    bus.mem_read(0x06bf, s.a); // 0x053c    LDA 0x06bf
+    cmp(s, 0xab); // 0x053f    CPI 0x00ab
+    // 0x0541    CNZ 0x06a0
+    s.cycle += 43;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0544);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0544;
+    }
+    return 5;
+}
+
+uint32_t block_0544(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x77; // 0x0544    MVI A, 0x0077
+    bus.mem_write(0x06bf, s.a); // 0x0546    STA 0x06bf
+    bus.mem_read(0x06bd, s.hl); // 0x0549    LHLD 0x06bd
+    s.de = 0x0000; // 0x054c    LXI D, 0x0000
+    std::swap(s.de, s.hl); // 0x054f    XCHG
+    xra(s, s.a); // 0x0550    XRA A
+    bus.mem_read(s.de, s.a); // 0x0551    LDAX D
+    cmp(s, 0x77); // 0x0552    CPI 0x0077
+    // 0x0554    CNZ 0x06a0
+    s.cycle += 79;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0557);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0557;
+    }
+    return 9;
+}
+
+uint32_t block_0557(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    xra(s, s.a); // 0x0557    XRA A
+    add(s, s.h); // 0x0558    ADD H
+    add(s, s.l); // 0x0559    ADD L
+    // 0x055a    CNZ 0x06a0
+    s.cycle += 23;
+    if (!s.flags.zero) {
+        push(s, bus, 0x055d);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x055d;
+    }
+    return 4;
+}
+
+uint32_t block_055d(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0xcc; // 0x055d    MVI A, 0x00cc
+    bus.mem_write(s.de, s.a); // 0x055f    STAX D
+    bus.mem_read(0x06bf, s.a); // 0x0560    LDA 0x06bf
+    cmp(s, 0xcc); // 0x0563    CPI 0x00cc
+    bus.mem_write(s.de, s.a); // 0x0565    STAX D
+    bus.mem_read(0x06bf, s.a); // 0x0566    LDA 0x06bf
+    cmp(s, 0xcc); // 0x0569    CPI 0x00cc
+    // 0x056b    CNZ 0x06a0
+    s.cycle += 72;
+    if (!s.flags.zero) {
+        push(s, bus, 0x056e);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x056e;
+    }
+    return 8;
+}
+
+uint32_t block_056e(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.hl = 0x7777; // 0x056e    LXI H, 0x7777
+    dad(s, s.hl); // 0x0571    DAD H
+    s.a = 0xee; // 0x0572    MVI A, 0x00ee
+    cmp(s, s.h); // 0x0574    CMP H
+    // 0x0575    CNZ 0x06a0
+    s.cycle += 42;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0578);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0578;
+    }
+    return 5;
+}
+
+uint32_t block_0578(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, s.l); // 0x0578    CMP L
+    // 0x0579    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x057c);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x057c;
+    }
+    return 2;
+}
+
+uint32_t block_057c(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.hl = 0x5555; // 0x057c    LXI H, 0x5555
+    s.bc = 0xffff; // 0x057f    LXI B, 0xffff
+    dad(s, s.bc); // 0x0582    DAD B
+    s.a = 0x55; // 0x0583    MVI A, 0x0055
+    // 0x0585    CNC 0x06a0
+    s.cycle += 48;
+    if (!s.flags.carry) {
+        push(s, bus, 0x0588);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0588;
+    }
+    return 5;
+}
+
+uint32_t block_0588(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, s.h); // 0x0588    CMP H
+    // 0x0589    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x058c);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x058c;
+    }
+    return 2;
+}
+
+uint32_t block_058c(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x54; // 0x058c    MVI A, 0x0054
+    cmp(s, s.l); // 0x058e    CMP L
+    // 0x058f    CNZ 0x06a0
+    s.cycle += 22;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0592);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0592;
+    }
+    return 3;
+}
+
+uint32_t block_0592(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.hl = 0xaaaa; // 0x0592    LXI H, 0xaaaa
+    s.de = 0x3333; // 0x0595    LXI D, 0x3333
+    dad(s, s.de); // 0x0598    DAD D
+    s.a = 0xdd; // 0x0599    MVI A, 0x00dd
+    cmp(s, s.h); // 0x059b    CMP H
+    // 0x059c    CNZ 0x06a0
+    s.cycle += 52;
+    if (!s.flags.zero) {
+        push(s, bus, 0x059f);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x059f;
+    }
+    return 6;
+}
+
+uint32_t block_059f(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, s.l); // 0x059f    CMP L
+    // 0x05a0    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x05a3);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05a3;
+    }
+    return 2;
+}
+
+uint32_t block_05a3(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.flags.carry = 1; // 0x05a3    STC
+    // 0x05a4    CNC 0x06a0
+    s.cycle += 15;
+    if (!s.flags.carry) {
+        push(s, bus, 0x05a7);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05a7;
+    }
+    return 2;
+}
+
+uint32_t block_05a7(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmc(s); // 0x05a7    CMC
+    // 0x05a8    CC 0x06a0
+    s.cycle += 15;
+    if (s.flags.carry) {
+        push(s, bus, 0x05ab);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05ab;
+    }
+    return 2;
+}
+
+uint32_t block_05ab(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0xaa; // 0x05ab    MVI A, 0x00aa
+    s.a = ~s.a; // 0x05ad    CMA
+    cmp(s, 0x55); // 0x05ae    CPI 0x0055
+    // 0x05b0    CNZ 0x06a0
+    s.cycle += 29;
+    if (!s.flags.zero) {
+        push(s, bus, 0x05b3);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05b3;
+    }
+    return 4;
+}
+
+uint32_t block_05b3(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    ora(s, s.a); // 0x05b3    ORA A
+    daa(s); // 0x05b4    DAA
+    cmp(s, 0x55); // 0x05b5    CPI 0x0055
+    // 0x05b7    CNZ 0x06a0
+    s.cycle += 26;
+    if (!s.flags.zero) {
+        push(s, bus, 0x05ba);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05ba;
+    }
+    return 4;
+}
+
+uint32_t block_05ba(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x88; // 0x05ba    MVI A, 0x0088
+    add(s, s.a); // 0x05bc    ADD A
+    daa(s); // 0x05bd    DAA
+    cmp(s, 0x76); // 0x05be    CPI 0x0076
+    // 0x05c0    CNZ 0x06a0
+    s.cycle += 33;
+    if (!s.flags.zero) {
+        push(s, bus, 0x05c3);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05c3;
+    }
+    return 5;
+}
+
+uint32_t block_05c3(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    xra(s, s.a); // 0x05c3    XRA A
+    s.a = 0xaa; // 0x05c4    MVI A, 0x00aa
+    daa(s); // 0x05c6    DAA
+    // 0x05c7    CNC 0x06a0
+    s.cycle += 26;
+    if (!s.flags.carry) {
+        push(s, bus, 0x05ca);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05ca;
+    }
+    return 4;
+}
+
+uint32_t block_05ca(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, 0x10); // 0x05ca    CPI 0x0010
+    // 0x05cc    CNZ 0x06a0
+    s.cycle += 18;
+    if (!s.flags.zero) {
+        push(s, bus, 0x05cf);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05cf;
+    }
+    return 2;
+}
+
+uint32_t block_05cf(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    xra(s, s.a); // 0x05cf    XRA A
+    s.a = 0x9a; // 0x05d0    MVI A, 0x009a
+    daa(s); // 0x05d2    DAA
+    // 0x05d3    CNC 0x06a0
+    s.cycle += 26;
+    if (!s.flags.carry) {
+        push(s, bus, 0x05d6);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05d6;
+    }
+    return 4;
+}
+
+uint32_t block_05d6(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x05d6    CNZ 0x06a0
+    s.cycle += 11;
+    if (!s.flags.zero) {
+        push(s, bus, 0x05d9);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05d9;
+    }
+    return 1;
+}
+
+uint32_t block_05d9(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.flags.carry = 1; // 0x05d9    STC
+    s.a = 0x42; // 0x05da    MVI A, 0x0042
+    rlc(s); // 0x05dc    RLC
+    // 0x05dd    CC 0x06a0
+    s.cycle += 26;
+    if (s.flags.carry) {
+        push(s, bus, 0x05e0);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05e0;
+    }
+    return 4;
+}
+
+uint32_t block_05e0(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    rlc(s); // 0x05e0    RLC
+    // 0x05e1    CNC 0x06a0
+    s.cycle += 15;
+    if (!s.flags.carry) {
+        push(s, bus, 0x05e4);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05e4;
+    }
+    return 2;
+}
+
+uint32_t block_05e4(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, 0x09); // 0x05e4    CPI 0x0009
+    // 0x05e6    CNZ 0x06a0
+    s.cycle += 18;
+    if (!s.flags.zero) {
+        push(s, bus, 0x05e9);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05e9;
+    }
+    return 2;
+}
+
+uint32_t block_05e9(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    rrc(s); // 0x05e9    RRC
+    // 0x05ea    CNC 0x06a0
+    s.cycle += 15;
+    if (!s.flags.carry) {
+        push(s, bus, 0x05ed);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05ed;
+    }
+    return 2;
+}
+
+uint32_t block_05ed(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    rrc(s); // 0x05ed    RRC
+    cmp(s, 0x42); // 0x05ee    CPI 0x0042
+    // 0x05f0    CNZ 0x06a0
+    s.cycle += 22;
+    if (!s.flags.zero) {
+        push(s, bus, 0x05f3);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05f3;
+    }
+    return 3;
+}
+
+uint32_t block_05f3(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    ral(s); // 0x05f3    RAL
+    ral(s); // 0x05f4    RAL
+    // 0x05f5    CNC 0x06a0
+    s.cycle += 19;
+    if (!s.flags.carry) {
+        push(s, bus, 0x05f8);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05f8;
+    }
+    return 3;
+}
+
+uint32_t block_05f8(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, 0x08); // 0x05f8    CPI 0x0008
+    // 0x05fa    CNZ 0x06a0
+    s.cycle += 18;
+    if (!s.flags.zero) {
+        push(s, bus, 0x05fd);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x05fd;
+    }
+    return 2;
+}
+
+uint32_t block_05fd(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    rar(s); // 0x05fd    RAR
+    rar(s); // 0x05fe    RAR
+    // 0x05ff    CC 0x06a0
+    s.cycle += 19;
+    if (s.flags.carry) {
+        push(s, bus, 0x0602);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0602;
+    }
+    return 3;
+}
+
+uint32_t block_0602(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, 0x02); // 0x0602    CPI 0x0002
+    // 0x0604    CNZ 0x06a0
+    s.cycle += 18;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0607);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0607;
+    }
+    return 2;
+}
+
+uint32_t block_0607(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.bc = 0x1234; // 0x0607    LXI B, 0x1234
+    s.de = 0xaaaa; // 0x060a    LXI D, 0xaaaa
+    s.hl = 0x5555; // 0x060d    LXI H, 0x5555
+    xra(s, s.a); // 0x0610    XRA A
+    push(s, bus, s.bc); // 0x0611    PUSH B
+    push(s, bus, s.de); // 0x0612    PUSH D
+    push(s, bus, s.hl); // 0x0613    PUSH H
+    push_psw(s, bus); // 0x0614    PUSH PSW
+    s.bc = 0x0000; // 0x0615    LXI B, 0x0000
+    s.de = 0x0000; // 0x0618    LXI D, 0x0000
+    s.hl = 0x0000; // 0x061b    LXI H, 0x0000
+    s.a = 0xc0; // 0x061e    MVI A, 0x00c0
+    add(s, 0xf0); // 0x0620    ADI 0x00f0
+    pop_psw(s, bus); // 0x0622    POP PSW
+    pop(s, bus, s.hl); // 0x0623    POP H
+    pop(s, bus, s.de); // 0x0624    POP D
+    pop(s, bus, s.bc); // 0x0625    POP B
+    // 0x0626    CC 0x06a0
+    s.cycle += 173;
+    if (s.flags.carry) {
+        push(s, bus, 0x0629);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0629;
+    }
+    return 18;
+}
+
+uint32_t block_0629(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x0629    CNZ 0x06a0
+    s.cycle += 11;
+    if (!s.flags.zero) {
+        push(s, bus, 0x062c);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x062c;
+    }
+    return 1;
+}
+
+uint32_t block_062c(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x062c    CPO 0x06a0
+    s.cycle += 11;
+    if (!s.flags.parity) {
+        push(s, bus, 0x062f);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x062f;
+    }
+    return 1;
+}
+
+uint32_t block_062f(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x062f    CM 0x06a0
+    s.cycle += 11;
+    if (s.flags.sign) {
+        push(s, bus, 0x0632);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0632;
+    }
+    return 1;
+}
+
+uint32_t block_0632(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x12; // 0x0632    MVI A, 0x0012
+    cmp(s, s.b); // 0x0634    CMP B
+    // 0x0635    CNZ 0x06a0
+    s.cycle += 22;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0638);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0638;
+    }
+    return 3;
+}
+
+uint32_t block_0638(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x34; // 0x0638    MVI A, 0x0034
+    cmp(s, s.c); // 0x063a    CMP C
+    // 0x063b    CNZ 0x06a0
+    s.cycle += 22;
+    if (!s.flags.zero) {
+        push(s, bus, 0x063e);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x063e;
+    }
+    return 3;
+}
+
+uint32_t block_063e(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0xaa; // 0x063e    MVI A, 0x00aa
+    cmp(s, s.d); // 0x0640    CMP D
+    // 0x0641    CNZ 0x06a0
+    s.cycle += 22;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0644);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0644;
+    }
+    return 3;
+}
+
+uint32_t block_0644(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, s.e); // 0x0644    CMP E
+    // 0x0645    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0648);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0648;
+    }
+    return 2;
+}
+
+uint32_t block_0648(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x55; // 0x0648    MVI A, 0x0055
+    cmp(s, s.h); // 0x064a    CMP H
+    // 0x064b    CNZ 0x06a0
+    s.cycle += 22;
+    if (!s.flags.zero) {
+        push(s, bus, 0x064e);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x064e;
+    }
+    return 3;
+}
+
+uint32_t block_064e(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    cmp(s, s.l); // 0x064e    CMP L
+    // 0x064f    CNZ 0x06a0
+    s.cycle += 15;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0652);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0652;
+    }
+    return 2;
+}
+
+uint32_t block_0652(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.hl = 0x0000; // 0x0652    LXI H, 0x0000
+    dad(s, s.sp); // 0x0655    DAD SP
+    bus.mem_write(0x06c4, s.hl); // 0x0656    SHLD 0x06c4
+    s.sp = 0x06c3; // 0x0659    LXI SP, 0x06c3
+    s.sp--; // 0x065c    DCX SP
+    s.sp--; // 0x065d    DCX SP
+    s.sp++; // 0x065e    INX SP
+    s.sp--; // 0x065f    DCX SP
+    s.a = 0x55; // 0x0660    MVI A, 0x0055
+    bus.mem_write(0x06c1, s.a); // 0x0662    STA 0x06c1
+    s.a = ~s.a; // 0x0665    CMA
+    bus.mem_write(0x06c2, s.a); // 0x0666    STA 0x06c2
+    pop(s, bus, s.bc); // 0x0669    POP B
+    cmp(s, s.b); // 0x066a    CMP B
+    // 0x066b    CNZ 0x06a0
+    s.cycle += 128;
+    if (!s.flags.zero) {
+        push(s, bus, 0x066e);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x066e;
+    }
+    return 15;
+}
+
+uint32_t block_066e(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = ~s.a; // 0x066e    CMA
+    cmp(s, s.c); // 0x066f    CMP C
+    // 0x0670    CNZ 0x06a0
+    s.cycle += 19;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0673);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0673;
+    }
+    return 3;
+}
+
+uint32_t block_0673(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.hl = 0x06c3; // 0x0673    LXI H, 0x06c3
+    s.sp = s.hl; // 0x0676    SPHL
+    s.hl = 0x7733; // 0x0677    LXI H, 0x7733
+    s.sp--; // 0x067a    DCX SP
+    s.sp--; // 0x067b    DCX SP
+    xthl(s, bus); // 0x067c    XTHL
+    bus.mem_read(0x06c2, s.a); // 0x067d    LDA 0x06c2
+    cmp(s, 0x77); // 0x0680    CPI 0x0077
+    // 0x0682    CNZ 0x06a0
+    s.cycle += 84;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0685);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0685;
+    }
+    return 9;
+}
+
+uint32_t block_0685(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    bus.mem_read(0x06c1, s.a); // 0x0685    LDA 0x06c1
+    cmp(s, 0x33); // 0x0688    CPI 0x0033
+    // 0x068a    CNZ 0x06a0
+    s.cycle += 31;
+    if (!s.flags.zero) {
+        push(s, bus, 0x068d);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x068d;
+    }
+    return 3;
+}
+
+uint32_t block_068d(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = 0x55; // 0x068d    MVI A, 0x0055
+    cmp(s, s.l); // 0x068f    CMP L
+    // 0x0690    CNZ 0x06a0
+    s.cycle += 22;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0693);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0693;
+    }
+    return 3;
+}
+
+uint32_t block_0693(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.a = ~s.a; // 0x0693    CMA
+    cmp(s, s.h); // 0x0694    CMP H
+    // 0x0695    CNZ 0x06a0
+    s.cycle += 19;
+    if (!s.flags.zero) {
+        push(s, bus, 0x0698);
+        s.pc = 0x06a0;
+        s.cycle += 6;
+    } else {
+        s.pc = 0x0698;
+    }
+    return 3;
+}
+
+uint32_t block_0698(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    bus.mem_read(0x06c4, s.hl); // 0x0698    LHLD 0x06c4
+    s.sp = s.hl; // 0x069b    SPHL
+    s.hl = 0x06b4; // 0x069c    LXI H, 0x06b4
+    // 0x069f    PCHL
+    s.cycle += 36;
+    s.pc = s.hl;
+    return 4;
+}
+
+uint32_t block_06a0(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.hl = 0x0190; // 0x06a0    LXI H, 0x0190
+    // 0x06a3    CALL 0x014b
+    s.cycle += 27;
+    push(s, bus, 0x06a6);
+    s.pc = 0x014b;
+    return 2;
+}
+
+uint32_t block_06a6(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    pop(s, bus, s.hl); // 0x06a6    POP H
+    push(s, bus, s.hl); // 0x06a7    PUSH H
+    s.a = s.h; // 0x06a8    MOV A, H
+    // 0x06a9    CALL 0x015a
+    s.cycle += 43;
+    push(s, bus, 0x06ac);
+    s.pc = 0x015a;
+    return 4;
+}
+
+uint32_t block_06ac(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    pop(s, bus, s.hl); // 0x06ac    POP H
+    s.a = s.l; // 0x06ad    MOV A, L
+    // 0x06ae    CALL 0x015a
+    s.cycle += 32;
+    push(s, bus, 0x06b1);
+    s.pc = 0x015a;
+    return 3;
+}
+
+uint32_t block_06b1(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x06b1    JMP 0x0000
+    s.cycle += 10;
+    s.pc = 0x0000;
+    return 1;
+}
+
+uint32_t block_06b4(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    s.hl = 0x017a; // 0x06b4    LXI H, 0x017a
+    // 0x06b7    CALL 0x014b
+    s.cycle += 27;
+    push(s, bus, 0x06ba);
+    s.pc = 0x014b;
+    return 2;
+}
+
+uint32_t block_06ba(State& s, [[maybe_unused]] i8080::Bus& bus)
+{
+    // 0x06ba    JMP 0x0000
+    s.cycle += 10;
+    s.pc = 0x0000;
+    return 1;
+}
+
+uint32_t run_block(State& s, i8080::Bus& bus)
+{
+    switch (s.pc) {
+    case 0x0100:
+        return block_0100(s, bus);
+    case 0x014b:
+        return block_014b(s, bus);
+    case 0x0152:
+        return block_0152(s, bus);
+    case 0x0154:
+        return block_0154(s, bus);
+    case 0x0159:
+        return block_0159(s, bus);
+    case 0x015a:
+        return block_015a(s, bus);
+    case 0x015e:
+        return block_015e(s, bus);
+    case 0x0162:
+        return block_0162(s, bus);
+    case 0x0166:
+        return block_0166(s, bus);
+    case 0x016a:
+        return block_016a(s, bus);
+    case 0x016e:
+        return block_016e(s, bus);
+    case 0x0175:
+        return block_0175(s, bus);
+    case 0x0177:
+        return block_0177(s, bus);
+    case 0x01b2:
+        return block_01b2(s, bus);
+    case 0x01bb:
+        return block_01bb(s, bus);
+    case 0x01c0:
+        return block_01c0(s, bus);
+    case 0x01c3:
+        return block_01c3(s, bus);
+    case 0x01c6:
+        return block_01c6(s, bus);
+    case 0x01c9:
+        return block_01c9(s, bus);
+    case 0x01cc:
+        return block_01cc(s, bus);
+    case 0x01cf:
+        return block_01cf(s, bus);
+    case 0x01d2:
+        return block_01d2(s, bus);
+    case 0x01d5:
+        return block_01d5(s, bus);
+    case 0x01d8:
+        return block_01d8(s, bus);
+    case 0x01db:
+        return block_01db(s, bus);
+    case 0x01de:
+        return block_01de(s, bus);
+    case 0x01e1:
+        return block_01e1(s, bus);
+    case 0x01e4:
+        return block_01e4(s, bus);
+    case 0x01e7:
+        return block_01e7(s, bus);
+    case 0x01ec:
+        return block_01ec(s, bus);
+    case 0x01ef:
+        return block_01ef(s, bus);
+    case 0x01f2:
+        return block_01f2(s, bus);
+    case 0x01f5:
+        return block_01f5(s, bus);
+    case 0x01f8:
+        return block_01f8(s, bus);
+    case 0x01fb:
+        return block_01fb(s, bus);
+    case 0x0200:
+        return block_0200(s, bus);
+    case 0x0203:
+        return block_0203(s, bus);
+    case 0x0206:
+        return block_0206(s, bus);
+    case 0x0209:
+        return block_0209(s, bus);
+    case 0x020c:
+        return block_020c(s, bus);
+    case 0x020f:
+        return block_020f(s, bus);
+    case 0x0214:
+        return block_0214(s, bus);
+    case 0x0217:
+        return block_0217(s, bus);
+    case 0x021a:
+        return block_021a(s, bus);
+    case 0x021d:
+        return block_021d(s, bus);
+    case 0x0220:
+        return block_0220(s, bus);
+    case 0x0223:
+        return block_0223(s, bus);
+    case 0x0228:
+        return block_0228(s, bus);
+    case 0x022b:
+        return block_022b(s, bus);
+    case 0x022e:
+        return block_022e(s, bus);
+    case 0x0231:
+        return block_0231(s, bus);
+    case 0x0234:
+        return block_0234(s, bus);
+    case 0x0237:
+        return block_0237(s, bus);
+    case 0x023c:
+        return block_023c(s, bus);
+    case 0x023f:
+        return block_023f(s, bus);
+    case 0x0244:
+        return block_0244(s, bus);
+    case 0x0247:
+        return block_0247(s, bus);
+    case 0x024c:
+        return block_024c(s, bus);
+    case 0x024f:
+        return block_024f(s, bus);
+    case 0x0252:
+        return block_0252(s, bus);
+    case 0x025b:
+        return block_025b(s, bus);
+    case 0x025e:
+        return block_025e(s, bus);
+    case 0x0267:
+        return block_0267(s, bus);
+    case 0x026a:
+        return block_026a(s, bus);
+    case 0x0273:
+        return block_0273(s, bus);
+    case 0x0276:
+        return block_0276(s, bus);
+    case 0x027d:
+        return block_027d(s, bus);
+    case 0x0280:
+        return block_0280(s, bus);
+    case 0x0287:
+        return block_0287(s, bus);
+    case 0x028a:
+        return block_028a(s, bus);
+    case 0x0291:
+        return block_0291(s, bus);
+    case 0x0294:
+        return block_0294(s, bus);
+    case 0x0299:
+        return block_0299(s, bus);
+    case 0x029c:
+        return block_029c(s, bus);
+    case 0x029f:
+        return block_029f(s, bus);
+    case 0x02a2:
+        return block_02a2(s, bus);
+    case 0x02a7:
+        return block_02a7(s, bus);
+    case 0x02aa:
+        return block_02aa(s, bus);
+    case 0x02af:
+        return block_02af(s, bus);
+    case 0x02b2:
+        return block_02b2(s, bus);
+    case 0x02b5:
+        return block_02b5(s, bus);
+    case 0x02b8:
+        return block_02b8(s, bus);
+    case 0x02bd:
+        return block_02bd(s, bus);
+    case 0x02c0:
+        return block_02c0(s, bus);
+    case 0x02c5:
+        return block_02c5(s, bus);
+    case 0x02ca:
+        return block_02ca(s, bus);
+    case 0x02cd:
+        return block_02cd(s, bus);
+    case 0x02ce:
+        return block_02ce(s, bus);
+    case 0x02d3:
+        return block_02d3(s, bus);
+    case 0x02d6:
+        return block_02d6(s, bus);
+    case 0x02d9:
+        return block_02d9(s, bus);
+    case 0x02da:
+        return block_02da(s, bus);
+    case 0x02df:
+        return block_02df(s, bus);
+    case 0x02e2:
+        return block_02e2(s, bus);
+    case 0x02e5:
+        return block_02e5(s, bus);
+    case 0x02e6:
+        return block_02e6(s, bus);
+    case 0x02eb:
+        return block_02eb(s, bus);
+    case 0x02ee:
+        return block_02ee(s, bus);
+    case 0x02f1:
+        return block_02f1(s, bus);
+    case 0x02f2:
+        return block_02f2(s, bus);
+    case 0x02f7:
+        return block_02f7(s, bus);
+    case 0x02fa:
+        return block_02fa(s, bus);
+    case 0x02fd:
+        return block_02fd(s, bus);
+    case 0x02fe:
+        return block_02fe(s, bus);
+    case 0x0300:
+        return block_0300(s, bus);
+    case 0x0303:
+        return block_0303(s, bus);
+    case 0x0306:
+        return block_0306(s, bus);
+    case 0x0309:
+        return block_0309(s, bus);
+    case 0x030a:
+        return block_030a(s, bus);
+    case 0x030f:
+        return block_030f(s, bus);
+    case 0x0312:
+        return block_0312(s, bus);
+    case 0x0315:
+        return block_0315(s, bus);
+    case 0x0316:
+        return block_0316(s, bus);
+    case 0x031b:
+        return block_031b(s, bus);
+    case 0x031e:
+        return block_031e(s, bus);
+    case 0x0321:
+        return block_0321(s, bus);
+    case 0x0322:
+        return block_0322(s, bus);
+    case 0x0327:
+        return block_0327(s, bus);
+    case 0x032a:
+        return block_032a(s, bus);
+    case 0x0369:
+        return block_0369(s, bus);
+    case 0x0382:
+        return block_0382(s, bus);
+    case 0x038d:
+        return block_038d(s, bus);
+    case 0x0391:
+        return block_0391(s, bus);
+    case 0x03ba:
+        return block_03ba(s, bus);
+    case 0x03d1:
+        return block_03d1(s, bus);
+    case 0x03da:
+        return block_03da(s, bus);
+    case 0x03f4:
+        return block_03f4(s, bus);
+    case 0x0401:
+        return block_0401(s, bus);
+    case 0x040d:
+        return block_040d(s, bus);
+    case 0x041e:
+        return block_041e(s, bus);
+    case 0x0422:
+        return block_0422(s, bus);
+    case 0x0438:
+        return block_0438(s, bus);
+    case 0x0442:
+        return block_0442(s, bus);
+    case 0x044c:
+        return block_044c(s, bus);
+    case 0x0456:
+        return block_0456(s, bus);
+    case 0x0462:
+        return block_0462(s, bus);
+    case 0x046e:
+        return block_046e(s, bus);
+    case 0x0479:
+        return block_0479(s, bus);
+    case 0x047f:
+        return block_047f(s, bus);
+    case 0x0486:
+        return block_0486(s, bus);
+    case 0x048f:
+        return block_048f(s, bus);
+    case 0x0498:
+        return block_0498(s, bus);
+    case 0x04a1:
+        return block_04a1(s, bus);
+    case 0x04a5:
+        return block_04a5(s, bus);
+    case 0x04ad:
+        return block_04ad(s, bus);
+    case 0x04b3:
+        return block_04b3(s, bus);
+    case 0x04bd:
+        return block_04bd(s, bus);
+    case 0x04cf:
+        return block_04cf(s, bus);
+    case 0x04d3:
+        return block_04d3(s, bus);
+    case 0x04d7:
+        return block_04d7(s, bus);
+    case 0x04dd:
+        return block_04dd(s, bus);
+    case 0x04e1:
+        return block_04e1(s, bus);
+    case 0x04e5:
+        return block_04e5(s, bus);
+    case 0x04ee:
+        return block_04ee(s, bus);
+    case 0x04f2:
+        return block_04f2(s, bus);
+    case 0x04f6:
+        return block_04f6(s, bus);
+    case 0x04fc:
+        return block_04fc(s, bus);
+    case 0x0500:
+        return block_0500(s, bus);
+    case 0x0504:
+        return block_0504(s, bus);
+    case 0x0510:
+        return block_0510(s, bus);
+    case 0x0521:
+        return block_0521(s, bus);
+    case 0x052c:
+        return block_052c(s, bus);
+    case 0x053a:
+        return block_053a(s, bus);
+    case 0x0544:
+        return block_0544(s, bus);
+    case 0x0557:
+        return block_0557(s, bus);
+    case 0x055d:
+        return block_055d(s, bus);
+    case 0x056e:
+        return block_056e(s, bus);
+    case 0x0578:
+        return block_0578(s, bus);
+    case 0x057c:
+        return block_057c(s, bus);
+    case 0x0588:
+        return block_0588(s, bus);
+    case 0x058c:
+        return block_058c(s, bus);
+    case 0x0592:
+        return block_0592(s, bus);
+    case 0x059f:
+        return block_059f(s, bus);
+    case 0x05a3:
+        return block_05a3(s, bus);
+    case 0x05a7:
+        return block_05a7(s, bus);
+    case 0x05ab:
+        return block_05ab(s, bus);
+    case 0x05b3:
+        return block_05b3(s, bus);
+    case 0x05ba:
+        return block_05ba(s, bus);
+    case 0x05c3:
+        return block_05c3(s, bus);
+    case 0x05ca:
+        return block_05ca(s, bus);
+    case 0x05cf:
+        return block_05cf(s, bus);
+    case 0x05d6:
+        return block_05d6(s, bus);
+    case 0x05d9:
+        return block_05d9(s, bus);
+    case 0x05e0:
+        return block_05e0(s, bus);
+    case 0x05e4:
+        return block_05e4(s, bus);
+    case 0x05e9:
+        return block_05e9(s, bus);
+    case 0x05ed:
+        return block_05ed(s, bus);
+    case 0x05f3:
+        return block_05f3(s, bus);
+    case 0x05f8:
+        return block_05f8(s, bus);
+    case 0x05fd:
+        return block_05fd(s, bus);
+    case 0x0602:
+        return block_0602(s, bus);
+    case 0x0607:
+        return block_0607(s, bus);
+    case 0x0629:
+        return block_0629(s, bus);
+    case 0x062c:
+        return block_062c(s, bus);
+    case 0x062f:
+        return block_062f(s, bus);
+    case 0x0632:
+        return block_0632(s, bus);
+    case 0x0638:
+        return block_0638(s, bus);
+    case 0x063e:
+        return block_063e(s, bus);
+    case 0x0644:
+        return block_0644(s, bus);
+    case 0x0648:
+        return block_0648(s, bus);
+    case 0x064e:
+        return block_064e(s, bus);
+    case 0x0652:
+        return block_0652(s, bus);
+    case 0x066e:
+        return block_066e(s, bus);
+    case 0x0673:
+        return block_0673(s, bus);
+    case 0x0685:
+        return block_0685(s, bus);
+    case 0x068d:
+        return block_068d(s, bus);
+    case 0x0693:
+        return block_0693(s, bus);
+    case 0x0698:
+        return block_0698(s, bus);
+    case 0x06a0:
+        return block_06a0(s, bus);
+    case 0x06a6:
+        return block_06a6(s, bus);
+    case 0x06ac:
+        return block_06ac(s, bus);
+    case 0x06b1:
+        return block_06b1(s, bus);
+    case 0x06b4:
+        return block_06b4(s, bus);
+    case 0x06ba:
+        return block_06ba(s, bus);
+    default:
+        return 0;
+    }
+}
+} // namespace
+
+extern const i8080::NativeProgram test8080_native;
+const i8080::NativeProgram test8080_native { .origin = 0x0100, .image = IMAGE, .code = run_block };
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tracedump"
+  "../bin/tracedump.pdb"
+  "CMakeFiles/tracedump.dir/main.cpp.o"
+  "CMakeFiles/tracedump.dir/main.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tracedump.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tracedump
+# Build directory: /root/repo/_prof_build/tracedump
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[tracedump_test8080]=] "/usr/bin/cmake" "-DTESTER=/root/repo/_prof_build/bin/tester" "-DTRACEDUMP=/root/repo/_prof_build/bin/tracedump" "-DROM=/root/repo/resources/test8080.com" "-DTRACE=/root/repo/_prof_build/tracedump/test8080.trace" "-DRECORDS=651" "-P" "/root/repo/tracedump/check_trace.cmake")
+set_tests_properties([=[tracedump_test8080]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tracedump/CMakeLists.txt;11;add_test;/root/repo/tracedump/CMakeLists.txt;0;")
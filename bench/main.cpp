@@ -0,0 +1,502 @@
+#include <i8080/bus.h>
+#include <i8080/cpu.h>
+#include <i8080/device.h>
+#include <i8080/native.h>
+#include <i8080/workload.h>
+
+#include <fmt/core.h>
+#include <fmt/os.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using buffer = std::vector<uint8_t>;
+using clock_type = std::chrono::steady_clock;
+
+// Recompiled at build time by i8080_recompile()
+extern const i8080::NativeProgram test8080_native;
+
+static constexpr uint16_t PROGRAM_START_OFFSET = 0x100;
+static constexpr uint64_t INSTRUCTIONS_PER_CHECK = 1 << 16;
+static constexpr double DEFAULT_MIN_SECONDS = 0.5;
+static constexpr size_t MICRO_BODY_REPEATS = 64;
+static constexpr double DEFAULT_TOLERANCE = 0.2;
+// Exit code when a benchmark is slower than its baseline allows
+static constexpr int REGRESSION_EXIT_CODE = 3;
+
+struct Result
+{
+    std::string name;
+    uint64_t instructions;
+    uint64_t cycles;
+    double seconds;
+
+    double mips() const { return instructions / seconds / 1e6; }
+
+    double ns_per_instruction() const { return seconds * 1e9 / instructions; }
+
+    double emulated_mhz() const { return cycles / seconds / 1e6; }
+};
+
+struct Benchmark
+{
+    std::string name;
+    std::function<Result(double)> run;
+};
+
+// Swallows port traffic, so I/O benchmarks measure the bus and not the device
+class NullDevice : public i8080::Device
+{
+public:
+    void write(uint8_t) override {}
+
+    void read(uint8_t& byte) override { byte = 0x5a; }
+};
+
+// Runs a program that loops forever until the time budget is used up
+static Result run_loop(const std::string& name,
+                       const buffer& image,
+                       double min_seconds,
+                       i8080::Cpu::Timing timing = i8080::Cpu::Timing::exact)
+{
+    buffer memory = image;
+    i8080::Bus bus(memory);
+    i8080::Cpu cpu(bus, PROGRAM_START_OFFSET, timing);
+
+    auto device = std::make_shared<NullDevice>();
+    bus.register_device(1, device);
+    bus.register_device(2, device);
+    bus.register_device(i8080::WorkloadGenerator::STATUS_PORT, device);
+    bus.register_device(i8080::WorkloadGenerator::DATA_PORT, device);
+
+    uint64_t instructions = 0;
+    auto start = clock_type::now();
+    std::chrono::duration<double> elapsed {};
+
+    do {
+        // Fast timing only charges whole blocks when run() drives it
+        if (timing == i8080::Cpu::Timing::fast) {
+            uint64_t retired = cpu.retired();
+            cpu.run(INSTRUCTIONS_PER_CHECK);
+            instructions += cpu.retired() - retired;
+        } else {
+            for (uint64_t i = 0; i < INSTRUCTIONS_PER_CHECK; i++) {
+                cpu.tick();
+            }
+
+            instructions += INSTRUCTIONS_PER_CHECK;
+        }
+
+        elapsed = clock_type::now() - start;
+    } while (elapsed.count() < min_seconds && !cpu.halt());
+
+    return { name, instructions, cpu.state().cycle, elapsed.count() };
+}
+
+// Runs the diagnostic ROM to completion as many times as fits in the time budget, through its
+// recompiled code if there is some for it
+static Result run_rom(const std::string& name,
+                      const fs::path& path,
+                      double min_seconds,
+                      const i8080::NativeProgram* native = nullptr)
+{
+    buffer image(i8080::Bus::MEMORY_SIZE);
+    std::ifstream rom(path, std::ios::binary);
+    if (!rom.is_open()) {
+        throw std::runtime_error(fmt::format("Could not open file: {}", path.string()));
+    }
+
+    rom.read(reinterpret_cast<char*>(image.data() + PROGRAM_START_OFFSET),
+             image.size() - PROGRAM_START_OFFSET);
+
+    // Warm boot halts, BDOS calls return straight away
+    image[0] = static_cast<uint8_t>(i8080::Instruction::HLT);
+    image[5] = static_cast<uint8_t>(i8080::Instruction::RET);
+
+    if (native && !native->matches(image)) {
+        throw std::runtime_error(fmt::format("No recompiled code for {}", path.string()));
+    }
+
+    uint64_t instructions = 0;
+    uint64_t cycles = 0;
+    std::chrono::duration<double> elapsed {};
+    buffer memory(image.size());
+
+    auto start = clock_type::now();
+    do {
+        std::memcpy(memory.data(), image.data(), image.size());
+        i8080::Bus bus(memory);
+        i8080::Cpu cpu(bus, PROGRAM_START_OFFSET);
+
+        if (native) {
+            cpu.set_native_code(native->code);
+            while (!cpu.halt()) {
+                cpu.run(INSTRUCTIONS_PER_CHECK);
+            }
+
+            instructions += cpu.retired();
+        } else {
+            while (!cpu.halt()) {
+                cpu.tick();
+                instructions++;
+            }
+        }
+
+        cycles += cpu.state().cycle;
+        elapsed = clock_type::now() - start;
+    } while (elapsed.count() < min_seconds);
+
+    return { name, instructions, cycles, elapsed.count() };
+}
+
+static buffer make_image(const std::vector<uint8_t>& program)
+{
+    buffer image(i8080::Bus::MEMORY_SIZE);
+    std::ranges::copy(program, image.begin() + PROGRAM_START_OFFSET);
+    return image;
+}
+
+// Prologue, then the body repeated back to back and a jump to the first repetition
+static buffer make_micro_image(const std::vector<uint8_t>& prologue,
+                               const std::vector<uint8_t>& body)
+{
+    std::vector<uint8_t> program = prologue;
+    uint16_t loop = PROGRAM_START_OFFSET + prologue.size();
+
+    for (size_t i = 0; i < MICRO_BODY_REPEATS; i++) {
+        program.insert(program.end(), body.begin(), body.end());
+    }
+
+    program.push_back(static_cast<uint8_t>(i8080::Instruction::JMP));
+    program.push_back(loop & 0xff);
+    program.push_back(loop >> 8);
+    return make_image(program);
+}
+
+static std::vector<Benchmark> make_benchmarks(const fs::path& rom)
+{
+    std::vector<Benchmark> benchmarks;
+
+    auto add_loop = [&benchmarks](const std::string& name,
+                                  buffer image,
+                                  i8080::Cpu::Timing timing = i8080::Cpu::Timing::exact) {
+        benchmarks.push_back({ name, [name, image = std::move(image), timing](double min_seconds) {
+                                  return run_loop(name, image, min_seconds, timing);
+                              } });
+    };
+
+    benchmarks.push_back(
+        { "macro/test8080", [rom](double min_seconds) {
+             return run_rom("macro/test8080", rom, min_seconds);
+         } });
+
+    benchmarks.push_back(
+        { "native/test8080", [rom](double min_seconds) {
+             return run_rom("native/test8080", rom, min_seconds, &test8080_native);
+         } });
+
+    // clang-format off
+    add_loop("macro/alu", make_image({
+        0x06, 0x00,             // MVI B, 0
+        0x80,                   // loop: ADD B
+        0xa9,                   // XRA C
+        0xc6, 0x03,             // ADI 3
+        0xa2,                   // ANA D
+        0xb3,                   // ORA E
+        0x94,                   // SUB H
+        0xfe, 0x07,             // CPI 7
+        0x07,                   // RLC
+        0x04,                   // INR B
+        0xc3, 0x02, 0x01,       // JMP loop
+    }));
+
+    add_loop("macro/memory", make_image({
+        0x21, 0x00, 0x20,       // LXI H, 0x2000
+        0x11, 0x00, 0x40,       // LXI D, 0x4000
+        0x7e,                   // loop: MOV A, M
+        0x12,                   // STAX D
+        0x23,                   // INX H
+        0x13,                   // INX D
+        0x77,                   // MOV M, A
+        0x7c,                   // MOV A, H
+        0xe6, 0x3f,             // ANI 0x3f
+        0xf6, 0x20,             // ORI 0x20
+        0x67,                   // MOV H, A
+        0x7a,                   // MOV A, D
+        0xe6, 0x5f,             // ANI 0x5f
+        0xf6, 0x40,             // ORI 0x40
+        0x57,                   // MOV D, A
+        0xc3, 0x06, 0x01,       // JMP loop
+    }));
+
+    add_loop("macro/branch", make_image({
+        0x0c,                   // loop: INR C
+        0x79,                   // MOV A, C
+        0xe6, 0x03,             // ANI 3
+        0xca, 0x0d, 0x01,       // JZ skip
+        0xcd, 0x12, 0x01,       // CALL sub
+        0xc3, 0x00, 0x01,       // JMP loop
+        0xfe, 0x02,             // skip: CPI 2
+        0xc3, 0x00, 0x01,       // JMP loop
+        0x3d,                   // sub: DCR A
+        0xc0,                   // RNZ
+        0xc9,                   // RET
+    }));
+
+    add_loop("macro/io", make_image({
+        0xdb, 0x01,             // loop: IN 1
+        0xd3, 0x02,             // OUT 2
+        0x0c,                   // INR C
+        0xc3, 0x00, 0x01,       // JMP loop
+    }));
+
+    add_loop("micro/mov", make_micro_image({}, { 0x41, 0x53, 0x65, 0x78, 0x4a, 0x5c }));
+    add_loop("micro/mov_m", make_micro_image({ 0x21, 0x00, 0x80 }, { 0x7e, 0x77, 0x46, 0x70 }));
+    add_loop("micro/alu", make_micro_image({}, { 0x80, 0x91, 0xa2, 0xab, 0xb4, 0xbd }));
+    add_loop("micro/alu_m", make_micro_image({ 0x21, 0x00, 0x80 }, { 0x86, 0x96, 0xa6, 0xbe }));
+    add_loop("micro/alu_imm", make_micro_image({}, { 0xc6, 0x01, 0xd6, 0x01,
+                                                     0xe6, 0xff, 0xfe, 0x03 }));
+    add_loop("micro/inr_dcr", make_micro_image({}, { 0x04, 0x0d, 0x13, 0x2b }));
+    add_loop("micro/lxi", make_micro_image({}, { 0x01, 0x34, 0x12, 0x11, 0x78, 0x56 }));
+    add_loop("micro/rotate", make_micro_image({}, { 0x07, 0x0f, 0x17, 0x1f }));
+    add_loop("micro/stack", make_micro_image({ 0x31, 0x00, 0xf0 }, { 0xc5, 0xc1, 0xd5, 0xd1 }));
+    add_loop("micro/call_ret", make_micro_image({ 0x31, 0x00, 0xf0, 0x3e, 0xc9, 0x32, 0x40, 0x00 },
+                                                { 0xcd, 0x40, 0x00 }));
+    add_loop("micro/io", make_micro_image({}, { 0xd3, 0x01, 0xdb, 0x02 }));
+    // clang-format on
+
+    // Generated programs of each shape, looping forever, in both timings
+    for (i8080::WorkloadGenerator::Kind kind : i8080::WorkloadGenerator::KINDS) {
+        i8080::WorkloadGenerator generator({ .kind = kind });
+        buffer image = make_image(generator.generate());
+        std::string_view kind_name = i8080::WorkloadGenerator::kind_name(kind);
+
+        add_loop(fmt::format("workload/{}", kind_name), image);
+        add_loop(fmt::format("workload/{}/fast", kind_name),
+                 std::move(image),
+                 i8080::Cpu::Timing::fast);
+    }
+
+    return benchmarks;
+}
+
+static void print_table(const std::vector<Result>& results)
+{
+    fmt::println("{:<28} {:>14} {:>10} {:>12} {:>12}",
+                 "benchmark",
+                 "instructions",
+                 "MIPS",
+                 "ns/instr",
+                 "emu MHz");
+
+    for (const Result& result : results) {
+        fmt::println("{:<28} {:>14} {:>10.2f} {:>12.2f} {:>12.2f}",
+                     result.name,
+                     result.instructions,
+                     result.mips(),
+                     result.ns_per_instruction(),
+                     result.emulated_mhz());
+    }
+}
+
+// Runs a benchmark several times and keeps the run with the median throughput, so a single
+// run disturbed by the rest of the machine doesn't decide the result
+static Result run_median(const Benchmark& benchmark, double min_seconds, size_t repeats)
+{
+    std::vector<Result> runs;
+    for (size_t i = 0; i < repeats; i++) {
+        runs.push_back(benchmark.run(min_seconds));
+    }
+
+    auto median = runs.begin() + runs.size() / 2;
+    std::ranges::nth_element(runs, median, {}, &Result::mips);
+    return *median;
+}
+
+// MIPS by benchmark name, from a file written by --json
+static std::map<std::string, double> read_baseline(const fs::path& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error(fmt::format("Could not open file: {}", path.string()));
+    }
+
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::string text = contents.str();
+
+    static const std::regex entry(R"re("name": "([^"]+)"[^}]*"mips": ([0-9.]+))re");
+
+    std::map<std::string, double> baseline;
+    for (auto it = std::sregex_iterator(text.begin(), text.end(), entry);
+         it != std::sregex_iterator();
+         ++it) {
+        baseline[(*it)[1].str()] = std::stod((*it)[2].str());
+    }
+
+    return baseline;
+}
+
+// Returns whether every benchmark with a baseline is within the tolerance below it. Being faster
+// never fails, benchmarks missing from the baseline are reported and skipped. With a reference,
+// each benchmark's throughput is taken as a fraction of the reference's in the same run, and
+// compared with the same fraction in the baseline.
+static bool check_baseline(const std::map<std::string, double>& baseline,
+                           const std::vector<Result>& results,
+                           double tolerance,
+                           const std::optional<std::string>& reference)
+{
+    double scale = 1;
+    double baseline_scale = 1;
+    if (reference) {
+        auto result = std::ranges::find(results, *reference, &Result::name);
+        auto it = baseline.find(*reference);
+        if (result == results.end() || it == baseline.end()) {
+            throw std::runtime_error(fmt::format("No baseline for the reference {}", *reference));
+        }
+
+        scale = result->mips();
+        baseline_scale = it->second;
+        fmt::println("\nThroughput relative to {}", *reference);
+    }
+
+    bool passed = true;
+
+    fmt::println("\n{:<28} {:>10} {:>10} {:>9}",
+                 "benchmark",
+                 reference ? "relative" : "MIPS",
+                 "baseline",
+                 "change");
+    for (const Result& result : results) {
+        if (result.name == reference) {
+            continue;
+        }
+
+        auto it = baseline.find(result.name);
+        if (it == baseline.end()) {
+            fmt::println("{:<28} {:>10.2f} {:>10} {:>9}  no baseline",
+                         result.name,
+                         result.mips() / scale,
+                         "-",
+                         "-");
+            continue;
+        }
+
+        double expected = it->second / baseline_scale;
+        double change = result.mips() / scale / expected - 1;
+        bool regressed = (change < -tolerance);
+        passed &= !regressed;
+
+        fmt::println("{:<28} {:>10.2f} {:>10.2f} {:>+8.1f}%  {}",
+                     result.name,
+                     result.mips() / scale,
+                     expected,
+                     change * 100,
+                     regressed ? "REGRESSION" : "ok");
+    }
+
+    fmt::println("tolerance {:.1f}%: {}", tolerance * 100, passed ? "passed" : "failed");
+    return passed;
+}
+
+static void write_json(const fs::path& path, const std::vector<Result>& results)
+{
+    auto out = fmt::output_file(path.string());
+    out.print("{{\n  \"benchmarks\": [\n");
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        out.print("    {{\"name\": \"{}\", \"instructions\": {}, \"cycles\": {}, "
+                  "\"seconds\": {:.6f}, \"mips\": {:.3f}, \"ns_per_instruction\": {:.3f}, "
+                  "\"emulated_mhz\": {:.3f}}}{}\n",
+                  result.name,
+                  result.instructions,
+                  result.cycles,
+                  result.seconds,
+                  result.mips(),
+                  result.ns_per_instruction(),
+                  result.emulated_mhz(),
+                  (i + 1 < results.size()) ? "," : "");
+    }
+
+    out.print("  ]\n}}\n");
+}
+
+int main(int argc, char* argv[])
+{
+    fs::path rom = I8080_TEST_ROM;
+    std::optional<fs::path> json;
+    std::string filter;
+    double min_seconds = DEFAULT_MIN_SECONDS;
+    size_t repeats = 1;
+    std::optional<fs::path> baseline;
+    double tolerance = DEFAULT_TOLERANCE;
+    std::optional<std::string> reference;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool has_value = (i + 1 < argc);
+
+        if (argument == "--json" && has_value) {
+            json = argv[++i];
+        } else if (argument == "--filter" && has_value) {
+            filter = argv[++i];
+        } else if (argument == "--min-time" && has_value) {
+            min_seconds = std::stod(argv[++i]);
+        } else if (argument == "--rom" && has_value) {
+            rom = argv[++i];
+        } else if (argument == "--repeat" && has_value) {
+            repeats = std::max(std::stoul(argv[++i]), 1ul);
+        } else if (argument == "--baseline" && has_value) {
+            baseline = argv[++i];
+        } else if (argument == "--tolerance" && has_value) {
+            tolerance = std::stod(argv[++i]);
+        } else if (argument == "--reference" && has_value) {
+            reference = argv[++i];
+        } else {
+            fmt::println("Usage: bench [--json <file>] [--filter <substring>] "
+                         "[--min-time <seconds>] [--rom <test_rom>] [--repeat <runs>] "
+                         "[--baseline <json> [--tolerance <fraction>] [--reference <benchmark>]]");
+            return 1;
+        }
+    }
+
+    try {
+        std::vector<Result> results;
+        for (const Benchmark& benchmark : make_benchmarks(rom)) {
+            // The reference runs whatever the filter, since the others are measured against it
+            if (benchmark.name.find(filter) != std::string::npos || benchmark.name == reference) {
+                results.push_back(run_median(benchmark, min_seconds, repeats));
+            }
+        }
+
+        print_table(results);
+
+        if (json) {
+            write_json(*json, results);
+        }
+
+        if (baseline &&
+            !check_baseline(read_baseline(*baseline), results, tolerance, reference)) {
+            return REGRESSION_EXIT_CODE;
+        }
+    } catch (const std::exception& e) {
+        fmt::println("Benchmark failed: {}", e.what());
+        return 2;
+    }
+
+    return 0;
+}
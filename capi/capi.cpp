@@ -0,0 +1,287 @@
+#include <i8080.h>
+
+#include <i8080/machine.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+static_assert(sizeof(i8080_registers) == 24, "i8080_registers is part of the ABI");
+
+struct i8080_machine
+{
+    i8080_machine(uint16_t entry_point, i8080::Cpu::Timing timing) :
+        machine(entry_point, timing)
+    {}
+
+    i8080::Machine machine;
+};
+
+// Hands the port's reads and writes to the host's callbacks
+class CallbackPort final : public i8080::Device
+{
+public:
+    CallbackPort(uint8_t port, i8080_port_in in, i8080_port_out out, void* context) :
+        _port(port),
+        _in(in),
+        _out(out),
+        _context(context)
+    {}
+
+    void write(uint8_t byte) override
+    {
+        if (_out) {
+            _out(_context, _port, byte);
+        }
+    }
+
+    void read(uint8_t& byte) override
+    {
+        if (_in) {
+            byte = _in(_context, _port);
+        }
+    }
+
+private:
+    uint8_t _port;
+    i8080_port_in _in;
+    i8080_port_out _out;
+    void* _context;
+};
+
+static thread_local std::string last_error;
+
+// Runs the call with the thread's error cleared, turning what it throws into I8080_ERROR and the
+// message i8080_error() returns, so no exception reaches the host
+template <typename Call>
+static int guarded(Call&& call)
+{
+    last_error.clear();
+    try {
+        call();
+        return I8080_OK;
+    } catch (const std::exception& e) {
+        last_error = e.what();
+    } catch (...) {
+        last_error = "Unknown error";
+    }
+
+    return I8080_ERROR;
+}
+
+static void check_machine(const i8080_machine* machine)
+{
+    if (!machine) {
+        throw std::runtime_error("No machine");
+    }
+}
+
+static void check_range(uint16_t address, size_t size)
+{
+    if (address + size > i8080::Bus::ADDRESS_SPACE_SIZE) {
+        throw std::runtime_error(fmt::format(
+            "{} bytes at 0x{:04x} run past the end of the address space", size, address));
+    }
+}
+
+static i8080_stop_reason stop_reason(i8080::Cpu::StopReason reason)
+{
+    switch (reason) {
+    case i8080::Cpu::StopReason::cycles:
+        return I8080_STOP_CYCLES;
+    case i8080::Cpu::StopReason::halt:
+        return I8080_STOP_HALT;
+    case i8080::Cpu::StopReason::stop:
+    case i8080::Cpu::StopReason::breakpoint:
+        return I8080_STOP_REQUESTED;
+    }
+
+    return I8080_STOP_ERROR;
+}
+
+uint32_t i8080_api_version(void)
+{
+    return I8080_API_VERSION;
+}
+
+const char* i8080_error(void)
+{
+    return last_error.c_str();
+}
+
+i8080_machine* i8080_create(uint16_t entry_point, i8080_timing timing)
+{
+    i8080_machine* machine = nullptr;
+    guarded([&]() {
+        if (timing != I8080_TIMING_EXACT && timing != I8080_TIMING_FAST) {
+            throw std::runtime_error(fmt::format("Invalid timing: {}", static_cast<int>(timing)));
+        }
+
+        machine = new i8080_machine(entry_point,
+                                    (timing == I8080_TIMING_FAST) ? i8080::Cpu::Timing::fast
+                                                                  : i8080::Cpu::Timing::exact);
+    });
+
+    return machine;
+}
+
+void i8080_destroy(i8080_machine* machine)
+{
+    delete machine;
+}
+
+int i8080_load_file(i8080_machine* machine, const char* path, uint16_t address)
+{
+    return guarded([&]() {
+        check_machine(machine);
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error(fmt::format("Could not open file: {}", path));
+        }
+
+        buffer image(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char> {});
+        check_range(address, image.size());
+
+        std::ranges::copy(image, machine->machine.memory.begin() + address);
+        machine->machine.bus.sync_mirror();
+    });
+}
+
+int i8080_read_memory(const i8080_machine* machine, uint16_t address, uint8_t* data, size_t size)
+{
+    return guarded([&]() {
+        check_machine(machine);
+        check_range(address, size);
+
+        std::copy_n(machine->machine.memory.begin() + address, size, data);
+    });
+}
+
+int i8080_write_memory(i8080_machine* machine,
+                       uint16_t address,
+                       const uint8_t* data,
+                       size_t size)
+{
+    return guarded([&]() {
+        check_machine(machine);
+        check_range(address, size);
+
+        std::copy_n(data, size, machine->machine.memory.begin() + address);
+        machine->machine.bus.sync_mirror();
+    });
+}
+
+void i8080_get_registers(const i8080_machine* machine, i8080_registers* registers)
+{
+    if (!machine || !registers) {
+        return;
+    }
+
+    const i8080::Cpu::State& state = machine->machine.cpu.state();
+    *registers = i8080_registers { .a = state.a,
+                                   .flags = state.flags.status,
+                                   .b = state.b,
+                                   .c = state.c,
+                                   .d = state.d,
+                                   .e = state.e,
+                                   .h = state.h,
+                                   .l = state.l,
+                                   .sp = state.sp,
+                                   .pc = state.pc,
+                                   .halted = state.halt,
+                                   .interrupts_enabled = state.interrupts_enabled,
+                                   .reserved = {},
+                                   .cycles = state.cycle };
+}
+
+void i8080_set_registers(i8080_machine* machine, const i8080_registers* registers)
+{
+    if (!machine || !registers) {
+        return;
+    }
+
+    i8080::Cpu::State state = machine->machine.cpu.state();
+    state.a = registers->a;
+    state.flags.status = registers->flags;
+    state.b = registers->b;
+    state.c = registers->c;
+    state.d = registers->d;
+    state.e = registers->e;
+    state.h = registers->h;
+    state.l = registers->l;
+    state.sp = registers->sp;
+    state.pc = registers->pc;
+    state.halt = registers->halted;
+    state.interrupts_enabled = registers->interrupts_enabled;
+    machine->machine.cpu.set_state(state);
+}
+
+int i8080_set_port(i8080_machine* machine,
+                   uint8_t port,
+                   i8080_port_in in,
+                   i8080_port_out out,
+                   void* context)
+{
+    return guarded([&]() {
+        check_machine(machine);
+
+        machine->machine.bus.register_device(
+            port, (in || out) ? std::make_shared<CallbackPort>(port, in, out, context) : nullptr);
+    });
+}
+
+i8080_stop_reason i8080_run(i8080_machine* machine, uint64_t cycles)
+{
+    i8080_stop_reason reason = I8080_STOP_ERROR;
+    guarded([&]() {
+        check_machine(machine);
+
+        reason = stop_reason(machine->machine.cpu.run(cycles));
+    });
+
+    return reason;
+}
+
+int i8080_run_many(i8080_machine* const* machines,
+                   size_t count,
+                   uint64_t cycles,
+                   i8080_stop_reason* reasons)
+{
+    return guarded([&]() {
+        if (count && (!machines || !reasons)) {
+            throw std::runtime_error("No machines or reasons to run");
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            check_machine(machines[i]);
+
+            reasons[i] = stop_reason(machines[i]->machine.cpu.run(cycles));
+        }
+    });
+}
+
+void i8080_stop(i8080_machine* machine)
+{
+    if (machine) {
+        machine->machine.cpu.stop();
+    }
+}
+
+int i8080_interrupt(i8080_machine* machine, uint8_t rst)
+{
+    return guarded([&]() {
+        check_machine(machine);
+        if (rst > 7) {
+            throw std::runtime_error(fmt::format("Invalid restart: {}", rst));
+        }
+
+        machine->machine.cpu.interrupt(rst);
+    });
+}
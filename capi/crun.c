@@ -0,0 +1,83 @@
+/*
+ * Runs a CP/M diagnostic ROM through the C interface, the way a host in another language would:
+ * the console is two port callbacks and the machine runs in large batches between them.
+ */
+
+#include <i8080.h>
+
+#include <stdio.h>
+
+#define PROGRAM_START 0x100
+#define BATCH_CYCLES 1000000
+
+#define PRINT_CHARACTER 2
+#define PRINT_MESSAGE 9
+
+static const uint8_t HOOKS[] = {
+    /* 0: OUT 0, the end of the test */
+    0xd3, 0x00, 0x00, 0x00, 0x00,
+    /* 5: OUT 1 and RET, the BDOS entry the ROMs print through */
+    0xd3, 0x01, 0xc9
+};
+
+static void control(void* context, uint8_t port, uint8_t value)
+{
+    (void)port;
+    (void)value;
+    i8080_stop((i8080_machine*)context);
+}
+
+/* The BDOS function the ROM is calling is in C, whatever OUT sends */
+static void console(void* context, uint8_t port, uint8_t value)
+{
+    i8080_machine* machine = context;
+    i8080_registers registers;
+    (void)port;
+    (void)value;
+
+    i8080_get_registers(machine, &registers);
+    if (registers.c == PRINT_CHARACTER) {
+        putchar(registers.e);
+    } else if (registers.c == PRINT_MESSAGE) {
+        uint16_t address = (uint16_t)((registers.d << 8) | registers.e);
+        uint8_t character = 0;
+        while (i8080_read_memory(machine, address++, &character, 1) == I8080_OK &&
+               character != '$') {
+            putchar(character);
+        }
+
+        putchar('\n');
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    i8080_machine* machine;
+    i8080_registers registers;
+    i8080_stop_reason reason;
+
+    if (argc != 2) {
+        fprintf(stderr, "Usage: crun <test_rom>\n");
+        return 1;
+    }
+
+    machine = i8080_create(PROGRAM_START, I8080_TIMING_EXACT);
+    if (!machine || i8080_load_file(machine, argv[1], PROGRAM_START) != I8080_OK ||
+        i8080_write_memory(machine, 0, HOOKS, sizeof(HOOKS)) != I8080_OK ||
+        i8080_set_port(machine, 0, NULL, control, machine) != I8080_OK ||
+        i8080_set_port(machine, 1, NULL, console, machine) != I8080_OK) {
+        fprintf(stderr, "Test failed: %s\n", i8080_error());
+        i8080_destroy(machine);
+        return 2;
+    }
+
+    do {
+        reason = i8080_run(machine, BATCH_CYCLES);
+    } while (reason == I8080_STOP_CYCLES);
+
+    i8080_get_registers(machine, &registers);
+    printf("\nCPU ran %llu cycles\n", (unsigned long long)registers.cycles);
+
+    i8080_destroy(machine);
+    return (reason == I8080_STOP_REQUESTED) ? 0 : 2;
+}
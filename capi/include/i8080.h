@@ -0,0 +1,133 @@
+#ifndef I8080_H
+#define I8080_H
+
+/*
+ * A C interface to the emulator, for hosts written in other languages. Everything goes through an
+ * opaque machine: its memory, bus and CPU. A host loads an image, registers port callbacks and
+ * runs the machine for as many cycles at a time as it can afford to wait, so the cost of crossing
+ * into the library is paid once per batch rather than once per instruction.
+ *
+ * The interface only grows: functions keep their signatures and structs their layout, and the
+ * version goes up when something is added. A machine must only be used by one thread at a time.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define I8080_API_VERSION 1
+
+typedef struct i8080_machine i8080_machine;
+
+typedef enum i8080_timing
+{
+    /* Taken conditional calls and returns cost extra cycles, devices see I/O mid-instruction */
+    I8080_TIMING_EXACT = 0,
+    /* Every instruction costs its base cycles, charged and checked against the run budget a basic
+     * block at a time */
+    I8080_TIMING_FAST = 1
+} i8080_timing;
+
+typedef enum i8080_stop_reason
+{
+    /* The cycle budget ran out */
+    I8080_STOP_CYCLES = 0,
+    /* The CPU executed HLT and waits for an interrupt */
+    I8080_STOP_HALT = 1,
+    /* i8080_stop() was called, usually by a port callback */
+    I8080_STOP_REQUESTED = 2,
+    I8080_STOP_ERROR = -1
+} i8080_stop_reason;
+
+/* What the functions returning an int give back, see i8080_error() for the details */
+#define I8080_OK 0
+#define I8080_ERROR -1
+
+typedef struct i8080_registers
+{
+    uint8_t a;
+    uint8_t flags;
+    uint8_t b;
+    uint8_t c;
+    uint8_t d;
+    uint8_t e;
+    uint8_t h;
+    uint8_t l;
+    uint16_t sp;
+    uint16_t pc;
+    uint8_t halted;
+    uint8_t interrupts_enabled;
+    uint8_t reserved[2];
+    /* Cycles since the machine was created */
+    uint64_t cycles;
+} i8080_registers;
+
+/*
+ * Called when the guest executes IN or OUT on a port. The CPU is in the middle of run(), so a
+ * callback may read and write memory and registers or call i8080_stop(), but must not run or
+ * destroy the machine.
+ */
+typedef uint8_t (*i8080_port_in)(void* context, uint8_t port);
+typedef void (*i8080_port_out)(void* context, uint8_t port, uint8_t value);
+
+/* The I8080_API_VERSION the library was built with */
+uint32_t i8080_api_version(void);
+
+/* The message of the last failure on the calling thread, empty when there was none */
+const char* i8080_error(void);
+
+/* A machine with zeroed memory and the CPU at the entry point, or NULL on failure */
+i8080_machine* i8080_create(uint16_t entry_point, i8080_timing timing);
+void i8080_destroy(i8080_machine* machine);
+
+/* Copies a file into memory at the address */
+int i8080_load_file(i8080_machine* machine, const char* path, uint16_t address);
+
+/* Bulk memory access, which must not wrap past the end of the address space */
+int i8080_read_memory(const i8080_machine* machine, uint16_t address, uint8_t* data, size_t size);
+int i8080_write_memory(i8080_machine* machine,
+                       uint16_t address,
+                       const uint8_t* data,
+                       size_t size);
+
+void i8080_get_registers(const i8080_machine* machine, i8080_registers* registers);
+/* Sets everything but the cycle count, which only ever counts up */
+void i8080_set_registers(i8080_machine* machine, const i8080_registers* registers);
+
+/*
+ * Routes IN and OUT on the port to the callbacks, either of which may be NULL to leave that
+ * direction unconnected. Passing both as NULL disconnects the port.
+ */
+int i8080_set_port(i8080_machine* machine,
+                   uint8_t port,
+                   i8080_port_in in,
+                   i8080_port_out out,
+                   void* context);
+
+/* Executes whole instructions until at least the cycles have passed, the CPU halts or stops */
+i8080_stop_reason i8080_run(i8080_machine* machine, uint64_t cycles);
+
+/*
+ * Runs every machine for the cycles, one after the other, and stores why each stopped. For hosts
+ * stepping many machines in lockstep, at one call for all of them.
+ */
+int i8080_run_many(i8080_machine* const* machines,
+                   size_t count,
+                   uint64_t cycles,
+                   i8080_stop_reason* reasons);
+
+/* Ends the current run after the instruction executing */
+void i8080_stop(i8080_machine* machine);
+
+/* Raises RST n for n up to 7, which is dropped while the guest has interrupts disabled. A halted
+ * CPU wakes and takes it right away. */
+int i8080_interrupt(i8080_machine* machine, uint8_t rst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,33 @@
+# i8080_recompile(<target> <rom> NAME <symbol> [ORIGIN <address>] [ENTRY_POINTS <address>...])
+#
+# Translates a .com image into C++ at build time and adds it to the target's sources. The source
+# defines `const i8080::NativeProgram <symbol>`, to hand to Cpu::set_native_code() once memory
+# holds the image. Only for programs that never modify their own code.
+function(i8080_recompile TARGET ROM)
+    cmake_parse_arguments(PARSE_ARGV 2 ARG "" "NAME;ORIGIN" "ENTRY_POINTS")
+
+    if(NOT ARG_NAME)
+        message(FATAL_ERROR "i8080_recompile(${TARGET}) needs a NAME")
+    endif()
+
+    set(OPTIONS)
+    if(ARG_ORIGIN)
+        list(APPEND OPTIONS --origin ${ARG_ORIGIN})
+    endif()
+
+    foreach(ENTRY_POINT ${ARG_ENTRY_POINTS})
+        list(APPEND OPTIONS --entry ${ENTRY_POINT})
+    endforeach()
+
+    set(OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/${ARG_NAME}.cpp)
+
+    add_custom_command(
+        OUTPUT ${OUTPUT}
+        COMMAND recompile ${ROM} ${OUTPUT} ${ARG_NAME} ${OPTIONS}
+        DEPENDS recompile ${ROM}
+        COMMENT "Recompiling ${ROM}"
+        VERBATIM
+    )
+
+    target_sources(${TARGET} PRIVATE ${OUTPUT})
+endfunction()
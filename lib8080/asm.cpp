@@ -2,6 +2,8 @@
 
 #include <fmt/core.h>
 
+#include <iterator>
+
 namespace i8080
 {
 enum class OperandType : uint8_t
@@ -21,23 +23,98 @@ Instruction isr_to_rst(uint8_t isr_number)
     return static_cast<Instruction>((isr_number * 8) + static_cast<uint8_t>(Instruction::RST_0));
 }
 
+ControlFlow get_control_flow(Instruction instruction)
+{
+    switch (instruction) {
+    case Instruction::JMP:
+    case Instruction::JNZ:
+    case Instruction::JZ:
+    case Instruction::JNC:
+    case Instruction::JC:
+    case Instruction::JPO:
+    case Instruction::JPE:
+    case Instruction::JP:
+    case Instruction::JM:
+    case Instruction::NOP6:
+        return ControlFlow::jump;
+    case Instruction::CALL:
+    case Instruction::CNZ:
+    case Instruction::CZ:
+    case Instruction::CNC:
+    case Instruction::CC:
+    case Instruction::CPO:
+    case Instruction::CPE:
+    case Instruction::CP:
+    case Instruction::CM:
+    case Instruction::RST_0:
+    case Instruction::RST_1:
+    case Instruction::RST_2:
+    case Instruction::RST_3:
+    case Instruction::RST_4:
+    case Instruction::RST_5:
+    case Instruction::RST_6:
+    case Instruction::RST_7:
+    case Instruction::NOP8:
+    case Instruction::NOP9:
+    case Instruction::NOP10:
+        return ControlFlow::call;
+    case Instruction::RET:
+    case Instruction::RNZ:
+    case Instruction::RZ:
+    case Instruction::RNC:
+    case Instruction::RC:
+    case Instruction::RPO:
+    case Instruction::RPE:
+    case Instruction::RP:
+    case Instruction::RM:
+    case Instruction::NOP7:
+        return ControlFlow::ret;
+    case Instruction::PCHL:
+        return ControlFlow::pchl;
+    case Instruction::HLT:
+        return ControlFlow::halt;
+    default:
+        return ControlFlow::next;
+    }
+}
+
+bool is_branch(Instruction instruction)
+{
+    return get_control_flow(instruction) != ControlFlow::next;
+}
+
+bool is_conditional(Instruction instruction)
+{
+    // Rcc, Jcc and Ccc, with the condition in bits 3-5
+    uint8_t group = static_cast<uint8_t>(instruction) & 0xc7;
+    return group == 0xc0 || group == 0xc2 || group == 0xc4;
+}
+
 void print_dissassembly(const Opcode& opcode, uint16_t pc)
+{
+    fmt::memory_buffer out;
+    format_dissassembly(out, opcode, pc);
+    fmt::print("{}", fmt::to_string(out));
+}
+
+void format_dissassembly(fmt::memory_buffer& out, const Opcode& opcode, uint16_t pc)
 {
     const OpcodeMetadata& metadata = get_opcode_metadata(opcode.instruction);
-    fmt::print("{:#06x}    {}", pc, metadata.name);
+    auto it = std::back_inserter(out);
+    fmt::format_to(it, "{:#06x}    {}", pc, metadata.name);
 
     switch (static_cast<OperandType>(metadata.size)) {
     case OperandType::word:
-        fmt::print(" {:#06x}", opcode.u16operand);
+        fmt::format_to(it, " {:#06x}", opcode.u16operand);
         break;
     case OperandType::byte:
-        fmt::print(" {:#06x}", (opcode.u8operand & 0xff));
+        fmt::format_to(it, " {:#06x}", (opcode.u8operand & 0xff));
         break;
     default:
         break;
     }
 
-    fmt::println("");
+    out.push_back('\n');
 }
 
 const OpcodeMetadata& get_opcode_metadata(Instruction instruction)
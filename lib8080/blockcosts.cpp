@@ -0,0 +1,97 @@
+#include "blockcosts.h"
+#include "asm.h"
+
+namespace i8080
+{
+static bool ends_block(Instruction instruction)
+{
+    return is_branch(instruction) || instruction == Instruction::OUT ||
+           instruction == Instruction::IN;
+}
+
+const BlockCosts::Entries BlockCosts::UNMEASURED = {};
+
+BlockCosts::BlockCosts(Bus& bus) :
+    _bus(bus)
+{
+    bus.set_block_costs(this);
+}
+
+BlockCosts::~BlockCosts()
+{
+    _bus.get().set_block_costs(nullptr);
+}
+
+void BlockCosts::set_volatile(uint8_t page)
+{
+    // Nothing is measured on it anymore, so writes to it need not be reported
+    _pages[page].is_volatile = true;
+    _bus.get().clear_page_flags(page, Bus::page_code);
+}
+
+void BlockCosts::written_all()
+{
+    for (Page& page : _pages) {
+        page.generation++;
+        page.code.reset();
+        page.is_volatile = false;
+    }
+}
+
+BlockCosts::Block BlockCosts::_measure(uint16_t address)
+{
+    uint8_t index = address / Bus::PAGE_SIZE;
+    Page& page = _pages[index];
+    uint32_t page_end = (index + 1) * Bus::PAGE_SIZE;
+
+    if (!_entries[index]) {
+        _entries[index] = std::make_unique<Entries>();
+        page.entries = _entries[index].get();
+    }
+
+    Entries& entries = *_entries[index];
+
+    // Stays for when nothing fits or the page is volatile
+    Block rest = { .cycles = 0, .instructions = 0 };
+    entries[address % Bus::PAGE_SIZE] = { .block = rest, .generation = page.generation };
+    if (page.is_volatile) {
+        return rest;
+    }
+
+    // Walk to the end of the block, then give every instruction in it the rest of the block, so
+    // a jump into the middle finds its block measured too
+    std::array<uint16_t, Bus::PAGE_SIZE> starts;
+    std::array<uint8_t, Bus::PAGE_SIZE> cycles;
+    size_t count = 0;
+
+    for (uint32_t pc = address; pc < page_end;) {
+        auto instruction = static_cast<Instruction>(_bus.get().mem_read_u8_ref(pc));
+        const OpcodeMetadata& metadata = get_opcode_metadata(instruction);
+        if (pc + metadata.size > page_end) {
+            break;
+        }
+
+        starts[count] = pc;
+        cycles[count] = metadata.cycles;
+        count++;
+
+        for (uint8_t i = 0; i < metadata.size; i++, pc++) {
+            page.code.set(pc % Bus::PAGE_SIZE);
+        }
+
+        if (ends_block(instruction)) {
+            break;
+        }
+    }
+
+    for (size_t i = count; i > 0; i--) {
+        rest.cycles += cycles[i - 1];
+        rest.instructions++;
+        entries[starts[i - 1] % Bus::PAGE_SIZE] = { .block = rest, .generation = page.generation };
+    }
+
+    _bus.get().set_page_flags(index, Bus::page_code);
+
+    return rest;
+}
+} // namespace i8080
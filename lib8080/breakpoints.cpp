@@ -0,0 +1,375 @@
+#include "breakpoints.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <utility>
+
+namespace i8080
+{
+using Evaluator = Condition::Evaluator;
+using Context = Condition::Context;
+
+// Recursive descent over the source, building a closure per node
+class ConditionParser final
+{
+public:
+    explicit ConditionParser(std::string_view source) :
+        _source(source),
+        _position(0)
+    {}
+
+    Evaluator parse()
+    {
+        Evaluator expression = _or();
+        _skip_spaces();
+        if (_position != _source.size()) {
+            _fail("unexpected input");
+        }
+
+        return expression;
+    }
+
+private:
+    using Binary = int64_t (*)(int64_t, int64_t);
+
+    [[noreturn]] void _fail(std::string_view message) const
+    {
+        throw std::runtime_error(
+            fmt::format("Bad condition '{}': {} at column {}", _source, message, _position + 1));
+    }
+
+    void _skip_spaces()
+    {
+        while (_position < _source.size() &&
+               std::isspace(static_cast<unsigned char>(_source[_position]))) {
+            _position++;
+        }
+    }
+
+    bool _accept(std::string_view token)
+    {
+        _skip_spaces();
+        if (_source.substr(_position, token.size()) != token) {
+            return false;
+        }
+
+        _position += token.size();
+        return true;
+    }
+
+    void _expect(std::string_view token)
+    {
+        if (!_accept(token)) {
+            _fail(fmt::format("expected '{}'", token));
+        }
+    }
+
+    static Evaluator _combine(Evaluator left, Evaluator right, Binary operation)
+    {
+        return [left = std::move(left), right = std::move(right), operation](const Context& c) {
+            return operation(left(c), right(c));
+        };
+    }
+
+    Evaluator _or()
+    {
+        Evaluator left = _and();
+        while (_accept("||")) {
+            Evaluator right = _and();
+            left = [left = std::move(left), right = std::move(right)](const Context& c) {
+                return static_cast<int64_t>(left(c) || right(c));
+            };
+        }
+
+        return left;
+    }
+
+    Evaluator _and()
+    {
+        Evaluator left = _comparison();
+        while (_accept("&&")) {
+            Evaluator right = _comparison();
+            left = [left = std::move(left), right = std::move(right)](const Context& c) {
+                return static_cast<int64_t>(left(c) && right(c));
+            };
+        }
+
+        return left;
+    }
+
+    Evaluator _comparison()
+    {
+        static constexpr std::array<std::pair<std::string_view, Binary>, 6> OPERATORS = { {
+            { "==", [](int64_t a, int64_t b) -> int64_t { return a == b; } },
+            { "!=", [](int64_t a, int64_t b) -> int64_t { return a != b; } },
+            { "<=", [](int64_t a, int64_t b) -> int64_t { return a <= b; } },
+            { ">=", [](int64_t a, int64_t b) -> int64_t { return a >= b; } },
+            { "<", [](int64_t a, int64_t b) -> int64_t { return a < b; } },
+            { ">", [](int64_t a, int64_t b) -> int64_t { return a > b; } },
+        } };
+
+        Evaluator left = _arithmetic();
+        for (const auto& [token, operation] : OPERATORS) {
+            if (_accept(token)) {
+                return _combine(std::move(left), _arithmetic(), operation);
+            }
+        }
+
+        return left;
+    }
+
+    Evaluator _arithmetic()
+    {
+        Evaluator left = _unary();
+        while (true) {
+            _skip_spaces();
+            std::string_view rest = _source.substr(_position);
+
+            Binary operation = nullptr;
+            if (rest.starts_with("+")) {
+                operation = [](int64_t a, int64_t b) { return a + b; };
+            } else if (rest.starts_with("-")) {
+                operation = [](int64_t a, int64_t b) { return a - b; };
+            } else if (rest.starts_with("&") && !rest.starts_with("&&")) {
+                operation = [](int64_t a, int64_t b) { return a & b; };
+            } else if (rest.starts_with("|") && !rest.starts_with("||")) {
+                operation = [](int64_t a, int64_t b) { return a | b; };
+            } else if (rest.starts_with("^")) {
+                operation = [](int64_t a, int64_t b) { return a ^ b; };
+            } else {
+                return left;
+            }
+
+            _position++;
+            left = _combine(std::move(left), _unary(), operation);
+        }
+    }
+
+    Evaluator _unary()
+    {
+        if (_accept("!")) {
+            return [operand = _unary()](const Context& c) -> int64_t { return !operand(c); };
+        }
+
+        if (_accept("-")) {
+            return [operand = _unary()](const Context& c) { return -operand(c); };
+        }
+
+        return _primary();
+    }
+
+    Evaluator _primary()
+    {
+        if (_accept("(")) {
+            Evaluator inner = _or();
+            _expect(")");
+            return inner;
+        }
+
+        if (_accept("[")) {
+            Evaluator address = _or();
+            _expect("]");
+            return [address = std::move(address)](const Context& c) -> int64_t {
+                return c.bus.mem_read_u8_ref(static_cast<uint16_t>(address(c)));
+            };
+        }
+
+        _skip_spaces();
+        size_t start = _position;
+        while (_position < _source.size() &&
+               std::isalnum(static_cast<unsigned char>(_source[_position]))) {
+            _position++;
+        }
+
+        std::string_view word = _source.substr(start, _position - start);
+        if (word.empty()) {
+            _fail("expected an operand");
+        }
+
+        if (std::isdigit(static_cast<unsigned char>(word.front()))) {
+            return _number(word);
+        }
+
+        return _name(word);
+    }
+
+    Evaluator _number(std::string_view word)
+    {
+        int64_t number = 0;
+        try {
+            size_t used = 0;
+            number = std::stoll(std::string(word), &used, 0);
+            if (used != word.size()) {
+                _fail("bad number");
+            }
+        } catch (const std::logic_error&) {
+            _fail("bad number");
+        }
+
+        return [number](const Context&) { return number; };
+    }
+
+    Evaluator _name(std::string_view word)
+    {
+        using Getter = int64_t (*)(const Context&);
+        static constexpr std::array<std::pair<std::string_view, Getter>, 19> NAMES = { {
+            { "a", [](const Context& c) -> int64_t { return c.state.a; } },
+            { "b", [](const Context& c) -> int64_t { return c.state.b; } },
+            { "c", [](const Context& c) -> int64_t { return c.state.c; } },
+            { "d", [](const Context& c) -> int64_t { return c.state.d; } },
+            { "e", [](const Context& c) -> int64_t { return c.state.e; } },
+            { "h", [](const Context& c) -> int64_t { return c.state.h; } },
+            { "l", [](const Context& c) -> int64_t { return c.state.l; } },
+            { "bc", [](const Context& c) -> int64_t { return c.state.bc; } },
+            { "de", [](const Context& c) -> int64_t { return c.state.de; } },
+            { "hl", [](const Context& c) -> int64_t { return c.state.hl; } },
+            { "sp", [](const Context& c) -> int64_t { return c.state.sp; } },
+            { "pc", [](const Context& c) -> int64_t { return c.state.pc; } },
+            { "zero", [](const Context& c) -> int64_t { return c.state.flags.zero; } },
+            { "carry", [](const Context& c) -> int64_t { return c.state.flags.carry; } },
+            { "sign", [](const Context& c) -> int64_t { return c.state.flags.sign; } },
+            { "parity", [](const Context& c) -> int64_t { return c.state.flags.parity; } },
+            { "aux", [](const Context& c) -> int64_t { return c.state.flags.aux; } },
+            { "value", [](const Context& c) -> int64_t { return c.value; } },
+            { "cycle", [](const Context& c) -> int64_t { return c.state.cycle; } },
+        } };
+
+        auto it = std::ranges::find(NAMES, word, &std::pair<std::string_view, Getter>::first);
+        if (it == NAMES.end()) {
+            _fail(fmt::format("unknown name '{}'", word));
+        }
+
+        return it->second;
+    }
+
+    std::string_view _source;
+    size_t _position;
+};
+
+Condition::Condition(std::string_view source) :
+    _source(source),
+    _evaluate(ConditionParser(source).parse())
+{}
+
+Breakpoints::Breakpoints(Cpu& cpu, Bus& bus) :
+    _cpu(cpu),
+    _bus(bus)
+{
+    cpu.set_breakpoints(this);
+    bus.set_breakpoints(this);
+}
+
+Breakpoints::~Breakpoints()
+{
+    clear();
+    _cpu.get().set_breakpoints(nullptr);
+    _bus.get().set_breakpoints(nullptr);
+}
+
+void Breakpoints::add_breakpoint(uint16_t address, std::optional<Condition> condition)
+{
+    auto [it, added] = _breakpoints.insert_or_assign(address, std::move(condition));
+    if (added) {
+        _page_breakpoints[address / Bus::PAGE_SIZE]++;
+    }
+}
+
+void Breakpoints::remove_breakpoint(uint16_t address)
+{
+    if (_breakpoints.erase(address)) {
+        _page_breakpoints[address / Bus::PAGE_SIZE]--;
+    }
+}
+
+void Breakpoints::add_watchpoint(uint16_t first,
+                                 uint16_t last,
+                                 Access access,
+                                 std::optional<Condition> condition)
+{
+    _watchpoints.push_back({ .first = first,
+                             .last = last,
+                             .access = access,
+                             .condition = std::move(condition) });
+    _update_watched_pages();
+}
+
+void Breakpoints::remove_watchpoint(uint16_t first, uint16_t last)
+{
+    std::erase_if(_watchpoints, [first, last](const Watchpoint& watchpoint) {
+        return watchpoint.first == first && watchpoint.last == last;
+    });
+
+    _update_watched_pages();
+}
+
+void Breakpoints::clear()
+{
+    _breakpoints.clear();
+    _page_breakpoints.fill(0);
+    _watchpoints.clear();
+    _update_watched_pages();
+}
+
+void Breakpoints::_update_watched_pages()
+{
+    Bus& bus = _bus.get();
+    for (size_t page = 0; page < Bus::PAGE_COUNT; page++) {
+        bus.clear_page_flags(page, Bus::page_watched);
+    }
+
+    for (const Watchpoint& watchpoint : _watchpoints) {
+        for (uint32_t page = watchpoint.first / Bus::PAGE_SIZE;
+             page <= watchpoint.last / Bus::PAGE_SIZE;
+             page++) {
+            bus.set_page_flags(page, Bus::page_watched);
+        }
+    }
+}
+
+bool Breakpoints::hit(const Cpu::State& state)
+{
+    auto it = _breakpoints.find(state.pc);
+    if (it == _breakpoints.end()) {
+        return false;
+    }
+
+    if (it->second && !(*it->second)({ .state = state, .bus = _bus.get(), .value = 0 })) {
+        return false;
+    }
+
+    _last_hit = Hit { .kind = Hit::Kind::breakpoint,
+                      .address = state.pc,
+                      .value = 0,
+                      .pc = state.pc,
+                      .cycle = state.cycle };
+    return true;
+}
+
+void Breakpoints::watch(Access access, uint16_t address, uint8_t value)
+{
+    const Cpu::State& state = _cpu.get().state();
+
+    for (const Watchpoint& watchpoint : _watchpoints) {
+        if (address < watchpoint.first || address > watchpoint.last ||
+            !(static_cast<uint8_t>(watchpoint.access) & static_cast<uint8_t>(access))) {
+            continue;
+        }
+
+        if (watchpoint.condition &&
+            !(*watchpoint.condition)({ .state = state, .bus = _bus.get(), .value = value })) {
+            continue;
+        }
+
+        _last_hit = Hit { .kind = (access == Access::read) ? Hit::Kind::read : Hit::Kind::write,
+                          .address = address,
+                          .value = value,
+                          .pc = state.pc,
+                          .cycle = state.cycle };
+        _cpu.get().stop();
+        return;
+    }
+}
+} // namespace i8080
@@ -1,10 +1,35 @@
 #include "bus.h"
+#include "blockcosts.h"
+#include "breakpoints.h"
+#include "heatmap.h"
+#include "metrics.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
 
 namespace i8080
 {
+Bus::Bus(std::span<uint8_t> memory) :
+    _memory(memory)
+{
+    if (memory.size() < MEMORY_SIZE) {
+        throw std::runtime_error(fmt::format(
+            "Memory of {} bytes is smaller than the {} a bus needs", memory.size(), MEMORY_SIZE));
+    }
+
+    sync_mirror();
+}
+
 const Opcode& Bus::fetch(uint16_t pc) const
 {
-    return *reinterpret_cast<const Opcode*>(padd(_memory.get().data(), pc));
+    if (_heatmap) [[unlikely]] {
+        _heatmap->record(MemoryHeatmap::Access::fetch, pc);
+    }
+
+    return *reinterpret_cast<const Opcode*>(padd(_memory.data(), pc));
 }
 
 void Bus::register_device(uint8_t id, Device::sptr device)
@@ -14,6 +39,10 @@ void Bus::register_device(uint8_t id, Device::sptr device)
 
 void Bus::write(uint8_t device, uint8_t byte)
 {
+    if (_metrics) {
+        _metrics->add_port_write(device);
+    }
+
     if (_devices[device]) {
         _devices[device]->write(byte);
     }
@@ -21,6 +50,10 @@ void Bus::write(uint8_t device, uint8_t byte)
 
 void Bus::read(uint8_t device, uint8_t& byte)
 {
+    if (_metrics) {
+        _metrics->add_port_read(device);
+    }
+
     if (_devices[device]) {
         _devices[device]->read(byte);
     }
@@ -28,26 +61,151 @@ void Bus::read(uint8_t device, uint8_t& byte)
 
 void Bus::mem_write(uint16_t address, uint8_t byte)
 {
-    _memory.get()[address] = byte;
+    if (_journal) [[unlikely]] {
+        _journal->push_back({ address, byte });
+    }
+
+    if (_page_flags[_page(address)]) [[unlikely]] {
+        _store(address, byte);
+        return;
+    }
+
+    // Stores twice rather than branch, the second store lands on the same byte unless mirrored
+    _memory[address] = byte;
+    _memory[_mirror(address)] = byte;
 }
 
 void Bus::mem_write(uint16_t address, uint16_t word)
 {
-    *reinterpret_cast<uint16_t*>(padd(_memory.get().data(), address)) = word;
+    if (_journal) [[unlikely]] {
+        _journal->push_back({ address, static_cast<uint8_t>(word & 0xff) });
+        _journal->push_back(
+            { static_cast<uint16_t>(address + 1), static_cast<uint8_t>(word >> 8) });
+    }
+
+    if (_page_flags[_page(address)] | _page_flags[_page(address + 1)]) [[unlikely]] {
+        _store(address, word & 0xff);
+        _store(address + 1, word >> 8);
+        return;
+    }
+
+    uint16_t next = address + 1;
+    _memory[address] = word & 0xff;
+    _memory[next] = word >> 8;
+    _memory[_mirror(address)] = word & 0xff;
+    _memory[_mirror(next)] = word >> 8;
 }
 
 void Bus::mem_read(uint16_t address, uint8_t& byte)
 {
-    byte = _memory.get()[address];
+    if (_page_flags[_page(address)] & READ_FLAGS) [[unlikely]] {
+        byte = _load(address);
+        return;
+    }
+
+    byte = _memory[address];
 }
 
 void Bus::mem_read(uint16_t address, uint16_t& word)
 {
-    word = *reinterpret_cast<uint16_t*>(padd(_memory.get().data(), address));
+    if ((_page_flags[_page(address)] | _page_flags[_page(address + 1)]) & READ_FLAGS) [[unlikely]] {
+        word = _load(address) | (_load(address + 1) << 8);
+        return;
+    }
+
+    word = *reinterpret_cast<uint16_t*>(padd(_memory.data(), address));
 }
 
 uint8_t& Bus::mem_read_u8_ref(uint16_t address)
 {
-    return _memory.get()[address];
+    return _memory[address];
+}
+
+void Bus::sync_mirror()
+{
+    std::copy_n(_memory.begin(), MIRROR_SIZE, _memory.begin() + ADDRESS_SPACE_SIZE);
+
+    if (_block_costs) {
+        _block_costs->written_all();
+    }
+}
+
+void Bus::set_heatmap(MemoryHeatmap* heatmap)
+{
+    _heatmap = heatmap;
+    for (size_t page = 0; page < PAGE_COUNT; page++) {
+        if (heatmap) {
+            set_page_flags(page, page_counted);
+        } else {
+            clear_page_flags(page, page_counted);
+        }
+    }
+}
+
+void Bus::set_breakpoints(Breakpoints* breakpoints)
+{
+    _breakpoints = breakpoints;
+    if (!breakpoints) {
+        _clear_all_pages(page_watched);
+    }
+}
+
+void Bus::set_block_costs(BlockCosts* block_costs)
+{
+    _block_costs = block_costs;
+    if (!block_costs) {
+        _clear_all_pages(page_code);
+    }
+}
+
+void Bus::_clear_all_pages(uint8_t flags)
+{
+    for (size_t page = 0; page < PAGE_COUNT; page++) {
+        clear_page_flags(page, flags);
+    }
+}
+
+uint8_t Bus::_load(uint16_t address) const
+{
+    uint8_t& byte = _memory[address];
+    if (_page_flags[_page(address)] & page_counted) {
+        _heatmap->record(MemoryHeatmap::Access::read, address);
+    }
+
+    uint8_t value = (_page_flags[_page(address)] & page_shared)
+                        ? std::atomic_ref(byte).load(std::memory_order_acquire)
+                        : byte;
+
+    if (_page_flags[_page(address)] & page_watched) {
+        _breakpoints->watch(Breakpoints::Access::read, address, value);
+    }
+
+    return value;
+}
+
+void Bus::_store(uint16_t address, uint8_t byte)
+{
+    uint8_t& target = _memory[address];
+    if (_page_flags[_page(address)] & page_counted) {
+        _heatmap->record(MemoryHeatmap::Access::write, address);
+    }
+
+    // Before the store, so conditions can still read the old byte
+    if (_page_flags[_page(address)] & page_watched) {
+        _breakpoints->watch(Breakpoints::Access::write, address, byte);
+    }
+
+    if (_page_flags[_page(address)] & page_code) {
+        _block_costs->written(address);
+    }
+
+    if (_page_flags[_page(address)] & page_shared) {
+        std::atomic_ref(target).store(byte, std::memory_order_release);
+        std::atomic_ref(_memory[_mirror(address)]).store(byte, std::memory_order_release);
+        return;
+    }
+
+    target = byte;
+    _memory[_mirror(address)] = byte;
 }
 } // namespace i8080
@@ -0,0 +1,189 @@
+#include "callgraph.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+namespace i8080
+{
+CallGraph::CallGraph(const Cpu::State& state)
+{
+    _stack.push_back(
+        { .function = state.pc, .sp = ROOT_SP, .entry_cycle = state.cycle, .children = 0 });
+    _active[state.pc]++;
+    _functions[state.pc].calls++;
+}
+
+void CallGraph::observe(Instruction instruction, uint16_t previous_sp, const Cpu::State& state)
+{
+    if (_stack.empty()) {
+        return;
+    }
+
+    // Conditional calls and returns that were not taken leave the SP alone
+    if (get_control_flow(instruction) == ControlFlow::call && state.sp == static_cast<uint16_t>(previous_sp - 2)) {
+        _push(state.pc, state.sp, state.cycle);
+    } else if (get_control_flow(instruction) == ControlFlow::ret && state.sp == static_cast<uint16_t>(previous_sp + 2)) {
+        // Returning through a slot below the top frame is a jump through a pushed address, one
+        // above it also closes the frames whose return addresses were dropped
+        if (previous_sp >= _stack.back().sp) {
+            _unwind_to(previous_sp, state.cycle);
+        }
+    }
+}
+
+void CallGraph::interrupt(uint16_t vector, const Cpu::State& state)
+{
+    if (!_stack.empty()) {
+        _push(vector, state.sp, state.cycle);
+    }
+}
+
+void CallGraph::finish(uint64_t cycle)
+{
+    while (!_stack.empty()) {
+        _pop(cycle);
+    }
+}
+
+void CallGraph::frames(std::vector<uint16_t>& frames) const
+{
+    for (const Frame& frame : _stack) {
+        frames.push_back(frame.function);
+    }
+}
+
+void CallGraph::_push(uint16_t function, uint16_t sp, uint64_t cycle)
+{
+    // Frames whose return slot is at or below the new one were abandoned without a RET
+    _unwind_to(sp, cycle);
+
+    _functions[function].calls++;
+    _arcs[{ _stack.back().function, function }].calls++;
+    _active[function]++;
+    _stack.push_back({ .function = function, .sp = sp, .entry_cycle = cycle, .children = 0 });
+}
+
+void CallGraph::_pop(uint64_t cycle)
+{
+    Frame frame = _stack.back();
+    _stack.pop_back();
+
+    uint64_t inclusive = cycle - frame.entry_cycle;
+    Function& function = _functions[frame.function];
+    function.exclusive += inclusive - frame.children;
+
+    if (--_active[frame.function] == 0) {
+        function.inclusive += inclusive;
+    }
+
+    if (!_stack.empty()) {
+        _stack.back().children += inclusive;
+        _arcs[{ _stack.back().function, frame.function }].inclusive += inclusive;
+    }
+}
+
+void CallGraph::_unwind_to(uint32_t sp, uint64_t cycle)
+{
+    // The root sits above every address and is only closed by finish()
+    while (_stack.size() > 1 && _stack.back().sp <= sp) {
+        _pop(cycle);
+    }
+}
+
+std::string CallGraph::report(const SymbolTable& symbols) const
+{
+    std::vector<uint16_t> order;
+    for (const auto& [address, function] : _functions) {
+        order.push_back(address);
+    }
+
+    std::ranges::sort(order, [this](uint16_t a, uint16_t b) {
+        uint64_t inclusive_a = _functions.at(a).inclusive;
+        uint64_t inclusive_b = _functions.at(b).inclusive;
+        return (inclusive_a != inclusive_b) ? (inclusive_a > inclusive_b) : (a < b);
+    });
+
+    fmt::memory_buffer out;
+    auto it = std::back_inserter(out);
+
+    fmt::format_to(it, "{:>14} {:>14} {:>10}  {}\n", "inclusive", "exclusive", "calls", "function");
+
+    for (uint16_t address : order) {
+        const Function& function = _functions.at(address);
+        fmt::format_to(it,
+                       "{:>14} {:>14} {:>10}  {}\n",
+                       function.inclusive,
+                       function.exclusive,
+                       function.calls,
+                       symbols.describe(address));
+
+        for (const auto& [key, arc] : _arcs) {
+            if (key.second == address) {
+                fmt::format_to(it,
+                               "{:>41}  <- {} ({} calls)\n",
+                               "",
+                               symbols.describe(key.first),
+                               arc.calls);
+            }
+        }
+
+        for (const auto& [key, arc] : _arcs) {
+            if (key.first == address) {
+                fmt::format_to(it,
+                               "{:>41}  -> {} ({} calls, {} cycles)\n",
+                               "",
+                               symbols.describe(key.second),
+                               arc.calls,
+                               arc.inclusive);
+            }
+        }
+    }
+
+    return fmt::to_string(out);
+}
+
+std::string CallGraph::callgrind(const SymbolTable& symbols) const
+{
+    fmt::memory_buffer out;
+    auto it = std::back_inserter(out);
+
+    fmt::format_to(it, "# callgrind format\nversion: 1\ncreator: i8080\n");
+    fmt::format_to(it, "positions: line\nevents: Cycles\n");
+
+    // Names are spelled out the first time and referred to by id afterwards. Ids start at 1.
+    std::set<uint16_t> named;
+    auto name = [&](uint16_t address) {
+        if (named.insert(address).second) {
+            return fmt::format("({}) {}", address + 1, symbols.describe(address));
+        }
+
+        return fmt::format("({})", address + 1);
+    };
+
+    std::vector<uint16_t> order;
+    for (const auto& [address, function] : _functions) {
+        order.push_back(address);
+    }
+
+    std::ranges::sort(order);
+
+    for (uint16_t address : order) {
+        fmt::format_to(it, "\nfn={}\n0 {}\n", name(address), _functions.at(address).exclusive);
+
+        for (const auto& [key, arc] : _arcs) {
+            if (key.first == address) {
+                fmt::format_to(it,
+                               "cfn={}\ncalls={} 0\n0 {}\n",
+                               name(key.second),
+                               arc.calls,
+                               arc.inclusive);
+            }
+        }
+    }
+
+    return fmt::to_string(out);
+}
+} // namespace i8080
@@ -0,0 +1,222 @@
+#include "cosim.h"
+#include "asm.h"
+
+#include <fmt/format.h>
+
+#include <iterator>
+#include <random>
+
+namespace i8080
+{
+static constexpr uint32_t INTERRUPT_ONE_IN = 1000;
+
+CoSimulator::Memory::Memory(const buffer& image) :
+    bytes(image),
+    bus(bytes)
+{
+    bus.set_write_journal(&journal);
+}
+
+CoSimulator::CoSimulator(const buffer& image,
+                         const Cpu::State& initial_state,
+                         Cpu::Timing timing,
+                         Cpu::NativeCode native_code) :
+    _reference_memory(image),
+    _reference(_reference_memory.bus, initial_state),
+    _candidate_memory(image),
+    _candidate(_candidate_memory.bus, initial_state.pc, timing),
+    _compare_cycles(timing == Cpu::Timing::exact),
+    _steps(0)
+{
+    _candidate.set_state(initial_state);
+    _candidate.set_native_code(native_code);
+}
+
+std::optional<CoSimulator::Divergence> CoSimulator::step(Granularity granularity)
+{
+    uint16_t pc = _reference.state().pc;
+    _reference_memory.journal.clear();
+    _candidate_memory.journal.clear();
+
+    uint64_t retired = _candidate.retired();
+    if (granularity == Granularity::instruction) {
+        _candidate.tick();
+    } else {
+        _candidate.run(1);
+    }
+
+    for (retired = _candidate.retired() - retired; retired > 0; retired--) {
+        _reference.step();
+    }
+
+    std::string description;
+    _compare_states(_reference.state(), _candidate.state(), _compare_cycles, description);
+    _compare_journals(_reference_memory.journal, _candidate_memory.journal, description);
+
+    uint64_t step = _steps++;
+    if (description.empty()) {
+        return std::nullopt;
+    }
+
+    return Divergence { .step = step, .pc = pc, .description = std::move(description) };
+}
+
+std::optional<CoSimulator::Divergence> CoSimulator::run(uint64_t steps, Granularity granularity)
+{
+    for (uint64_t i = 0; i < steps && !_reference.halt(); i++) {
+        if (auto divergence = step(granularity)) {
+            return divergence;
+        }
+    }
+
+    return std::nullopt;
+}
+
+void CoSimulator::interrupt(uint8_t isr_number)
+{
+    _reference.interrupt(isr_number);
+    _candidate.interrupt(isr_number);
+}
+
+void CoSimulator::_compare_states(const Cpu::State& reference,
+                                  const Cpu::State& candidate,
+                                  bool compare_cycles,
+                                  std::string& description)
+{
+    auto out = std::back_inserter(description);
+    auto compare = [&out](std::string_view name, auto expected, auto actual) {
+        if (expected != actual) {
+            fmt::format_to(out, "{}: expected {:#x}, got {:#x}\n", name, expected, actual);
+        }
+    };
+
+    compare("a", reference.a, candidate.a);
+    compare("flags", reference.flags.status, candidate.flags.status);
+    compare("b", reference.b, candidate.b);
+    compare("c", reference.c, candidate.c);
+    compare("d", reference.d, candidate.d);
+    compare("e", reference.e, candidate.e);
+    compare("h", reference.h, candidate.h);
+    compare("l", reference.l, candidate.l);
+    compare("sp", reference.sp, candidate.sp);
+    compare("pc", reference.pc, candidate.pc);
+    if (compare_cycles) {
+        compare("cycle", reference.cycle, candidate.cycle);
+    }
+
+    compare("halt", static_cast<uint8_t>(reference.halt), static_cast<uint8_t>(candidate.halt));
+    compare("interrupts_enabled",
+            static_cast<uint8_t>(reference.interrupts_enabled),
+            static_cast<uint8_t>(candidate.interrupts_enabled));
+
+    if (reference.interrupt_vector != candidate.interrupt_vector) {
+        fmt::format_to(out,
+                       "interrupt_vector: expected {}, got {}\n",
+                       reference.interrupt_vector
+                           ? get_opcode_metadata(*reference.interrupt_vector).name
+                           : "none",
+                       candidate.interrupt_vector
+                           ? get_opcode_metadata(*candidate.interrupt_vector).name
+                           : "none");
+    }
+}
+
+void CoSimulator::_compare_journals(const WriteJournal& reference,
+                                    const WriteJournal& candidate,
+                                    std::string& description)
+{
+    auto out = std::back_inserter(description);
+    size_t common = std::min(reference.size(), candidate.size());
+
+    for (size_t i = 0; i < common; i++) {
+        if (reference[i] != candidate[i]) {
+            fmt::format_to(out,
+                           "write #{}: expected [{:#06x}] = {:#04x}, got [{:#06x}] = {:#04x}\n",
+                           i,
+                           reference[i].address,
+                           reference[i].value,
+                           candidate[i].address,
+                           candidate[i].value);
+            return;
+        }
+    }
+
+    if (reference.size() != candidate.size()) {
+        fmt::format_to(out,
+                       "writes: expected {}, got {}\n",
+                       reference.size(),
+                       candidate.size());
+    }
+}
+
+RandomScenario make_random_scenario(uint64_t seed)
+{
+    std::mt19937_64 engine(seed);
+    std::uniform_int_distribution<uint16_t> word;
+    std::uniform_int_distribution<uint16_t> byte(0, 0xff);
+
+    // Keep HLT out of the image entirely, operands included, since jumps may land in the middle
+    // of an instruction. Otherwise a scenario ends on its first HLT.
+    auto random_byte = [&]() {
+        for (;;) {
+            auto value = static_cast<uint8_t>(byte(engine));
+            if (static_cast<Instruction>(value) != Instruction::HLT) {
+                return value;
+            }
+        }
+    };
+
+    RandomScenario scenario { .image = buffer(Bus::MEMORY_SIZE), .state = {} };
+
+    for (size_t address = 0; address < 0x10000;) {
+        auto instruction = static_cast<Instruction>(random_byte());
+
+        scenario.image[address++] = static_cast<uint8_t>(instruction);
+        for (uint8_t i = 1; i < get_opcode_metadata(instruction).size; i++) {
+            scenario.image[address++] = random_byte();
+        }
+    }
+
+    Cpu::State& state = scenario.state;
+    state.af = word(engine);
+    // Bits 3 and 5 of the flags always read as clear and bit 1 as set
+    state.flags.status = (state.flags.status & 0xd5) | 0x02;
+    state.bc = word(engine);
+    state.de = word(engine);
+    state.hl = word(engine);
+    state.sp = word(engine);
+    state.pc = word(engine);
+    state.cycle = 0;
+    state.halt = false;
+    state.interrupts_enabled = byte(engine) & 1;
+    state.interrupt_vector = std::nullopt;
+
+    return scenario;
+}
+
+std::optional<CoSimulator::Divergence> fuzz(uint64_t seed, uint64_t steps, Cpu::Timing timing)
+{
+    RandomScenario scenario = make_random_scenario(seed);
+    CoSimulator cosim(scenario.image, scenario.state, timing);
+
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<uint32_t> chance(0, INTERRUPT_ONE_IN - 1);
+    std::uniform_int_distribution<uint16_t> isr(0, 7);
+
+    // Fast timing only runs whole blocks through run()
+    auto granularity = (timing == Cpu::Timing::fast) ? CoSimulator::Granularity::block
+                                                     : CoSimulator::Granularity::instruction;
+
+    for (uint64_t i = 0; i < steps && !cosim.reference().halt(); i++) {
+        if (chance(engine) == 0) {
+            cosim.interrupt(isr(engine));
+        }
+
+        if (auto divergence = cosim.step(granularity)) {
+            return divergence;
+        }
+    }
+
+    return std::nullopt;
+}
+} // namespace i8080
@@ -0,0 +1,795 @@
+#include "cpm.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+
+namespace i8080
+{
+static constexpr size_t BIOS_ENTRY_COUNT = 17;
+static constexpr size_t NAME_SIZE = 8;
+static constexpr size_t KEY_SIZE = 11;
+static constexpr uint16_t DEFAULT_FCB = 0x5c;
+static constexpr uint16_t SECOND_FCB = 0x6c;
+static constexpr uint16_t COMMAND_TAIL = 0x80;
+static constexpr size_t MAX_COMMAND_TAIL = 127;
+static constexpr size_t MAX_STRING = 0x10000;
+
+// FCB fields
+static constexpr uint16_t FCB_EXTENT = 12;
+static constexpr uint16_t FCB_MODULE = 14;
+static constexpr uint16_t FCB_RECORD_COUNT = 15;
+static constexpr uint16_t FCB_NEW_NAME = 16;
+static constexpr uint16_t FCB_CURRENT_RECORD = 32;
+static constexpr uint16_t FCB_RANDOM_RECORD = 33;
+static constexpr size_t FCB_SIZE = 36;
+static constexpr size_t DIRECTORY_ENTRY_SIZE = 32;
+
+static constexpr uint32_t RECORDS_PER_EXTENT = 128;
+static constexpr uint32_t EXTENTS_PER_MODULE = 32;
+static constexpr uint32_t MAX_RANDOM_RECORD = 0xffff;
+
+static constexpr uint8_t OPCODE_JMP = 0xc3;
+static constexpr uint8_t OPCODE_OUT = 0xd3;
+static constexpr uint8_t OPCODE_RET = 0xc9;
+
+static constexpr char END_OF_FILE = 0x1a;
+static constexpr uint8_t FAILURE = 0xff;
+// Read past the end of the file, or of the written records
+static constexpr uint8_t NO_DATA = 1;
+static constexpr uint8_t NO_SPACE = 2;
+static constexpr uint8_t SEEK_PAST_END = 6;
+
+enum BdosFunction : uint8_t
+{
+    system_reset = 0,
+    console_input = 1,
+    console_output = 2,
+    direct_console_io = 6,
+    print_string = 9,
+    read_console_buffer = 10,
+    console_status = 11,
+    version = 12,
+    reset_disk_system = 13,
+    select_disk = 14,
+    open_file = 15,
+    close_file = 16,
+    search_first = 17,
+    search_next = 18,
+    delete_file = 19,
+    read_sequential = 20,
+    write_sequential = 21,
+    make_file = 22,
+    rename_file = 23,
+    login_vector = 24,
+    current_disk = 25,
+    set_dma = 26,
+    user_code = 32,
+    read_random = 33,
+    write_random = 34,
+    file_size = 35,
+    set_random_record = 36,
+    write_random_zero_fill = 40,
+};
+
+enum BiosEntry : uint8_t
+{
+    boot,
+    warm_boot,
+    console_ready,
+    console_in,
+    console_out,
+    list,
+    punch,
+    reader,
+    home,
+    select_drive,
+    set_track,
+    set_sector,
+    set_dma_address,
+    read_sector,
+    write_sector,
+    list_status,
+    translate_sector,
+};
+
+static constexpr uint16_t CPM_VERSION = 0x22;
+static constexpr uint8_t DRIVE_A_ONLY = 1;
+
+// Hands OUTs to the BDOS or a BIOS entry. The port tells which was called and register C holds
+// the function or argument; whatever A sends is the caller's and means nothing.
+class Cpm::Port final : public Device
+{
+public:
+    Port(Cpm& cpm, uint8_t entry) :
+        _cpm(cpm),
+        _entry(entry)
+    {}
+
+    void write(uint8_t) override
+    {
+        uint8_t argument = _cpm.get()._cpu.get().state().c;
+        if (_entry == 0) {
+            _cpm.get()._bdos(argument);
+        } else {
+            _cpm.get()._bios(_entry - 1, argument);
+        }
+
+        // Calls write their results straight into memory
+        _cpm.get()._bus.get().sync_mirror();
+    }
+
+private:
+    std::reference_wrapper<Cpm> _cpm;
+    uint8_t _entry;
+};
+
+// The FCB form of a host file name, if it has one
+static std::optional<std::string> to_key(const std::string& filename)
+{
+    size_t dot = filename.find('.');
+    std::string_view name = std::string_view(filename).substr(0, dot);
+    std::string_view type = (dot == std::string::npos)
+                                ? std::string_view()
+                                : std::string_view(filename).substr(dot + 1);
+
+    if (name.empty() || name.size() > NAME_SIZE || type.size() > KEY_SIZE - NAME_SIZE ||
+        type.find('.') != std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    std::string key(KEY_SIZE, ' ');
+    std::ranges::transform(name, key.begin(), ::toupper);
+    std::ranges::transform(type, key.begin() + NAME_SIZE, ::toupper);
+    return key;
+}
+
+// "NAME.TYP" for a key without wildcards
+static std::string from_key(std::string_view key)
+{
+    auto trim = [](std::string_view part) {
+        return part.substr(0, part.find_last_not_of(' ') + 1);
+    };
+
+    std::string_view type = trim(key.substr(NAME_SIZE));
+    std::string filename(trim(key.substr(0, NAME_SIZE)));
+    if (!type.empty()) {
+        filename += '.';
+        filename += type;
+    }
+
+    return filename;
+}
+
+static bool matches(std::string_view pattern, std::string_view key)
+{
+    return std::ranges::equal(pattern, key, [](char wanted, char actual) {
+        return wanted == '?' || wanted == actual;
+    });
+}
+
+Cpm::Cpm(Cpu& cpu, Bus& bus, Config config) :
+    _cpu(cpu),
+    _bus(bus),
+    _config(std::move(config)),
+    _dma(DEFAULT_DMA),
+    _drive(0),
+    _exited(false),
+    _search_position(0)
+{
+    for (uint8_t entry = 0; entry <= BIOS_ENTRY_COUNT; entry++) {
+        bus.register_device(_config.port + entry, std::make_shared<Port>(*this, entry));
+    }
+
+    _install();
+}
+
+Cpm::~Cpm()
+{
+    for (uint8_t entry = 0; entry <= BIOS_ENTRY_COUNT; entry++) {
+        _bus.get().register_device(_config.port + entry, nullptr);
+    }
+
+    try {
+        flush();
+    } catch (const std::exception&) {
+        // Nowhere to report it from a destructor, call flush() first to see failures
+    }
+}
+
+void Cpm::_install()
+{
+    auto put_word = [this](uint16_t address, uint16_t word) {
+        _byte(address) = word & 0xff;
+        _byte(address + 1) = word >> 8;
+    };
+
+    // Page zero: warm boot, IOBYTE, current drive and the BDOS entry
+    _byte(0) = OPCODE_JMP;
+    put_word(1, BIOS_BASE + 3);
+    _byte(3) = 0;
+    _byte(4) = 0;
+    _byte(5) = OPCODE_JMP;
+    put_word(6, BDOS_ENTRY);
+
+    _byte(BDOS_ENTRY) = OPCODE_OUT;
+    _byte(BDOS_ENTRY + 1) = _config.port;
+    _byte(BDOS_ENTRY + 2) = OPCODE_RET;
+
+    // Each jump table entry is three bytes, just enough for the stub itself
+    for (uint8_t entry = 0; entry < BIOS_ENTRY_COUNT; entry++) {
+        uint16_t address = BIOS_BASE + entry * 3;
+        _byte(address) = OPCODE_OUT;
+        _byte(address + 1) = _config.port + 1 + entry;
+        _byte(address + 2) = OPCODE_RET;
+    }
+
+    // The default FCBs and the command tail, upper cased like the CCP does
+    for (uint16_t address = DEFAULT_FCB; address < DEFAULT_FCB + FCB_SIZE; address++) {
+        _byte(address) = 0;
+    }
+
+    const std::vector<std::string>& arguments = _config.arguments;
+    for (size_t index = 0; index < 2; index++) {
+        uint16_t fcb = index ? SECOND_FCB : DEFAULT_FCB;
+        std::string_view argument = (index < arguments.size()) ? arguments[index] : "";
+        if (argument.size() >= 2 && argument[1] == ':') {
+            _byte(fcb) = std::toupper(argument[0]) - 'A' + 1;
+            argument.remove_prefix(2);
+        }
+
+        std::string key(KEY_SIZE, ' ');
+        size_t dot = argument.find('.');
+        std::array<std::string_view, 2> parts = {
+            argument.substr(0, dot),
+            (dot == std::string_view::npos) ? std::string_view() : argument.substr(dot + 1)
+        };
+
+        for (size_t part = 0; part < parts.size(); part++) {
+            size_t start = part ? NAME_SIZE : 0;
+            size_t size = part ? KEY_SIZE - NAME_SIZE : NAME_SIZE;
+            for (size_t offset = 0; offset < size; offset++) {
+                if (offset < parts[part].size() && parts[part][offset] == '*') {
+                    std::fill_n(key.begin() + start + offset, size - offset, '?');
+                    break;
+                }
+
+                if (offset < parts[part].size()) {
+                    key[start + offset] = std::toupper(parts[part][offset]);
+                }
+            }
+        }
+
+        std::ranges::copy(key, &_byte(fcb + 1));
+    }
+
+    std::string tail;
+    for (const std::string& argument : arguments) {
+        tail += ' ';
+        std::ranges::transform(argument, std::back_inserter(tail), ::toupper);
+    }
+
+    tail.resize(std::min(tail.size(), MAX_COMMAND_TAIL));
+    _byte(COMMAND_TAIL) = tail.size();
+    std::ranges::copy(tail, &_byte(COMMAND_TAIL + 1));
+
+    // Programs may return to the CCP, which here means warm boot through address 0
+    Cpu::State state = _cpu.get().state();
+    state.pc = PROGRAM_START;
+    state.sp = BDOS_ENTRY - 2;
+    put_word(state.sp, 0);
+    _cpu.get().set_state(state);
+
+    _bus.get().sync_mirror();
+}
+
+void Cpm::flush()
+{
+    for (auto& [key, file] : _files) {
+        if (!file.dirty) {
+            continue;
+        }
+
+        std::ofstream output(file.path, std::ios::binary | std::ios::trunc);
+        if (!output.is_open()) {
+            throw std::runtime_error(fmt::format("Could not open file: {}", file.path.string()));
+        }
+
+        output.write(reinterpret_cast<const char*>(file.data.data()), file.data.size());
+        file.dirty = false;
+    }
+}
+
+void Cpm::_bdos(uint8_t function)
+{
+    const Cpu::State& state = _cpu.get().state();
+    uint16_t de = state.de;
+    uint8_t e = state.e;
+
+    switch (function) {
+    case system_reset:
+        _exit();
+        break;
+    case console_input: {
+        char character = _console_input();
+        _console_output(character);
+        _return(static_cast<uint8_t>(character));
+        break;
+    }
+    case console_output:
+        _console_output(static_cast<char>(e));
+        break;
+    case direct_console_io:
+        if (e == 0xff) {
+            _return(_console_ready() ? static_cast<uint8_t>(_console_input()) : 0);
+        } else if (e == 0xfe) {
+            _return(_console_ready() ? 0xff : 0);
+        } else {
+            _console_output(static_cast<char>(e));
+        }
+        break;
+    case print_string:
+        _print_string(de);
+        break;
+    case read_console_buffer:
+        _read_line(de);
+        break;
+    case console_status:
+        _return(_console_ready() ? 0xff : 0);
+        break;
+    case version:
+        _return(CPM_VERSION);
+        break;
+    case reset_disk_system:
+        _dma = DEFAULT_DMA;
+        _drive = 0;
+        _byte(4) = _drive;
+        _return(0);
+        break;
+    case select_disk:
+        _drive = e;
+        _byte(4) = _drive;
+        _return(0);
+        break;
+    case open_file:
+        _return(_open_file(de));
+        break;
+    case close_file:
+        _return(_close_file(de));
+        break;
+    case search_first:
+    case search_next:
+        _return(_search(de, function == search_first));
+        break;
+    case delete_file:
+        _return(_delete_file(de));
+        break;
+    case read_sequential:
+    case write_sequential:
+        _return(_transfer(de, function == write_sequential, false));
+        break;
+    case make_file:
+        _return(_make_file(de));
+        break;
+    case rename_file:
+        _return(_rename_file(de));
+        break;
+    case login_vector:
+        _return(DRIVE_A_ONLY);
+        break;
+    case current_disk:
+        _return(_drive);
+        break;
+    case set_dma:
+        _dma = de;
+        break;
+    case user_code:
+        _return(0);
+        break;
+    case read_random:
+    case write_random:
+    case write_random_zero_fill:
+        _return(_transfer(de, function != read_random, true));
+        break;
+    case file_size:
+        _file_size(de);
+        break;
+    case set_random_record:
+        _set_random_record(de);
+        break;
+    default:
+        _return(0);
+        break;
+    }
+}
+
+void Cpm::_bios(uint8_t entry, uint8_t argument)
+{
+    switch (entry) {
+    case boot:
+    case warm_boot:
+        _exit();
+        break;
+    case console_ready:
+        _set_accumulator(_console_ready() ? 0xff : 0);
+        break;
+    case console_in:
+        _set_accumulator(static_cast<uint8_t>(_console_input()));
+        break;
+    case console_out:
+        _console_output(static_cast<char>(argument));
+        break;
+    case reader:
+        _set_accumulator(END_OF_FILE);
+        break;
+    case list_status:
+        _set_accumulator(0xff);
+        break;
+    case select_drive: {
+        // No disk parameter header, there are no raw disks
+        Cpu::State state = _cpu.get().state();
+        state.hl = 0;
+        _cpu.get().set_state(state);
+        break;
+    }
+    case translate_sector: {
+        Cpu::State state = _cpu.get().state();
+        state.hl = state.bc;
+        _cpu.get().set_state(state);
+        break;
+    }
+    case read_sector:
+    case write_sector:
+        _set_accumulator(1);
+        break;
+    default:
+        // The list and punch devices, and the other raw disk entries
+        break;
+    }
+}
+
+void Cpm::_exit()
+{
+    flush();
+    _exited = true;
+
+    Cpu::State state = _cpu.get().state();
+    state.halt = true;
+    _cpu.get().set_state(state);
+    _cpu.get().stop();
+}
+
+void Cpm::_return(uint16_t value)
+{
+    Cpu::State state = _cpu.get().state();
+    state.hl = value;
+    state.a = state.l;
+    state.b = state.h;
+    _cpu.get().set_state(state);
+}
+
+void Cpm::_set_accumulator(uint8_t value)
+{
+    Cpu::State state = _cpu.get().state();
+    state.a = value;
+    _cpu.get().set_state(state);
+}
+
+void Cpm::_console_output(char character)
+{
+    if (_config.console) {
+        _config.console(std::string_view(&character, 1));
+    } else {
+        std::cout << character;
+    }
+}
+
+char Cpm::_console_input()
+{
+    int character = _config.input ? _config.input->get() : EOF;
+    if (character == EOF) {
+        return END_OF_FILE;
+    }
+
+    return (character == '\n') ? '\r' : static_cast<char>(character);
+}
+
+bool Cpm::_console_ready()
+{
+    return _config.input && _config.input->peek() != EOF;
+}
+
+void Cpm::_print_string(uint16_t address)
+{
+    std::string text;
+    for (; _byte(address) != '$' && text.size() < MAX_STRING; address++) {
+        text.push_back(static_cast<char>(_byte(address)));
+    }
+
+    if (_config.console) {
+        _config.console(text);
+    } else {
+        std::cout << text;
+    }
+}
+
+void Cpm::_read_line(uint16_t address)
+{
+    uint8_t capacity = _byte(address);
+    uint8_t count = 0;
+    while (count < capacity) {
+        char character = _console_input();
+        if (character == '\r' || character == END_OF_FILE) {
+            break;
+        }
+
+        _byte(address + 2 + count) = character;
+        _console_output(character);
+        count++;
+    }
+
+    _byte(address + 1) = count;
+    _console_output('\r');
+    _console_output('\n');
+}
+
+std::string Cpm::_fcb_key(uint16_t fcb) const
+{
+    std::string key(KEY_SIZE, ' ');
+    for (size_t offset = 0; offset < KEY_SIZE; offset++) {
+        key[offset] = static_cast<char>(std::toupper(_byte(fcb + 1 + offset) & 0x7f));
+    }
+
+    return key;
+}
+
+std::vector<std::filesystem::path> Cpm::_find(std::string_view key) const
+{
+    std::vector<std::filesystem::path> found;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(_config.directory, error)) {
+        std::optional<std::string> name = to_key(entry.path().filename().string());
+        if (entry.is_regular_file() && name && matches(key, *name)) {
+            found.push_back(entry.path());
+        }
+    }
+
+    std::ranges::sort(found);
+    return found;
+}
+
+Cpm::File* Cpm::_open(uint16_t fcb, bool create)
+{
+    std::string key = _fcb_key(fcb);
+    if (auto it = _files.find(key); it != _files.end()) {
+        return &it->second;
+    }
+
+    std::vector<std::filesystem::path> found = _find(key);
+    if (found.empty() && !create) {
+        return nullptr;
+    }
+
+    File file { .path = found.empty() ? _config.directory / from_key(key) : found.front(),
+                .data = {},
+                .dirty = false };
+    if (found.empty()) {
+        file.dirty = true;
+    } else {
+        // Read ahead the whole file, records are then served from memory
+        std::ifstream input(file.path, std::ios::binary);
+        file.data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+
+    return &_files.insert_or_assign(key, std::move(file)).first->second;
+}
+
+uint8_t Cpm::_open_file(uint16_t fcb)
+{
+    File* file = _open(fcb, false);
+    if (!file) {
+        return FAILURE;
+    }
+
+    uint32_t records = (file->data.size() + RECORD_SIZE - 1) / RECORD_SIZE;
+    uint32_t first = (_byte(fcb + FCB_EXTENT) % EXTENTS_PER_MODULE) * RECORDS_PER_EXTENT;
+    _byte(fcb + FCB_MODULE) = 0;
+    _byte(fcb + FCB_RECORD_COUNT) =
+        std::clamp<int64_t>(static_cast<int64_t>(records) - first, 0, RECORDS_PER_EXTENT);
+    return 0;
+}
+
+uint8_t Cpm::_close_file(uint16_t fcb)
+{
+    std::string key = _fcb_key(fcb);
+    auto it = _files.find(key);
+    if (it == _files.end()) {
+        return _find(key).empty() ? FAILURE : 0;
+    }
+
+    flush();
+    _files.erase(it);
+    return 0;
+}
+
+uint8_t Cpm::_search(uint16_t fcb, bool first)
+{
+    if (first) {
+        // Files made but not written back yet must show up too
+        flush();
+
+        std::string key = _fcb_key(fcb);
+        if (_byte(fcb) == '?') {
+            key.assign(KEY_SIZE, '?');
+        }
+
+        _search_results = _find(key);
+        _search_position = 0;
+    }
+
+    if (_search_position >= _search_results.size()) {
+        return FAILURE;
+    }
+
+    const std::filesystem::path& path = _search_results[_search_position++];
+    std::string key = *to_key(path.filename().string());
+    std::error_code error;
+    uint64_t records = (std::filesystem::file_size(path, error) + RECORD_SIZE - 1) / RECORD_SIZE;
+
+    for (uint16_t offset = 0; offset < DIRECTORY_ENTRY_SIZE; offset++) {
+        _byte(_dma + offset) = 0;
+    }
+
+    std::ranges::copy(key, &_byte(_dma + 1));
+    _byte(_dma + FCB_RECORD_COUNT) = std::min<uint64_t>(records, RECORDS_PER_EXTENT);
+    return 0;
+}
+
+uint8_t Cpm::_delete_file(uint16_t fcb)
+{
+    flush();
+
+    std::string key = _fcb_key(fcb);
+    std::erase_if(_files, [&key](const auto& file) { return matches(key, file.first); });
+
+    std::vector<std::filesystem::path> found = _find(key);
+    for (const std::filesystem::path& path : found) {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+    }
+
+    return found.empty() ? FAILURE : 0;
+}
+
+uint8_t Cpm::_make_file(uint16_t fcb)
+{
+    std::string key = _fcb_key(fcb);
+    std::vector<std::filesystem::path> found = _find(key);
+
+    File file { .path = found.empty() ? _config.directory / from_key(key) : found.front(),
+                .data = {},
+                .dirty = true };
+    _files.insert_or_assign(key, std::move(file));
+
+    _byte(fcb + FCB_MODULE) = 0;
+    _byte(fcb + FCB_RECORD_COUNT) = 0;
+    return 0;
+}
+
+uint8_t Cpm::_rename_file(uint16_t fcb)
+{
+    flush();
+
+    std::string key = _fcb_key(fcb);
+    std::vector<std::filesystem::path> found = _find(key);
+    if (found.empty()) {
+        return FAILURE;
+    }
+
+    _files.erase(key);
+
+    std::error_code error;
+    std::filesystem::rename(found.front(),
+                            _config.directory / from_key(_fcb_key(fcb + FCB_NEW_NAME)),
+                            error);
+    return error ? FAILURE : 0;
+}
+
+uint8_t Cpm::_read(File& file, uint32_t record)
+{
+    size_t offset = static_cast<size_t>(record) * RECORD_SIZE;
+    if (offset >= file.data.size()) {
+        return NO_DATA;
+    }
+
+    size_t count = std::min(RECORD_SIZE, file.data.size() - offset);
+    for (size_t index = 0; index < RECORD_SIZE; index++) {
+        _byte(_dma + index) = (index < count) ? file.data[offset + index] : END_OF_FILE;
+    }
+
+    return 0;
+}
+
+uint8_t Cpm::_write(File& file, uint32_t record)
+{
+    size_t offset = static_cast<size_t>(record) * RECORD_SIZE;
+    if (file.data.size() < offset + RECORD_SIZE) {
+        file.data.resize(offset + RECORD_SIZE);
+    }
+
+    // Written behind, when the file is closed or the program ends
+    for (size_t index = 0; index < RECORD_SIZE; index++) {
+        file.data[offset + index] = _byte(_dma + index);
+    }
+
+    file.dirty = true;
+    return 0;
+}
+
+uint8_t Cpm::_transfer(uint16_t fcb, bool write, bool random)
+{
+    File* file = _open(fcb, false);
+    if (!file) {
+        return write ? NO_SPACE : NO_DATA;
+    }
+
+    uint32_t record = _sequential_record(fcb);
+    if (random) {
+        record = _byte(fcb + FCB_RANDOM_RECORD) | (_byte(fcb + FCB_RANDOM_RECORD + 1) << 8) |
+                 (_byte(fcb + FCB_RANDOM_RECORD + 2) << 16);
+        if (record > MAX_RANDOM_RECORD) {
+            return SEEK_PAST_END;
+        }
+    }
+
+    uint8_t result = write ? _write(*file, record) : _read(*file, record);
+
+    // Random access leaves the sequential position on the record, so reading on re-reads it
+    if (random || result == 0) {
+        _set_sequential_record(fcb, random ? record : record + 1);
+    }
+
+    return result;
+}
+
+void Cpm::_file_size(uint16_t fcb)
+{
+    File* file = _open(fcb, false);
+    uint32_t records = file ? (file->data.size() + RECORD_SIZE - 1) / RECORD_SIZE : 0;
+
+    _byte(fcb + FCB_RANDOM_RECORD) = records & 0xff;
+    _byte(fcb + FCB_RANDOM_RECORD + 1) = (records >> 8) & 0xff;
+    _byte(fcb + FCB_RANDOM_RECORD + 2) = records >> 16;
+    _return(file ? 0 : FAILURE);
+}
+
+void Cpm::_set_random_record(uint16_t fcb)
+{
+    uint32_t record = _sequential_record(fcb);
+    _byte(fcb + FCB_RANDOM_RECORD) = record & 0xff;
+    _byte(fcb + FCB_RANDOM_RECORD + 1) = (record >> 8) & 0xff;
+    _byte(fcb + FCB_RANDOM_RECORD + 2) = record >> 16;
+}
+
+uint32_t Cpm::_sequential_record(uint16_t fcb) const
+{
+    uint32_t module = _byte(fcb + FCB_MODULE) & 0x3f;
+    uint32_t extent = _byte(fcb + FCB_EXTENT) % EXTENTS_PER_MODULE;
+    uint32_t current = _byte(fcb + FCB_CURRENT_RECORD) % RECORDS_PER_EXTENT;
+    return (module * EXTENTS_PER_MODULE + extent) * RECORDS_PER_EXTENT + current;
+}
+
+void Cpm::_set_sequential_record(uint16_t fcb, uint32_t record)
+{
+    _byte(fcb + FCB_CURRENT_RECORD) = record % RECORDS_PER_EXTENT;
+    _byte(fcb + FCB_EXTENT) = (record / RECORDS_PER_EXTENT) % EXTENTS_PER_MODULE;
+    _byte(fcb + FCB_MODULE) = record / RECORDS_PER_EXTENT / EXTENTS_PER_MODULE;
+}
+} // namespace i8080
@@ -1,15 +1,33 @@
 #include "cpu.h"
 #include "asm.h"
+#include "breakpoints.h"
+#include "callgraph.h"
+#include "metrics.h"
+#include "trace.h"
 
 #include <fmt/format.h>
 
 #include <cstdint>
+#include <limits>
 
 namespace i8080
 {
-Cpu::Cpu(Bus& bus, uint16_t entry_point) :
+Cpu::Cpu(Bus& bus, uint16_t entry_point, Timing timing) :
+    _timing(timing),
+    _io_access_cycle((timing == Timing::exact) ? IO_ACCESS_CYCLE : 0),
     _debug(false),
-    _bus(bus)
+    _stop_requested(false),
+    _bus(bus),
+    _block_costs((timing == Timing::fast) ? std::make_unique<BlockCosts>(bus) : nullptr),
+    _tracer(nullptr),
+    _call_graph(nullptr),
+    _metrics(nullptr),
+    _native_code(nullptr),
+    _breakpoints(nullptr),
+    _breakpoint_retired(std::numeric_limits<uint64_t>::max()),
+    _branched(false),
+    _retired(0),
+    _interrupt_raised_cycle(0)
 {
     _state.af = 0;
     _state.bc = 0;
@@ -27,9 +45,195 @@ Cpu::Cpu(Bus& bus, uint16_t entry_point) :
 
 void Cpu::tick()
 {
+    if (_state.halt) {
+        return;
+    }
+
+    _retired++;
     _execute(_bus.get().fetch(_state.pc));
 }
 
+Cpu::StopReason Cpu::run(uint64_t cycles)
+{
+    StopReason reason;
+    if (_breakpoints) {
+        reason = _run_breakpoints(cycles);
+    } else if (_native_code) {
+        reason = _run_native(cycles);
+    } else {
+        reason = (_timing == Timing::fast) ? _run_fast(cycles) : _run(cycles);
+    }
+
+    if (_metrics) {
+        publish_metrics();
+    }
+
+    return reason;
+}
+
+void Cpu::publish_metrics() const
+{
+    if (_metrics) {
+        _metrics->publish(_retired, _state.cycle);
+
+        if (_block_costs) {
+            _metrics->publish_blocks(_block_costs->hits(), _block_costs->misses());
+        }
+    }
+}
+
+Cpu::StopReason Cpu::_run(uint64_t cycles)
+{
+    uint64_t end = _state.cycle + cycles;
+
+    while (_state.cycle < end) {
+        if (_state.halt) {
+            return StopReason::halt;
+        }
+
+        tick();
+
+        if (_stop_requested) {
+            _stop_requested = false;
+            return StopReason::stop;
+        }
+    }
+
+    return StopReason::cycles;
+}
+
+inline void Cpu::_run_block(BlockCosts::Block block)
+{
+    BlockCosts& block_costs = *_block_costs;
+    uint8_t page = _state.pc / Bus::PAGE_SIZE;
+    uint32_t generation = block_costs.generation(page);
+
+    _state.cycle += block.cycles;
+    _retired += block.instructions;
+
+    for (uint16_t left = block.instructions;;) {
+        _execute<true>(_bus.get().fetch(_state.pc));
+        if (--left == 0) {
+            break;
+        }
+
+        // The block wrote over code on its own page: give back what is left of it as measured,
+        // and run the page an instruction at a time from now on
+        if (block_costs.generation(page) != generation) [[unlikely]] {
+            BlockCosts::Block rest = block_costs.measured(_state.pc);
+            _state.cycle -= rest.cycles;
+            _retired -= rest.instructions;
+            block_costs.set_volatile(page);
+            return;
+        }
+    }
+
+    // Only the I/O ending a block can have raised an interrupt
+    if (_state.interrupt_vector) {
+        _dispatch_interrupt();
+    }
+}
+
+Cpu::StopReason Cpu::_run_fast(uint64_t cycles)
+{
+    uint64_t end = _state.cycle + cycles;
+    BlockCosts& block_costs = *_block_costs;
+
+    while (_state.cycle < end) {
+        if (_state.halt) {
+            return StopReason::halt;
+        }
+
+        // Tracing watches every instruction, and a pending interrupt is taken after the next one
+        BlockCosts::Block block = block_costs.get(_state.pc);
+        if (block.instructions == 0 || _tracer || _debug || _call_graph ||
+            _state.interrupt_vector) {
+            tick();
+        } else {
+            _run_block(block);
+        }
+
+        if (_stop_requested) {
+            _stop_requested = false;
+            return StopReason::stop;
+        }
+    }
+
+    return StopReason::cycles;
+}
+
+Cpu::StopReason Cpu::_run_native(uint64_t cycles)
+{
+    uint64_t end = _state.cycle + cycles;
+
+    while (_state.cycle < end) {
+        if (_state.halt) {
+            return StopReason::halt;
+        }
+
+        // Blocks end after I/O, so a device stopping the CPU is seen right away
+        _step_native();
+
+        if (_stop_requested) {
+            _stop_requested = false;
+            return StopReason::stop;
+        }
+    }
+
+    return StopReason::cycles;
+}
+
+Cpu::StopReason Cpu::_run_breakpoints(uint64_t cycles)
+{
+    uint64_t end = _state.cycle + cycles;
+    bool resuming = (_retired == _breakpoint_retired);
+    Breakpoints& breakpoints = *_breakpoints;
+
+    while (_state.cycle < end) {
+        if (_state.halt) {
+            return StopReason::halt;
+        }
+
+        if (!resuming && breakpoints.marked(_state.pc) && breakpoints.hit(_state)) [[unlikely]] {
+            _breakpoint_retired = _retired;
+            return StopReason::breakpoint;
+        }
+
+        resuming = false;
+
+        // Recompiled blocks never leave the page they start on
+        if (_native_code && !breakpoints.marked(_state.pc)) {
+            _step_native();
+        } else {
+            tick();
+        }
+
+        if (_stop_requested) {
+            _stop_requested = false;
+            return StopReason::stop;
+        }
+    }
+
+    return StopReason::cycles;
+}
+
+void Cpu::_step_native()
+{
+    if (uint32_t retired = _native_code(_state, _bus.get())) {
+        _retired += retired;
+
+        if (_state.halt && _metrics) {
+            _metrics->add_halt();
+        }
+
+        if (_state.interrupt_vector) {
+            _dispatch_interrupt();
+        }
+    } else {
+        tick();
+    }
+}
+
 void Cpu::interrupt(Instruction instruction)
 {
     // If interrupts are enabled, disable them and set the IV.
@@ -37,6 +241,12 @@ void Cpu::interrupt(Instruction instruction)
     if (_state.interrupts_enabled) {
         _state.interrupts_enabled = false;
         _state.interrupt_vector.emplace(instruction);
+        _interrupt_raised_cycle = _state.cycle;
+
+        // An interrupt is the only way out of HLT, and the RST runs right away
+        if (_state.halt) {
+            _dispatch_interrupt();
+        }
     }
 }
 
@@ -71,10 +281,31 @@ void Cpu::_add(uint16_t value, uint8_t carry)
     _state.a = result & 0xff;
 }
 
+uint8_t Cpu::_subtract(uint8_t value, uint8_t borrow)
+{
+    // The ALU adds the complement with the carry in inverted, the auxiliary carry comes from that
+    // addition and the carry flag is the borrow
+    uint8_t complement = ~value;
+    uint8_t carry = !borrow;
+    uint16_t result = static_cast<uint16_t>(_state.a) + complement + carry;
+
+    _set_zero_parity_sign(result);
+
+    _state.flags.carry = !_is_carry(result);
+    _state.flags.aux = (((_state.a & 0xf) + (complement & 0xf) + carry) > 0xf);
+
+    return result & 0xff;
+}
+
 void Cpu::_ret_if(bool condition)
 {
-    if (condition) {
-        _POP(_state.pc);
+    if (!condition) {
+        return;
+    }
+
+    _POP(_state.pc);
+    _branched = true;
+    if (_timing == Timing::exact) {
         _state.cycle += CONDITION_MET_CYCLE_COUNT;
     }
 }
@@ -83,6 +314,7 @@ void Cpu::_jmp_if(bool condition, uint16_t address)
 {
     if (condition) {
         _state.pc = address;
+        _branched = true;
     }
 }
 
@@ -94,7 +326,10 @@ void Cpu::_call_if(bool condition, uint16_t address)
 
     _PUSH(_state.pc + 3);
     _state.pc = address;
-    _state.cycle += CONDITION_MET_CYCLE_COUNT;
+    _branched = true;
+    if (_timing == Timing::exact) {
+        _state.cycle += CONDITION_MET_CYCLE_COUNT;
+    }
 }
 
 // Instructions
@@ -110,17 +345,20 @@ void Cpu::_ADC(uint8_t reg)
 
 void Cpu::_SUB(uint8_t reg)
 {
-    _add(-reg, 0);
+    _state.a = _subtract(reg, 0);
 }
 
 void Cpu::_SBB(uint8_t reg)
 {
-    _add(-reg, -_state.flags.carry);
+    _state.a = _subtract(reg, _state.flags.carry);
 }
 
 void Cpu::_ANA(uint8_t reg)
 {
+    // AND takes its auxiliary carry from bit 3 of either operand
+    uint8_t aux = ((_state.a | reg) & 0x08) != 0;
     _bitwise_instruction<std::bit_and<uint8_t>>(reg);
+    _state.flags.aux = aux;
 }
 
 void Cpu::_XRA(uint8_t reg)
@@ -135,23 +373,22 @@ void Cpu::_ORA(uint8_t reg)
 
 void Cpu::_CMP(uint8_t reg)
 {
-    int16_t result = _state.a - reg;
-    _state.flags.carry = result >> 8;
-    _set_zero_parity_sign(static_cast<uint16_t>(result));
+    _subtract(reg, 0);
 }
 
 void Cpu::_INR(uint8_t& reg)
 {
     reg++;
     _set_zero_parity_sign(reg);
-    _state.flags.aux = (((_state.a & 0xf) + (reg & 0xf)) > 0xf);
+    _state.flags.aux = ((reg & 0xf) == 0);
 }
 
 void Cpu::_DCR(uint8_t& reg)
 {
+    // Decrementing adds 0xff, which carries out of bit 3 unless the low nibble was 0
     reg--;
     _set_zero_parity_sign(reg);
-    _state.flags.aux = (((_state.a & 0xf) + (reg & 0xf)) > 0xf);
+    _state.flags.aux = ((reg & 0xf) != 0xf);
 }
 
 void Cpu::_DAD(uint16_t reg)
@@ -193,6 +430,13 @@ void Cpu::_DAA()
     _state.flags.carry = carry;
 }
 
+uint8_t Cpu::_read_m()
+{
+    uint8_t value;
+    _bus.get().mem_read(_state.hl, value);
+    return value;
+}
+
 bool Cpu::_get_parity(uint16_t number)
 {
     uint8_t one_bits = 0;
@@ -203,23 +447,39 @@ bool Cpu::_get_parity(uint16_t number)
     return !(one_bits & 1);
 }
 
-void Cpu::_execute(const Opcode& opcode)
+template <bool in_block>
+void Cpu::_execute(const Opcode& fetched)
 {
-    uint16_t current_pc = _state.pc;
+    // The bytes are fetched before anything executes, so an instruction writing over itself
+    // still runs and costs as what it was
+    const Opcode opcode = fetched;
+    _branched = false;
+    uint16_t current_sp = _state.sp;
+#ifdef I8080_PROFILING
+    uint64_t current_cycle = _state.cycle;
+#endif
+
+    if (!in_block && _tracer) [[unlikely]] {
+        _tracer->record(opcode, _state);
+    }
 
-    if (_debug) {
+    if (!in_block && _debug) {
         print_dissassembly(opcode, _state.pc);
     }
 
     switch (opcode.instruction) {
     case Instruction::OUT:
-        _bus.get().write(opcode.u8operand, _state.c);
+        _state.cycle += _io_access_cycle;
+        _bus.get().write(opcode.u8operand, _state.a);
+        _state.cycle -= _io_access_cycle;
         break;
     case Instruction::IN:
-        _bus.get().read(opcode.u8operand, _state.c);
+        _state.cycle += _io_access_cycle;
+        _bus.get().read(opcode.u8operand, _state.a);
+        _state.cycle -= _io_access_cycle;
         break;
     case Instruction::SHLD:
-        _bus.get().mem_write(_state.hl, opcode.u16operand);
+        _bus.get().mem_write(opcode.u16operand, _state.hl);
         break;
     case Instruction::LHLD:
         _bus.get().mem_read(opcode.u16operand, _state.hl);
@@ -250,6 +510,7 @@ void Cpu::_execute(const Opcode& opcode)
     } break;
     case Instruction::PCHL:
         _state.pc = _state.hl;
+        _branched = true;
         break;
     case Instruction::SPHL:
         _state.sp = _state.hl;
@@ -452,7 +713,7 @@ void Cpu::_execute(const Opcode& opcode)
         _state.a = _state.h;
         break;
     case Instruction::MOV_A_L:
-        _state.a = _state.a;
+        _state.a = _state.l;
         break;
     case Instruction::MOV_A_M:
         _bus.get().mem_read(_state.hl, _state.a);
@@ -541,8 +802,12 @@ void Cpu::_execute(const Opcode& opcode)
         _INR(_state.h);
         break;
     case Instruction::INR_M:
-        _INR(_bus.get().mem_read_u8_ref(_state.hl));
-        break;
+    {
+        // Read-modify-write so the store is visible to the bus
+        uint8_t value = _read_m();
+        _INR(value);
+        _bus.get().mem_write(_state.hl, value);
+    } break;
     case Instruction::INR_C:
         _INR(_state.c);
         break;
@@ -567,8 +832,11 @@ void Cpu::_execute(const Opcode& opcode)
         _DCR(_state.h);
         break;
     case Instruction::DCR_M:
-        _DCR(_bus.get().mem_read_u8_ref(_state.hl));
-        break;
+    {
+        uint8_t value = _read_m();
+        _DCR(value);
+        _bus.get().mem_write(_state.hl, value);
+    } break;
     case Instruction::DCR_C:
         _DCR(_state.c);
         break;
@@ -628,7 +896,7 @@ void Cpu::_execute(const Opcode& opcode)
         _ADD(_state.l);
         break;
     case Instruction::ADD_M:
-        _ADD(_bus.get().mem_read_u8_ref(_state.hl));
+        _ADD(_read_m());
         break;
     case Instruction::ADD_A:
         _ADD(_state.a);
@@ -657,7 +925,7 @@ void Cpu::_execute(const Opcode& opcode)
         _ADC(_state.l);
         break;
     case Instruction::ADC_M:
-        _ADC(_bus.get().mem_read_u8_ref(_state.hl));
+        _ADC(_read_m());
         break;
     case Instruction::ADC_A:
         _ADC(_state.a);
@@ -686,7 +954,7 @@ void Cpu::_execute(const Opcode& opcode)
         _SUB(_state.l);
         break;
     case Instruction::SUB_M:
-        _SUB(_bus.get().mem_read_u8_ref(_state.hl));
+        _SUB(_read_m());
         break;
     case Instruction::SUB_A:
         _SUB(_state.a);
@@ -711,7 +979,7 @@ void Cpu::_execute(const Opcode& opcode)
         _CMP(_state.l);
         break;
     case Instruction::CMP_M:
-        _CMP(_bus.get().mem_read_u8_ref(_state.hl));
+        _CMP(_read_m());
         break;
     case Instruction::CMP_A:
         _CMP(_state.a);
@@ -743,7 +1011,7 @@ void Cpu::_execute(const Opcode& opcode)
         _SBB(_state.l);
         break;
     case Instruction::SBB_M:
-        _SBB(_bus.get().mem_read_u8_ref(_state.hl));
+        _SBB(_read_m());
         break;
     case Instruction::SBB_A:
         _SBB(_state.a);
@@ -772,7 +1040,7 @@ void Cpu::_execute(const Opcode& opcode)
         _ANA(_state.l);
         break;
     case Instruction::ANA_M:
-        _ANA(_bus.get().mem_read_u8_ref(_state.hl));
+        _ANA(_read_m());
         break;
     case Instruction::ANA_A:
         _ANA(_state.a);
@@ -801,7 +1069,7 @@ void Cpu::_execute(const Opcode& opcode)
         _XRA(_state.l);
         break;
     case Instruction::XRA_M:
-        _XRA(_bus.get().mem_read_u8_ref(_state.hl));
+        _XRA(_read_m());
         break;
     case Instruction::XRA_A:
         _XRA(_state.a);
@@ -830,7 +1098,7 @@ void Cpu::_execute(const Opcode& opcode)
         _ORA(_state.l);
         break;
     case Instruction::ORA_M:
-        _ORA(_bus.get().mem_read_u8_ref(_state.hl));
+        _ORA(_read_m());
         break;
     case Instruction::ORA_A:
         _ORA(_state.a);
@@ -850,8 +1118,13 @@ void Cpu::_execute(const Opcode& opcode)
         _POP(_state.hl);
         break;
     case Instruction::POP_PSW:
-        _POP(_state.af);
-        break;
+    {
+        // Flags are the low byte on the stack, with their unused bits fixed
+        uint16_t psw;
+        _POP(psw);
+        _state.a = psw >> 8;
+        _state.flags.status = (psw & FLAGS_USED) | FLAGS_SET;
+    } break;
 
     // PUSH
     case Instruction::PUSH_B:
@@ -864,12 +1137,14 @@ void Cpu::_execute(const Opcode& opcode)
         _PUSH(_state.hl);
         break;
     case Instruction::PUSH_PSW:
-        _PUSH(_state.af);
+        _PUSH((_state.a << 8) | (_state.flags.status & FLAGS_USED) | FLAGS_SET);
         break;
 
-    // RET instructions
+    // RET instructions, and the undocumented alias
     case Instruction::RET:
-        _ret_if(true);
+    case Instruction::NOP7:
+        _POP(_state.pc);
+        _branched = true;
         break;
     case Instruction::RNZ:
         _ret_if(!_state.flags.zero);
@@ -896,8 +1171,9 @@ void Cpu::_execute(const Opcode& opcode)
         _ret_if(_state.flags.sign);
         break;
 
-    // JMP instructions
+    // JMP instructions, and the undocumented alias
     case Instruction::JMP:
+    case Instruction::NOP6:
         _jmp_if(true, opcode.u16operand);
         break;
     case Instruction::JNZ:
@@ -925,9 +1201,14 @@ void Cpu::_execute(const Opcode& opcode)
         _jmp_if(_state.flags.sign, opcode.u16operand);
         break;
 
-    // CALL instructions
+    // CALL instructions, and the undocumented aliases
     case Instruction::CALL:
-        _call_if(true, opcode.u16operand);
+    case Instruction::NOP8:
+    case Instruction::NOP9:
+    case Instruction::NOP10:
+        _PUSH(_state.pc + 3);
+        _state.pc = opcode.u16operand;
+        _branched = true;
         break;
     case Instruction::CNZ:
         _call_if(!_state.flags.zero, opcode.u16operand);
@@ -963,8 +1244,9 @@ void Cpu::_execute(const Opcode& opcode)
     case Instruction::RST_5:
     case Instruction::RST_6:
     case Instruction::RST_7:
-        _PUSH(_state.pc);
+        _PUSH(_state.pc + 1);
         _state.pc = isr_offset(opcode.instruction);
+        _branched = true;
         break;
 
     case Instruction::MOV_A_A:
@@ -980,11 +1262,9 @@ void Cpu::_execute(const Opcode& opcode)
     case Instruction::NOP3:
     case Instruction::NOP4:
     case Instruction::NOP5:
-    case Instruction::NOP6:
-    case Instruction::NOP7:
-    case Instruction::NOP8:
-    case Instruction::NOP9:
-    case Instruction::NOP10:
+    // 8085 instructions, on the 8080 they do nothing
+    case Instruction::RIM:
+    case Instruction::SIM:
         break;
 
     default:
@@ -992,20 +1272,62 @@ void Cpu::_execute(const Opcode& opcode)
 
     case Instruction::HLT:
         _state.halt = true;
-        return;
-    }
+        if (_metrics) {
+            _metrics->add_halt();
+        }
 
-    if (_state.interrupts_enabled && _state.interrupt_vector) {
-        _execute({ .instruction = *_state.interrupt_vector });
-        _state.interrupt_vector.reset();
-        return;
+        break;
     }
 
     const OpcodeMetadata& metadata = get_opcode_metadata(opcode.instruction);
-    _state.cycle += metadata.cycles;
+    if constexpr (!in_block) {
+        _state.cycle += metadata.cycles;
+    }
 
-    if (_state.pc == current_pc) {
+    if (!_branched) {
         _state.pc += metadata.size;
     }
+
+    if (!in_block && _call_graph) [[unlikely]] {
+        _call_graph->observe(opcode.instruction, current_sp, _state);
+    }
+
+#ifdef I8080_PROFILING
+    // Taken branches add their extra cycles while executing, a dispatched interrupt is not counted
+    if (_profile) [[unlikely]] {
+        _profile->record(opcode.instruction,
+                         in_block ? metadata.cycles : _state.cycle - current_cycle);
+    }
+#endif
+
+    // interrupt() only accepts a vector while interrupts are enabled, and disables them
+    if (!in_block && _state.interrupt_vector) {
+        _dispatch_interrupt();
+    }
+}
+
+void Cpu::_dispatch_interrupt()
+{
+    // The RST is jammed in place of the next instruction, so the return address is the
+    // current PC. Clear the IV first, the ISR itself may re-enable interrupts.
+    Instruction vector = *_state.interrupt_vector;
+    _state.interrupt_vector.reset();
+    _state.halt = false;
+
+    if (_metrics) {
+        _metrics->add_interrupt(_state.cycle - _interrupt_raised_cycle);
+    }
+
+    _PUSH(_state.pc);
+    _state.pc = isr_offset(vector);
+    _state.cycle += get_opcode_metadata(vector).cycles;
+
+    if (_call_graph) {
+        _call_graph->interrupt(_state.pc, _state);
+    }
+
+    if (_interrupt_callback) {
+        _interrupt_callback(vector);
+    }
 }
 } // namespace i8080
@@ -0,0 +1,238 @@
+#include "disasm.h"
+
+#include <iterator>
+#include <optional>
+
+namespace i8080
+{
+// Runs of zero data at least this long are rendered as a single DS
+static constexpr size_t MIN_RESERVED_RUN = 16;
+static constexpr size_t LISTING_CODE_WIDTH = 10;
+
+enum class Flow : uint8_t
+{
+    next,
+    jump,
+    branch,
+    call,
+    end
+};
+
+static Flow get_flow(Instruction instruction)
+{
+    switch (get_control_flow(instruction)) {
+    case ControlFlow::jump:
+        return is_conditional(instruction) ? Flow::branch : Flow::jump;
+    case ControlFlow::call:
+        return Flow::call;
+    // A conditional return may fall through
+    case ControlFlow::ret:
+        return is_conditional(instruction) ? Flow::next : Flow::end;
+    case ControlFlow::pchl:
+    case ControlFlow::halt:
+        return Flow::end;
+    default:
+        return Flow::next;
+    }
+}
+
+static bool is_rst(Instruction instruction)
+{
+    return (static_cast<uint8_t>(instruction) & 0xc7) == static_cast<uint8_t>(Instruction::RST_0);
+}
+
+Disassembler::Disassembler(const buffer& memory) :
+    _memory(memory),
+    _kinds(ADDRESS_SPACE, ByteKind::data),
+    _labels(ADDRESS_SPACE, false),
+    _instruction_count(0)
+{}
+
+Disassembler::Disassembler(const buffer& memory, std::initializer_list<uint16_t> entry_points) :
+    Disassembler(memory)
+{
+    for (uint16_t entry_point : entry_points) {
+        add_entry_point(entry_point);
+    }
+}
+
+uint8_t Disassembler::_byte(uint32_t address) const
+{
+    address %= ADDRESS_SPACE;
+    return (address < _memory.size()) ? _memory[address] : 0;
+}
+
+Opcode Disassembler::opcode(uint16_t address) const
+{
+    Opcode opcode;
+    opcode.instruction = static_cast<Instruction>(_byte(address));
+    opcode.u16operand = _byte(address + 1) | (_byte(address + 2) << 8);
+    return opcode;
+}
+
+void Disassembler::add_entry_point(uint16_t address)
+{
+    _labels[address] = true;
+    _pending.push_back(address);
+
+    while (!_pending.empty()) {
+        uint16_t pc = _pending.back();
+        _pending.pop_back();
+
+        // Follow a straight line until it ends, joins code already seen or runs into it
+        std::optional<uint16_t> loaded_hl = std::nullopt;
+        while (_kinds[pc] == ByteKind::data) {
+            Opcode current = opcode(pc);
+            const OpcodeMetadata& metadata = get_opcode_metadata(current.instruction);
+
+            bool overlaps = false;
+            for (uint32_t i = 1; i < metadata.size; i++) {
+                overlaps |= _kinds[(pc + i) % ADDRESS_SPACE] != ByteKind::data;
+            }
+
+            if (overlaps) {
+                break;
+            }
+
+            _kinds[pc] = ByteKind::instruction;
+            for (uint32_t i = 1; i < metadata.size; i++) {
+                _kinds[(pc + i) % ADDRESS_SPACE] = ByteKind::operand;
+            }
+
+            _instruction_count++;
+
+            Flow flow = get_flow(current.instruction);
+            if (flow == Flow::jump || flow == Flow::branch || flow == Flow::call) {
+                uint16_t target = is_rst(current.instruction) ? isr_offset(current.instruction)
+                                                              : current.u16operand;
+                _labels[target] = true;
+                _pending.push_back(target);
+            }
+
+            // "LXI H, target; PCHL" is the usual way to jump through a computed address
+            if (current.instruction == Instruction::PCHL && loaded_hl) {
+                _labels[*loaded_hl] = true;
+                _pending.push_back(*loaded_hl);
+            }
+
+            loaded_hl = (current.instruction == Instruction::LXI_H)
+                            ? std::optional<uint16_t>(static_cast<uint16_t>(current.u16operand))
+                            : std::nullopt;
+
+            if (flow == Flow::jump || flow == Flow::end) {
+                break;
+            }
+
+            pc += metadata.size;
+        }
+    }
+}
+
+bool Disassembler::_has_label(uint16_t address, const SymbolTable* symbols) const
+{
+    if (is_label(address)) {
+        return true;
+    }
+
+    const SymbolTable::Symbol* symbol = symbols ? symbols->find(address) : nullptr;
+    return symbol && symbol->address == address;
+}
+
+std::string Disassembler::_label(uint16_t address, const SymbolTable* symbols) const
+{
+    if (symbols) {
+        const SymbolTable::Symbol* symbol = symbols->find(address);
+        if (symbol && symbol->address == address) {
+            return symbol->name;
+        }
+    }
+
+    return fmt::format("L{:04X}", address);
+}
+
+void Disassembler::render(fmt::memory_buffer& out,
+                          uint16_t first,
+                          uint16_t last,
+                          const SymbolTable* symbols) const
+{
+    auto it = std::back_inserter(out);
+
+    for (uint32_t address = first; address <= last;) {
+        std::string label = _has_label(address, symbols) ? _label(address, symbols) + ":" : "";
+
+        if (is_instruction(address)) {
+            Opcode current = opcode(address);
+            const OpcodeMetadata& metadata = get_opcode_metadata(current.instruction);
+
+            std::string code;
+            for (uint32_t i = 0; i < metadata.size; i++) {
+                code += fmt::format("{:02X}", _byte(address + i));
+            }
+
+            fmt::format_to(it,
+                           " {:04X} {:<{}}{:<8}{}",
+                           address,
+                           code,
+                           LISTING_CODE_WIDTH,
+                           label,
+                           metadata.name);
+
+            uint16_t operand = current.u16operand;
+            Flow flow = get_flow(current.instruction);
+            bool targets_code = (flow == Flow::jump || flow == Flow::branch || flow == Flow::call);
+            if (metadata.size == 3 && targets_code) {
+                fmt::format_to(it, " {}", _label(operand, symbols));
+            } else if (metadata.size == 3) {
+                fmt::format_to(it, " {:#06x}", operand);
+            } else if (metadata.size == 2) {
+                fmt::format_to(it, " {:#04x}", operand & 0xff);
+            }
+
+            out.push_back('\n');
+            address += metadata.size;
+            continue;
+        }
+
+        // A run of data ends at code, at a label or at the end of the range
+        uint32_t end = address + 1;
+        while (end <= last && kind(end) == ByteKind::data && !_has_label(end, symbols)) {
+            end++;
+        }
+
+        bool zeros = true;
+        for (uint32_t i = address; i < end && zeros; i++) {
+            zeros = (_byte(i) == 0);
+        }
+
+        if (zeros && end - address >= MIN_RESERVED_RUN) {
+            fmt::format_to(it,
+                           " {:04X} {:<{}}{:<8}DS {:#x}\n",
+                           address,
+                           "",
+                           LISTING_CODE_WIDTH,
+                           label,
+                           end - address);
+            address = end;
+            continue;
+        }
+
+        // Operands orphaned by a range starting mid-instruction also land here
+        uint32_t line_end = std::min<uint32_t>(end, address + DATA_BYTES_PER_LINE);
+        std::string code;
+        std::string values;
+        for (uint32_t i = address; i < line_end; i++) {
+            code += fmt::format("{:02X}", _byte(i));
+            values += fmt::format("{}{:#04x}", values.empty() ? "" : ", ", _byte(i));
+        }
+
+        fmt::format_to(it,
+                       " {:04X} {:<{}}{:<8}DB {}\n",
+                       address,
+                       code,
+                       LISTING_CODE_WIDTH,
+                       label,
+                       values);
+        address = line_end;
+    }
+}
+} // namespace i8080
@@ -0,0 +1,716 @@
+#include "gdbstub.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace i8080
+{
+// GDB's Z80 registers: af bc de hl sp pc ix iy af' bc' de' hl' ir
+static constexpr size_t REGISTER_COUNT = 13;
+static constexpr size_t REGISTER_AF = 0;
+static constexpr size_t REGISTER_BC = 1;
+static constexpr size_t REGISTER_DE = 2;
+static constexpr size_t REGISTER_HL = 3;
+static constexpr size_t REGISTER_SP = 4;
+static constexpr size_t REGISTER_PC = 5;
+
+static constexpr std::string_view SIGTRAP_STOP = "S05";
+static constexpr std::string_view SIGINT_STOP = "S02";
+static constexpr std::string_view ERROR_REPLY = "E01";
+static constexpr char INTERRUPT = '\x03';
+
+static std::optional<uint32_t> parse_hex(std::string_view text)
+{
+    uint32_t value = 0;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value, 16);
+    if (error != std::errc() || end != text.data() + text.size()) {
+        return std::nullopt;
+    }
+
+    return value;
+}
+
+// Splits "a,b,c" style arguments at any of the separators
+static std::vector<std::string_view> split(std::string_view text, std::string_view separators)
+{
+    std::vector<std::string_view> parts;
+    while (true) {
+        size_t end = text.find_first_of(separators);
+        parts.push_back(text.substr(0, end));
+        if (end == std::string_view::npos) {
+            return parts;
+        }
+
+        text.remove_prefix(end + 1);
+    }
+}
+
+// Registers are sent in target byte order
+static void append_word(std::string& out, uint16_t value)
+{
+    fmt::format_to(std::back_inserter(out), "{:02x}{:02x}", value & 0xff, value >> 8);
+}
+
+GdbStub::GdbStub(Cpu& cpu, Bus& bus, const std::filesystem::path& socket, Config config) :
+    _cpu(cpu),
+    _bus(bus),
+    _config(config),
+    _socket_path(socket),
+    _listener(-1),
+    _input(-1),
+    _output(-1),
+    _shutdown({ -1, -1 }),
+    _attention(false),
+    _received_position(0),
+    _acknowledge(true),
+    _last_stop(SIGTRAP_STOP)
+{
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (socket.native().size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error(fmt::format("Socket path too long: {}", socket.string()));
+    }
+
+    std::copy_n(socket.native().c_str(), socket.native().size() + 1, address.sun_path);
+
+    _listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    std::error_code ignored;
+    std::filesystem::remove(socket, ignored);
+
+    if (_listener < 0 ||
+        ::bind(_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) ||
+        ::listen(_listener, 1)) {
+        if (_listener >= 0) {
+            ::close(_listener);
+        }
+
+        throw std::runtime_error(fmt::format("Could not listen on socket: {}", socket.string()));
+    }
+
+    _start();
+}
+
+GdbStub::GdbStub(Cpu& cpu, Bus& bus, int input, int output, Config config) :
+    _cpu(cpu),
+    _bus(bus),
+    _config(config),
+    _listener(-1),
+    _input(input),
+    _output(output),
+    _shutdown({ -1, -1 }),
+    _attention(false),
+    _received_position(0),
+    _acknowledge(true),
+    _last_stop(SIGTRAP_STOP)
+{
+    _start();
+}
+
+GdbStub::~GdbStub()
+{
+    char byte = 0;
+    [[maybe_unused]] ssize_t written = ::write(_shutdown[1], &byte, 1);
+    _attention.store(false, std::memory_order_release);
+    _attention.notify_all();
+    _watcher.join();
+
+    _disconnect();
+    ::close(_shutdown[0]);
+    ::close(_shutdown[1]);
+
+    if (_listener >= 0) {
+        ::close(_listener);
+        std::error_code ignored;
+        std::filesystem::remove(_socket_path, ignored);
+    }
+}
+
+void GdbStub::_start()
+{
+    if (::pipe2(_shutdown.data(), O_CLOEXEC)) {
+        throw std::runtime_error("Could not create the GDB stub's shutdown pipe");
+    }
+
+    _watcher = std::jthread([this] { _watch(); });
+}
+
+Cpu::StopReason GdbStub::run(uint64_t cycles)
+{
+    Cpu& cpu = _cpu.get();
+    uint64_t end = cpu.state().cycle + cycles;
+
+    while (cpu.state().cycle < end) {
+        if (_attention.load(std::memory_order_acquire)) [[unlikely]] {
+            _attend();
+        }
+
+        Cpu::StopReason reason =
+            cpu.run(std::min(_config.slice_cycles, end - cpu.state().cycle));
+        if (reason == Cpu::StopReason::cycles) {
+            continue;
+        }
+
+        std::optional<Breakpoints::Hit> hit;
+        if (_breakpoints) {
+            hit = _breakpoints->take_hit();
+        }
+
+        bool halted = (reason == Cpu::StopReason::halt);
+        if (hit || (halted && _input >= 0)) {
+            // Keeps the background thread off the connection while it is served from here
+            _attention.store(true, std::memory_order_release);
+            _serve(_stop_reply(hit));
+            _release();
+        }
+
+        if (!hit || halted) {
+            return reason;
+        }
+    }
+
+    return Cpu::StopReason::cycles;
+}
+
+void GdbStub::wait_for_debugger()
+{
+    _attention.wait(false, std::memory_order_acquire);
+    _serve(std::nullopt);
+    _release();
+}
+
+void GdbStub::_watch()
+{
+    while (true) {
+        int client = _input;
+        std::array<pollfd, 2> descriptors = { {
+            // Negative descriptors are ignored, e.g. once a pipe connection is gone
+            { .fd = (client >= 0) ? client : _listener, .events = POLLIN, .revents = 0 },
+            { .fd = _shutdown[0], .events = POLLIN, .revents = 0 },
+        } };
+
+        if (::poll(descriptors.data(), descriptors.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return;
+        }
+
+        if (descriptors[1].revents) {
+            return;
+        }
+
+        if (client < 0) {
+            int connection = ::accept4(_listener, nullptr, nullptr, SOCK_CLOEXEC);
+            if (connection < 0) {
+                continue;
+            }
+
+            _output = connection;
+            _input = connection;
+        }
+
+        _attention.store(true, std::memory_order_release);
+        _attention.notify_one();
+        _attention.wait(true, std::memory_order_acquire);
+    }
+}
+
+void GdbStub::_attend()
+{
+    // The flag can outlive the input that raised it, when a stop already read that input
+    pollfd input = { .fd = _input, .events = POLLIN, .revents = 0 };
+    if (_received_position < _received.size() || (input.fd >= 0 && ::poll(&input, 1, 0) > 0)) {
+        _serve(std::nullopt);
+    }
+
+    _release();
+}
+
+void GdbStub::_release()
+{
+    _attention.store(false, std::memory_order_release);
+    _attention.notify_one();
+}
+
+void GdbStub::_serve(const std::optional<std::string>& stop_reply)
+{
+    if (stop_reply) {
+        _last_stop = *stop_reply;
+        _send_packet(_last_stop);
+    }
+
+    while (std::optional<std::string> packet = _read_packet()) {
+        if (!_execute(*packet)) {
+            return;
+        }
+    }
+
+    _disconnect();
+}
+
+bool GdbStub::_execute(std::string_view packet)
+{
+    char command = packet.empty() ? '\0' : packet.front();
+    std::string_view arguments = packet.substr(std::min<size_t>(packet.size(), 1));
+
+    switch (command) {
+    case INTERRUPT:
+        _last_stop = SIGINT_STOP;
+        _send_packet(_last_stop);
+        return true;
+    case '?':
+        _send_packet(_last_stop);
+        return true;
+    case 'g':
+        _send_packet(_read_registers());
+        return true;
+    case 'G':
+        _send_packet(_write_registers(arguments));
+        return true;
+    case 'p': {
+        std::optional<uint32_t> index = parse_hex(arguments);
+        if (!index || *index >= REGISTER_COUNT) {
+            _send_packet(ERROR_REPLY);
+            return true;
+        }
+
+        std::string value;
+        append_word(value, _register(*index));
+        _send_packet(value);
+        return true;
+    }
+    case 'P': {
+        std::vector<std::string_view> parts = split(arguments, "=");
+        std::optional<uint32_t> index = parse_hex(parts[0]);
+        if (!index || *index >= REGISTER_COUNT || parts.size() != 2 || parts[1].size() != 4) {
+            _send_packet(ERROR_REPLY);
+            return true;
+        }
+
+        std::optional<uint32_t> low = parse_hex(parts[1].substr(0, 2));
+        std::optional<uint32_t> high = parse_hex(parts[1].substr(2));
+        if (!low || !high) {
+            _send_packet(ERROR_REPLY);
+            return true;
+        }
+
+        _write_register(*index, static_cast<uint16_t>(*low | (*high << 8)));
+        _send_packet("OK");
+        return true;
+    }
+    case 'm':
+        _send_packet(_read_memory(arguments));
+        return true;
+    case 'M':
+        _send_packet(_write_memory(arguments));
+        return true;
+    case 'c':
+    case 's': {
+        if (!arguments.empty()) {
+            std::optional<uint32_t> address = parse_hex(arguments);
+            if (!address) {
+                _send_packet(ERROR_REPLY);
+                return true;
+            }
+
+            _write_register(REGISTER_PC, static_cast<uint16_t>(*address));
+        }
+
+        if (command == 'c') {
+            return false;
+        }
+
+        _last_stop = _step();
+        _send_packet(_last_stop);
+        return true;
+    }
+    case 'Z':
+    case 'z':
+        _send_packet(_set_stop_point(arguments, command == 'Z'));
+        return true;
+    case 'D':
+        _send_packet("OK");
+        _disconnect();
+        return false;
+    case 'k':
+        // Only ends the session, the guest belongs to the host
+        _disconnect();
+        return false;
+    case 'H':
+        _send_packet("OK");
+        return true;
+    case 'q':
+        if (packet.starts_with("qSupported")) {
+            _send_packet(fmt::format("PacketSize={:x};QStartNoAckMode+", MAX_PACKET_SIZE));
+        } else if (packet.starts_with("qAttached")) {
+            _send_packet("1");
+        } else {
+            _send_packet("");
+        }
+
+        return true;
+    case 'Q':
+        if (packet == "QStartNoAckMode") {
+            _send_packet("OK");
+            _acknowledge = false;
+        } else {
+            _send_packet("");
+        }
+
+        return true;
+    default:
+        _send_packet("");
+        return true;
+    }
+}
+
+std::string GdbStub::_step()
+{
+    // A watchpoint or device stopping the CPU during the step would otherwise end the next run()
+    Cpu& cpu = _cpu.get();
+    cpu.tick();
+    cpu.clear_stop();
+
+    std::optional<Breakpoints::Hit> hit;
+    if (_breakpoints) {
+        hit = _breakpoints->take_hit();
+    }
+
+    return _stop_reply(hit);
+}
+
+std::string GdbStub::_stop_reply(const std::optional<Breakpoints::Hit>& hit) const
+{
+    if (!hit || hit->kind == Breakpoints::Hit::Kind::breakpoint) {
+        return std::string(SIGTRAP_STOP);
+    }
+
+    return fmt::format("T05{}:{:x};",
+                       (hit->kind == Breakpoints::Hit::Kind::read) ? "rwatch" : "watch",
+                       hit->address);
+}
+
+uint16_t GdbStub::_register(size_t index) const
+{
+    const Cpu::State& state = _cpu.get().state();
+    switch (index) {
+    case REGISTER_AF:
+        return static_cast<uint16_t>((state.a << 8) | state.flags.status);
+    case REGISTER_BC:
+        return state.bc;
+    case REGISTER_DE:
+        return state.de;
+    case REGISTER_HL:
+        return state.hl;
+    case REGISTER_SP:
+        return state.sp;
+    case REGISTER_PC:
+        return state.pc;
+    default:
+        return 0;
+    }
+}
+
+void GdbStub::_write_register(size_t index, uint16_t value)
+{
+    Cpu::State state = _cpu.get().state();
+    switch (index) {
+    case REGISTER_AF:
+        state.a = value >> 8;
+        state.flags.status = value & 0xff;
+        break;
+    case REGISTER_BC:
+        state.bc = value;
+        break;
+    case REGISTER_DE:
+        state.de = value;
+        break;
+    case REGISTER_HL:
+        state.hl = value;
+        break;
+    case REGISTER_SP:
+        state.sp = value;
+        break;
+    case REGISTER_PC:
+        state.pc = value;
+        break;
+    default:
+        return;
+    }
+
+    _cpu.get().set_state(state);
+}
+
+std::string GdbStub::_read_registers() const
+{
+    std::string registers;
+    for (size_t index = 0; index < REGISTER_COUNT; index++) {
+        append_word(registers, _register(index));
+    }
+
+    return registers;
+}
+
+std::string GdbStub::_write_registers(std::string_view values)
+{
+    if (values.size() != REGISTER_COUNT * 4) {
+        return std::string(ERROR_REPLY);
+    }
+
+    for (size_t index = 0; index < REGISTER_COUNT; index++) {
+        std::optional<uint32_t> low = parse_hex(values.substr(index * 4, 2));
+        std::optional<uint32_t> high = parse_hex(values.substr(index * 4 + 2, 2));
+        if (!low || !high) {
+            return std::string(ERROR_REPLY);
+        }
+
+        _write_register(index, static_cast<uint16_t>(*low | (*high << 8)));
+    }
+
+    return "OK";
+}
+
+std::string GdbStub::_read_memory(std::string_view arguments) const
+{
+    std::vector<std::string_view> parts = split(arguments, ",");
+    std::optional<uint32_t> address = parse_hex(parts[0]);
+    std::optional<uint32_t> length = (parts.size() == 2) ? parse_hex(parts[1]) : std::nullopt;
+    if (!address || !length || *length > MAX_PACKET_SIZE / 2) {
+        return std::string(ERROR_REPLY);
+    }
+
+    // Bypasses the watchpoints, which only see the guest's accesses
+    std::string bytes;
+    auto it = std::back_inserter(bytes);
+    for (uint32_t offset = 0; offset < *length; offset++) {
+        fmt::format_to(it, "{:02x}", _bus.get().mem_read_u8_ref(*address + offset));
+    }
+
+    return bytes;
+}
+
+std::string GdbStub::_write_memory(std::string_view arguments)
+{
+    std::vector<std::string_view> parts = split(arguments, ",:");
+    if (parts.size() != 3) {
+        return std::string(ERROR_REPLY);
+    }
+
+    std::optional<uint32_t> address = parse_hex(parts[0]);
+    std::optional<uint32_t> length = parse_hex(parts[1]);
+    if (!address || !length || parts[2].size() != *length * 2) {
+        return std::string(ERROR_REPLY);
+    }
+
+    for (uint32_t offset = 0; offset < *length; offset++) {
+        std::optional<uint32_t> byte = parse_hex(parts[2].substr(offset * 2, 2));
+        if (!byte) {
+            return std::string(ERROR_REPLY);
+        }
+
+        _bus.get().mem_read_u8_ref(*address + offset) = static_cast<uint8_t>(*byte);
+    }
+
+    _bus.get().sync_mirror();
+    return "OK";
+}
+
+std::string GdbStub::_set_stop_point(std::string_view arguments, bool insert)
+{
+    std::vector<std::string_view> parts = split(arguments, ",;");
+    if (parts.size() < 3) {
+        return std::string(ERROR_REPLY);
+    }
+
+    std::optional<uint32_t> type = parse_hex(parts[0]);
+    std::optional<uint32_t> address = parse_hex(parts[1]);
+    std::optional<uint32_t> length = parse_hex(parts[2]);
+    if (!type || !address || !length) {
+        return std::string(ERROR_REPLY);
+    }
+
+    static constexpr std::array WATCH_ACCESS = { Breakpoints::Access::write,
+                                                 Breakpoints::Access::read,
+                                                 Breakpoints::Access::read_write };
+    // 0 and 1 are software and hardware breakpoints, 2 to 4 the watchpoints
+    if (*type > 4) {
+        return "";
+    }
+
+    if (!_breakpoints) {
+        if (!insert) {
+            return "OK";
+        }
+
+        _breakpoints.emplace(_cpu.get(), _bus.get());
+    }
+
+    uint16_t first = static_cast<uint16_t>(*address);
+    uint16_t last = static_cast<uint16_t>(*address + std::max<uint32_t>(*length, 1) - 1);
+    if (*type <= 1 && insert) {
+        _breakpoints->add_breakpoint(first);
+    } else if (*type <= 1) {
+        _breakpoints->remove_breakpoint(first);
+    } else if (insert) {
+        _breakpoints->add_watchpoint(first, last, WATCH_ACCESS[*type - 2]);
+    } else {
+        _breakpoints->remove_watchpoint(first, last);
+    }
+
+    // Detached again, so the guest runs at full speed
+    if (_breakpoints->empty()) {
+        _breakpoints.reset();
+    }
+
+    return "OK";
+}
+
+bool GdbStub::_fill()
+{
+    std::array<char, MAX_PACKET_SIZE> chunk;
+    while (true) {
+        ssize_t size = ::read(_input, chunk.data(), chunk.size());
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (size <= 0) {
+            return false;
+        }
+
+        _received.assign(chunk.data(), size);
+        _received_position = 0;
+        return true;
+    }
+}
+
+std::optional<char> GdbStub::_read_byte()
+{
+    if (_received_position == _received.size() && (_input < 0 || !_fill())) {
+        return std::nullopt;
+    }
+
+    return _received[_received_position++];
+}
+
+std::optional<std::string> GdbStub::_read_packet()
+{
+    while (std::optional<char> byte = _read_byte()) {
+        if (*byte == INTERRUPT) {
+            return std::string(1, INTERRUPT);
+        }
+
+        // Acknowledgements of our own packets and noise between packets
+        if (*byte != '$') {
+            continue;
+        }
+
+        std::string packet;
+        uint8_t checksum = 0;
+        std::optional<char> character;
+        while ((character = _read_byte()) && *character != '#') {
+            packet.push_back(*character);
+            checksum += static_cast<uint8_t>(*character);
+        }
+
+        std::optional<char> high = _read_byte();
+        std::optional<char> low = _read_byte();
+        if (!character || !high || !low) {
+            return std::nullopt;
+        }
+
+        std::optional<uint32_t> expected = parse_hex(std::string { *high, *low });
+        if (_acknowledge && expected != checksum) {
+            _send("-");
+            continue;
+        }
+
+        if (_acknowledge) {
+            _send("+");
+        }
+
+        return packet;
+    }
+
+    return std::nullopt;
+}
+
+void GdbStub::_send(std::string_view data)
+{
+    while (!data.empty() && _output >= 0) {
+        // Sockets must not raise SIGPIPE when the debugger goes away
+        ssize_t size = ::send(_output, data.data(), data.size(), MSG_NOSIGNAL);
+        if (size < 0 && errno == ENOTSOCK) {
+            size = ::write(_output, data.data(), data.size());
+        }
+
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (size <= 0) {
+            return;
+        }
+
+        data.remove_prefix(size);
+    }
+}
+
+void GdbStub::_send_packet(std::string_view data)
+{
+    uint8_t checksum = 0;
+    for (char character : data) {
+        checksum += static_cast<uint8_t>(character);
+    }
+
+    std::string packet = fmt::format("${}#{:02x}", data, checksum);
+    while (true) {
+        _send(packet);
+        if (!_acknowledge) {
+            return;
+        }
+
+        // Anything but a request to resend counts as received
+        std::optional<char> reply = _read_byte();
+        if (reply != '-') {
+            return;
+        }
+    }
+}
+
+void GdbStub::_disconnect()
+{
+    int input = _input.exchange(-1);
+    int output = _output.exchange(-1);
+
+    // Shutting a socket down also wakes up the background thread polling it
+    if (input >= 0) {
+        ::shutdown(input, SHUT_RDWR);
+        ::close(input);
+    }
+
+    if (output >= 0 && output != input) {
+        ::close(output);
+    }
+
+    _received.clear();
+    _received_position = 0;
+    _acknowledge = true;
+    _last_stop = SIGTRAP_STOP;
+    _breakpoints.reset();
+}
+} // namespace i8080
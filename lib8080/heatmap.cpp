@@ -0,0 +1,183 @@
+#include "heatmap.h"
+
+#include <fmt/format.h>
+#include <fmt/os.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace i8080
+{
+MemoryHeatmap::MemoryHeatmap()
+{
+    reset();
+}
+
+void MemoryHeatmap::track(uint16_t first, uint16_t last)
+{
+    if (_tracked.empty()) {
+        _tracked = std::vector<uint8_t>(Bus::ADDRESS_SPACE_SIZE, 0);
+        _addresses = std::vector<Counters>(Bus::ADDRESS_SPACE_SIZE);
+    }
+
+    for (uint32_t address = first; address <= last; address++) {
+        _tracked[address] = 1;
+    }
+}
+
+void MemoryHeatmap::close_window(uint64_t cycle)
+{
+    Window window { .first_cycle = _window_start,
+                    .last_cycle = cycle,
+                    .accesses = _window_accesses,
+                    .pages = 0,
+                    .code_pages = 0 };
+
+    for (size_t page = 0; page < Bus::PAGE_COUNT; page++) {
+        window.pages += (_window_accesses[page] != 0);
+        window.code_pages += _window_fetches[page];
+    }
+
+    _windows.push_back(window);
+    _window_accesses.fill(0);
+    _window_fetches.fill(false);
+    _window_start = cycle + 1;
+}
+
+MemoryHeatmap::Counters MemoryHeatmap::address(uint16_t address) const
+{
+    return _tracked.empty() ? Counters {} : _addresses[address];
+}
+
+void MemoryHeatmap::reset()
+{
+    _pages.fill({});
+    _window_accesses.fill(0);
+    _window_fetches.fill(false);
+    _window_start = 0;
+    _windows.clear();
+    std::ranges::fill(_addresses, Counters {});
+}
+
+std::string MemoryHeatmap::report(size_t top_pages) const
+{
+    fmt::memory_buffer out;
+    auto it = std::back_inserter(out);
+
+    std::vector<uint16_t> pages;
+    Counters total;
+    for (uint16_t page = 0; page < Bus::PAGE_COUNT; page++) {
+        if (_pages[page].total()) {
+            pages.push_back(page);
+            total.reads += _pages[page].reads;
+            total.writes += _pages[page].writes;
+            total.fetches += _pages[page].fetches;
+        }
+    }
+
+    size_t shown = std::min(top_pages, pages.size());
+    std::ranges::partial_sort(pages, pages.begin() + shown, [this](uint16_t a, uint16_t b) {
+        return _pages[a].total() > _pages[b].total();
+    });
+
+    fmt::format_to(it,
+                   "{} pages touched: {} reads, {} writes, {} fetches\n\n",
+                   pages.size(),
+                   total.reads,
+                   total.writes,
+                   total.fetches);
+
+    fmt::format_to(it, "{:<13} {:>14} {:>14} {:>14}\n", "page", "reads", "writes", "fetches");
+    for (size_t i = 0; i < shown; i++) {
+        const Counters& counters = _pages[pages[i]];
+        fmt::format_to(it,
+                       "{:#06x}-{:04x} {:>14} {:>14} {:>14}\n",
+                       pages[i] * Bus::PAGE_SIZE,
+                       pages[i] * Bus::PAGE_SIZE + Bus::PAGE_SIZE - 1,
+                       counters.reads,
+                       counters.writes,
+                       counters.fetches);
+    }
+
+    if (!_tracked.empty()) {
+        fmt::format_to(it,
+                       "\n{:<13} {:>14} {:>14} {:>14}\n",
+                       "address",
+                       "reads",
+                       "writes",
+                       "fetches");
+        for (size_t address = 0; address < Bus::ADDRESS_SPACE_SIZE; address++) {
+            const Counters& counters = _addresses[address];
+            if (_tracked[address] && counters.total()) {
+                fmt::format_to(it,
+                               "{:#06x}        {:>14} {:>14} {:>14}\n",
+                               address,
+                               counters.reads,
+                               counters.writes,
+                               counters.fetches);
+            }
+        }
+    }
+
+    if (!_windows.empty()) {
+        auto [smallest, largest] = std::ranges::minmax_element(_windows, {}, &Window::pages);
+        double average = 0;
+        for (const Window& window : _windows) {
+            average += static_cast<double>(window.pages) / _windows.size();
+        }
+
+        fmt::format_to(it,
+                       "\nworking set over {} windows: {} to {} pages, {:.1f} on average "
+                       "({} to {} bytes)\n",
+                       _windows.size(),
+                       smallest->pages,
+                       largest->pages,
+                       average,
+                       smallest->pages * Bus::PAGE_SIZE,
+                       largest->pages * Bus::PAGE_SIZE);
+    }
+
+    return fmt::to_string(out);
+}
+
+void MemoryHeatmap::write_heatmap(const std::filesystem::path& path) const
+{
+    auto file = fmt::output_file(path.string());
+
+    file.print("first_cycle,last_cycle,pages,code_pages");
+    for (size_t page = 0; page < Bus::PAGE_COUNT; page++) {
+        file.print(",{:#06x}", page * Bus::PAGE_SIZE);
+    }
+
+    file.print("\n");
+
+    auto print_row = [&file](const Window& window) {
+        file.print("{},{},{},{}",
+                   window.first_cycle,
+                   window.last_cycle,
+                   window.pages,
+                   window.code_pages);
+        for (uint32_t accesses : window.accesses) {
+            file.print(",{}", accesses);
+        }
+
+        file.print("\n");
+    };
+
+    if (!_windows.empty()) {
+        std::ranges::for_each(_windows, print_row);
+        return;
+    }
+
+    // Without windows the whole run is one row
+    Window whole { .first_cycle = 0, .last_cycle = 0, .accesses = {}, .pages = 0, .code_pages = 0 };
+    for (size_t page = 0; page < Bus::PAGE_COUNT; page++) {
+        uint64_t accesses = _pages[page].total();
+        whole.accesses[page] = static_cast<uint32_t>(std::min<uint64_t>(accesses, UINT32_MAX));
+        whole.pages += (accesses != 0);
+        whole.code_pages += (_pages[page].fetches != 0);
+    }
+
+    print_row(whole);
+}
+} // namespace i8080
@@ -0,0 +1,247 @@
+#include "imagecache.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace i8080
+{
+// Readable by every process on the host, written only through the publisher's descriptor
+static constexpr mode_t PUBLISHED_MODE = 0444;
+
+static constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+static constexpr uint64_t FNV_PRIME = 0x100000001b3;
+
+static size_t host_page_size()
+{
+    static const size_t page_size = sysconf(_SC_PAGESIZE);
+    return page_size;
+}
+
+static size_t round_up(size_t size, size_t page_size)
+{
+    return (size + page_size - 1) / page_size * page_size;
+}
+
+// FNV-1a, only to name the objects: their content is compared before they are used
+static uint64_t content_hash(std::span<const uint8_t> data)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (uint8_t byte : data) {
+        hash = (hash ^ byte) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+static bool write_all(int fd, const buffer& content)
+{
+    if (ftruncate(fd, content.size()) != 0) {
+        return false;
+    }
+
+    for (size_t offset = 0; offset < content.size();) {
+        ssize_t written = pwrite(fd, content.data() + offset, content.size() - offset, offset);
+        if (written < 0 && errno != EINTR) {
+            return false;
+        }
+
+        offset += std::max<ssize_t>(written, 0);
+    }
+
+    return true;
+}
+
+// Whether a published object is complete and holds the content, rather than being half written
+// by its publisher or another image with the same hash
+static bool holds(int fd, const buffer& content)
+{
+    struct stat status;
+    if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) != content.size()) {
+        return false;
+    }
+
+    void* pages = mmap(nullptr, content.size(), PROT_READ, MAP_SHARED, fd, 0);
+    if (pages == MAP_FAILED) {
+        return false;
+    }
+
+    bool equal = std::memcmp(pages, content.data(), content.size()) == 0;
+    munmap(pages, content.size());
+    return equal;
+}
+
+// A descriptor of the published object with the content, or -1 when there is none to use
+static int open_published(const std::string& name, const buffer& content)
+{
+    // A second round when another process creates the object between the two opens
+    for (int attempt = 0; attempt < 2; attempt++) {
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd >= 0) {
+            if (holds(fd, content)) {
+                return fd;
+            }
+
+            close(fd);
+            return -1;
+        }
+
+        if (errno != ENOENT) {
+            return -1;
+        }
+
+        fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, PUBLISHED_MODE);
+        if (fd >= 0) {
+            if (write_all(fd, content)) {
+                return fd;
+            }
+
+            close(fd);
+            shm_unlink(name.c_str());
+            return -1;
+        }
+
+        if (errno != EEXIST) {
+            return -1;
+        }
+    }
+
+    return -1;
+}
+
+SharedImage::SharedImage(int fd, std::string name, uint16_t base, size_t size, bool shared) :
+    _fd(fd),
+    _name(std::move(name)),
+    _base(base),
+    _size(size),
+    _shared(shared)
+{}
+
+SharedImage::~SharedImage()
+{
+    close(_fd);
+}
+
+GuestMemory::GuestMemory() :
+    _memory(nullptr),
+    _mapped_size(round_up(Bus::MEMORY_SIZE, host_page_size()))
+{
+    void* memory = mmap(nullptr,
+                        _mapped_size,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS,
+                        -1,
+                        0);
+    if (memory == MAP_FAILED) {
+        throw std::runtime_error(fmt::format("Could not map {} bytes of guest memory: {}",
+                                             _mapped_size,
+                                             std::strerror(errno)));
+    }
+
+    _memory = static_cast<uint8_t*>(memory);
+}
+
+GuestMemory::~GuestMemory()
+{
+    munmap(_memory, _mapped_size);
+}
+
+void GuestMemory::map(const SharedImage& image)
+{
+    void* pages = mmap(_memory + image._base,
+                       image._size,
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_FIXED,
+                       image._fd,
+                       0);
+    if (pages == MAP_FAILED) {
+        throw std::runtime_error(
+            fmt::format("Could not map image {}: {}", image._name, std::strerror(errno)));
+    }
+
+    if (image._base < Bus::MIRROR_SIZE) {
+        std::copy_n(_memory, Bus::MIRROR_SIZE, _memory + Bus::ADDRESS_SPACE_SIZE);
+    }
+}
+
+ImageCache::ImageCache(std::string prefix) :
+    _prefix(std::move(prefix))
+{
+    if (_prefix.size() < 2 || _prefix.front() != '/' || _prefix.find('/', 1) != std::string::npos) {
+        throw std::runtime_error(fmt::format("Invalid shared memory prefix: {}", _prefix));
+    }
+}
+
+std::shared_ptr<const SharedImage> ImageCache::publish(std::span<const uint8_t> data,
+                                                       uint16_t origin)
+{
+    if (data.empty() || origin + data.size() > Bus::ADDRESS_SPACE_SIZE) {
+        throw std::runtime_error(
+            fmt::format("Image of {} bytes at 0x{:04x} does not fit in the address space",
+                        data.size(),
+                        origin));
+    }
+
+    size_t page_size = host_page_size();
+    uint16_t base = origin / page_size * page_size;
+    buffer content(round_up(origin - base + data.size(), page_size));
+    std::ranges::copy(data, content.begin() + (origin - base));
+
+    std::string name =
+        fmt::format("{}{:016x}-{:04x}-{:x}", _prefix, content_hash(data), origin, data.size());
+
+    std::lock_guard lock(_lock);
+    if (auto found = _images.find(name); found != _images.end()) {
+        if (std::shared_ptr<const SharedImage> image = found->second.lock()) {
+            return image;
+        }
+    }
+
+    int fd = open_published(name, content);
+    bool shared = (fd >= 0);
+    if (!shared) {
+        fd = memfd_create(name.c_str() + 1, MFD_CLOEXEC);
+        if (fd < 0 || !write_all(fd, content)) {
+            if (fd >= 0) {
+                close(fd);
+            }
+
+            throw std::runtime_error(
+                fmt::format("Could not create image {}: {}", name, std::strerror(errno)));
+        }
+    }
+
+    auto image = std::make_shared<const SharedImage>(fd, name, base, content.size(), shared);
+    _images[name] = image;
+    return image;
+}
+
+std::shared_ptr<const SharedImage> ImageCache::load(const std::filesystem::path& path,
+                                                    uint16_t origin)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error(fmt::format("Could not open file: {}", path.string()));
+    }
+
+    buffer data(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char> {});
+    return publish(data, origin);
+}
+
+void ImageCache::unpublish(const SharedImage& image)
+{
+    if (image.shared()) {
+        shm_unlink(image.name().c_str());
+    }
+}
+} // namespace i8080
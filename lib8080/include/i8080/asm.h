@@ -1,5 +1,7 @@
 #pragma once
 
+#include <fmt/format.h>
+
 #include <array>
 #include <cstdint>
 #include <string>
@@ -262,7 +264,7 @@ static const std::array<OpcodeMetadata, 256> METADATA = {
     {"RZ", 1, 5},
     {"RET", 1, 10},
     {"JZ", 3, 10},
-    {"NOP6", 1, 10},
+    {"NOP6", 3, 10},
     {"CZ", 3, 11},
     {"CALL", 3, 17},
     {"ACI", 2, 7},
@@ -280,7 +282,7 @@ static const std::array<OpcodeMetadata, 256> METADATA = {
     {"JC", 3, 10},
     {"IN", 2, 10},
     {"CC", 3, 11},
-    {"NOP8", 1, 17},
+    {"NOP8", 3, 17},
     {"SBI", 2, 7},
     {"RST 3", 1, 11},
     {"RPO", 1, 5},
@@ -296,7 +298,7 @@ static const std::array<OpcodeMetadata, 256> METADATA = {
     {"JPE", 3, 10},
     {"XCHG", 1, 4},
     {"CPE", 3, 11},
-    {"NOP9", 1, 17},
+    {"NOP9", 3, 17},
     {"XRI", 2, 7},
     {"RST 5", 1, 11},
     {"RP", 1, 5},
@@ -312,7 +314,7 @@ static const std::array<OpcodeMetadata, 256> METADATA = {
     {"JM", 3, 10},
     {"EI", 1, 4},
     {"CM", 3, 11},
-    {"NOP10", 1, 17},
+    {"NOP10", 3, 17},
     {"CPI", 2, 7},
     {"RST 7", 1, 11}
 };
@@ -328,8 +330,26 @@ struct Opcode
     };
 } __attribute__((packed));
 
+// Where an instruction can send the PC. Conditional jumps, calls and returns count as the
+// transfer they may take, and RST as a call.
+enum class ControlFlow : uint8_t
+{
+    next,
+    jump,
+    call,
+    ret,
+    pchl,
+    halt
+};
+
 uint8_t isr_offset(Instruction instruction);
 Instruction isr_to_rst(uint8_t isr_number);
+// Both also know the undocumented aliases of JMP, RET and CALL
+ControlFlow get_control_flow(Instruction instruction);
+bool is_branch(Instruction instruction);
+bool is_conditional(Instruction instruction);
 void print_dissassembly(const Opcode& opcode, uint16_t pc);
+// Appends the line print_dissassembly prints
+void format_dissassembly(fmt::memory_buffer& out, const Opcode& opcode, uint16_t pc);
 const OpcodeMetadata& get_opcode_metadata(Instruction instruction);
 }
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "bus.h"
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace i8080
+{
+// The base cycles and instruction counts of the basic blocks fast timing runs, measured the first
+// time a block is entered and kept by the address it starts at. A block ends after anything that
+// can branch, halt or reach a device, or before an instruction that would leave its page, and a
+// write over the bytes of any measured block makes every block of that page stale. A page whose
+// code is rewritten while one of its blocks runs is left to run an instruction at a time.
+// Attaches itself to the bus, one per bus.
+class BlockCosts final
+{
+public:
+    struct Block
+    {
+        uint16_t cycles;
+        // 0 when the instructions at the address must run one at a time
+        uint16_t instructions;
+    };
+
+    explicit BlockCosts(Bus& bus);
+    ~BlockCosts();
+
+    BlockCosts(const BlockCosts&) = delete;
+    BlockCosts& operator=(const BlockCosts&) = delete;
+
+    // The block at the address, measured again if its page's code was written since
+    Block get(uint16_t address)
+    {
+        const Page& page = _pages[address / Bus::PAGE_SIZE];
+        const Entry& entry = (*page.entries)[address % Bus::PAGE_SIZE];
+        if (entry.generation != page.generation) [[unlikely]] {
+            _misses++;
+            return _measure(address);
+        }
+
+        _hits++;
+        return entry.block;
+    }
+
+    // Lookups by get() that found their block measured, and ones that measured it
+    uint64_t hits() const { return _hits; }
+    uint64_t misses() const { return _misses; }
+
+    // The block at the address as it was last measured, even if its page was written since
+    Block measured(uint16_t address) const
+    {
+        return (*_pages[address / Bus::PAGE_SIZE].entries)[address % Bus::PAGE_SIZE].block;
+    }
+
+    // Changes whenever code on the page is written
+    uint32_t generation(uint8_t page) const { return _pages[page].generation; }
+
+    // For a page whose code was written while one of its blocks ran
+    void set_volatile(uint8_t page);
+
+    // Called by the bus for writes to pages holding measured blocks
+    void written(uint16_t address)
+    {
+        Page& page = _pages[address / Bus::PAGE_SIZE];
+        if (page.code.test(address % Bus::PAGE_SIZE)) {
+            page.generation++;
+            page.code.reset();
+        }
+    }
+
+    // Called by the bus when memory was changed other than through it
+    void written_all();
+
+private:
+    struct Entry
+    {
+        Block block;
+        // Of the page when the block was measured
+        uint32_t generation;
+    };
+
+    using Entries = std::array<Entry, Bus::PAGE_SIZE>;
+
+    struct Page
+    {
+        // Starts at 1, so no entry is valid before it is measured
+        uint32_t generation = 1;
+        // Allocated when a block on the page is first measured, until then entries that are
+        // never valid
+        const Entries* entries = &UNMEASURED;
+        // The bytes of the blocks measured in this generation
+        std::bitset<Bus::PAGE_SIZE> code;
+        bool is_volatile = false;
+    };
+
+    static const Entries UNMEASURED;
+
+    Block _measure(uint16_t address);
+
+    std::reference_wrapper<Bus> _bus;
+    std::array<Page, Bus::PAGE_COUNT> _pages;
+    std::array<std::unique_ptr<Entries>, Bus::PAGE_COUNT> _entries;
+    uint64_t _hits = 0;
+    uint64_t _misses = 0;
+};
+} // namespace i8080
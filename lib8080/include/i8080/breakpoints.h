@@ -0,0 +1,141 @@
+#pragma once
+
+#include "bus.h"
+#include "cpu.h"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace i8080
+{
+// An expression over registers, flags and memory that a breakpoint or watchpoint only stops on
+// while it is non-zero, e.g. "a == 0x12 && [hl] != 0" or "value > 0x7f || carry".
+//
+// Operands are numbers (decimal or 0x hex), the registers a b c d e h l bc de hl sp pc, the
+// flags zero carry sign parity aux, `value` for the byte a watchpoint saw, and [expression] for
+// the byte at an address. Operators are, loosest first: || && == != < <= > >= + - & | ^ and the
+// unary ! and -, with parentheses for grouping.
+class Condition final
+{
+public:
+    struct Context
+    {
+        const Cpu::State& state;
+        Bus& bus;
+        uint8_t value;
+    };
+
+    // Throws std::runtime_error on a syntax error
+    explicit Condition(std::string_view source);
+
+    bool operator()(const Context& context) const { return _evaluate(context) != 0; }
+
+    const std::string& source() const { return _source; }
+
+    using Evaluator = std::function<int64_t(const Context&)>;
+
+private:
+    std::string _source;
+    Evaluator _evaluate;
+};
+
+// Breakpoints on instruction addresses and watchpoints on memory ranges for one CPU and its bus.
+// Both stay off the fast paths: the CPU only looks a breakpoint up for instructions on a page
+// that has one, and only watched pages take the bus' flagged page path. Conditions are evaluated
+// once the address matches.
+//
+// Breakpoints stop Cpu::run() with StopReason::breakpoint before the instruction executes, and
+// calling it again carries on past the breakpoint. Watchpoints stop it with StopReason::stop
+// after the instruction making the access, or at the end of a native block. Instructions
+// executed by calling tick() directly are not checked for breakpoints.
+class Breakpoints final
+{
+public:
+    enum class Access : uint8_t
+    {
+        read = 1 << 0,
+        write = 1 << 1,
+        read_write = read | write
+    };
+
+    struct Hit
+    {
+        enum class Kind : uint8_t
+        {
+            breakpoint,
+            read,
+            write
+        };
+
+        Kind kind;
+        // The breakpoint, or the watched byte that was accessed
+        uint16_t address;
+        // The byte read or written, zero for breakpoints
+        uint8_t value;
+        uint16_t pc;
+        uint64_t cycle;
+    };
+
+    // Attaches to the CPU and the bus until destroyed
+    Breakpoints(Cpu& cpu, Bus& bus);
+    ~Breakpoints();
+
+    Breakpoints(const Breakpoints&) = delete;
+    Breakpoints& operator=(const Breakpoints&) = delete;
+
+    void add_breakpoint(uint16_t address, std::optional<Condition> condition = std::nullopt);
+    void remove_breakpoint(uint16_t address);
+
+    // Watches every byte of [first, last]
+    void add_watchpoint(uint16_t first,
+                        uint16_t last,
+                        Access access,
+                        std::optional<Condition> condition = std::nullopt);
+    void remove_watchpoint(uint16_t first, uint16_t last);
+
+    void clear();
+
+    bool empty() const { return _breakpoints.empty() && _watchpoints.empty(); }
+
+    // What stopped the CPU last
+    const std::optional<Hit>& last_hit() const { return _last_hit; }
+
+    // The last hit if it was not taken yet
+    std::optional<Hit> take_hit() { return std::exchange(_last_hit, std::nullopt); }
+
+    // Whether any breakpoint is on the address' page
+    bool marked(uint16_t address) const { return _page_breakpoints[address / Bus::PAGE_SIZE]; }
+
+    // Called by the CPU for instructions on marked pages
+    bool hit(const Cpu::State& state);
+
+    // Called by the bus for accesses to watched pages
+    void watch(Access access, uint16_t address, uint8_t value);
+
+private:
+    struct Watchpoint
+    {
+        uint16_t first;
+        uint16_t last;
+        Access access;
+        std::optional<Condition> condition;
+    };
+
+    void _update_watched_pages();
+
+    std::reference_wrapper<Cpu> _cpu;
+    std::reference_wrapper<Bus> _bus;
+
+    std::map<uint16_t, std::optional<Condition>> _breakpoints;
+    std::array<uint16_t, Bus::PAGE_COUNT> _page_breakpoints = {};
+    std::vector<Watchpoint> _watchpoints;
+    std::optional<Hit> _last_hit;
+};
+} // namespace i8080
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <span>
+#include <vector>
 
 #include "asm.h"
 #include "common.h"
@@ -8,12 +10,48 @@
 
 namespace i8080
 {
+class BlockCosts;
+class Breakpoints;
+class MemoryHeatmap;
+class Metrics;
+
+struct MemoryWrite
+{
+    uint16_t address;
+    uint8_t value;
+
+    bool operator==(const MemoryWrite&) const = default;
+};
+
+using WriteJournal = std::vector<MemoryWrite>;
+
 class Bus final
 {
 public:
-    Bus(buffer& memory) :
-        _memory(memory)
-    {}
+    static constexpr size_t PORT_COUNT = 256;
+    static constexpr size_t ADDRESS_SPACE_SIZE = 0x10000;
+    static constexpr uint16_t PAGE_SIZE = 0x100;
+    static constexpr size_t PAGE_COUNT = ADDRESS_SPACE_SIZE / PAGE_SIZE;
+    // The first bytes of memory are mirrored past the end of the address space, so fetching an
+    // instruction or reading a word at the top wraps around to 0 without a check
+    static constexpr size_t MIRROR_SIZE = sizeof(Opcode) - 1;
+    // The smallest memory a bus takes
+    static constexpr size_t MEMORY_SIZE = ADDRESS_SPACE_SIZE + MIRROR_SIZE;
+
+    enum PageFlags : uint8_t
+    {
+        // Accessed atomically, for memory shared between CPUs running on different threads
+        page_shared = 1 << 0,
+        // Accesses are counted into the heatmap
+        page_counted = 1 << 1,
+        // Accesses are checked against the watchpoints
+        page_watched = 1 << 2,
+        // Holds blocks measured for fast timing, which writes make stale. Reads ignore it.
+        page_code = 1 << 3,
+    };
+
+    // The memory must outlive the bus, and a buffer must not be resized while the bus uses it
+    Bus(std::span<uint8_t> memory);
 
     Bus(const Bus&) = delete;
     Bus& operator=(const Bus&) = delete;
@@ -29,10 +67,68 @@ public:
 
     void mem_read(uint16_t address, uint8_t& byte);
     void mem_read(uint16_t address, uint16_t& word);
+    // Writes through the reference bypass the mirror, so call sync_mirror() after them
     uint8_t& mem_read_u8_ref(uint16_t address);
 
+    // Copies the start of memory to the mirror, after writing to it other than through the bus.
+    // Every measured block is made stale too.
+    void sync_mirror();
+
+    // Every memory write is appended to the journal while one is set
+    void set_write_journal(WriteJournal* journal) { _journal = journal; }
+
+    // Counts port reads and writes into the metrics while set
+    void set_metrics(Metrics* metrics) { _metrics = metrics; }
+
+    // Counts every memory access into the heatmap while one is set. Data accesses go through the
+    // flagged page path, so only fetches pay for a check when no heatmap is set.
+    void set_heatmap(MemoryHeatmap* heatmap);
+
+    // Reports accesses to pages flagged as watched to the watchpoints while set. Unsetting them
+    // clears every watched flag.
+    void set_breakpoints(Breakpoints* breakpoints);
+
+    // Reports writes to pages flagged as code to the block costs while set. Unsetting them
+    // clears every code flag.
+    void set_block_costs(BlockCosts* block_costs);
+
+    // Accesses to the page are atomic from now on, for memory shared with CPUs on other threads
+    void share_page(uint8_t page) { _page_flags[page] |= page_shared; }
+
+    uint8_t page_flags(uint8_t page) const { return _page_flags[page]; }
+
 private:
-    std::reference_wrapper<buffer> _memory;
-    std::array<Device::sptr, 8> _devices;
+    // Only what a flag reports to sets it, and only while attached, so _load() and _store() can
+    // call through the flag without a null check
+    friend class BlockCosts;
+    friend class Breakpoints;
+
+    void set_page_flags(uint8_t page, uint8_t flags) { _page_flags[page] |= flags; }
+
+    void clear_page_flags(uint8_t page, uint8_t flags) { _page_flags[page] &= ~flags; }
+
+    void _clear_all_pages(uint8_t flags);
+
+    static constexpr uint8_t READ_FLAGS = page_shared | page_counted | page_watched;
+
+    static uint8_t _page(uint16_t address) { return address / PAGE_SIZE; }
+
+    // Where the other copy of a mirrored byte lives, the address itself for the rest
+    static size_t _mirror(uint16_t address)
+    {
+        return (address < MIRROR_SIZE) ? ADDRESS_SPACE_SIZE + address : address;
+    }
+
+    uint8_t _load(uint16_t address) const;
+    void _store(uint16_t address, uint8_t byte);
+
+    std::span<uint8_t> _memory;
+    std::array<Device::sptr, PORT_COUNT> _devices;
+    std::array<uint8_t, PAGE_COUNT> _page_flags = {};
+    WriteJournal* _journal = nullptr;
+    MemoryHeatmap* _heatmap = nullptr;
+    Metrics* _metrics = nullptr;
+    Breakpoints* _breakpoints = nullptr;
+    BlockCosts* _block_costs = nullptr;
 };
 } // namespace i8080
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "asm.h"
+#include "cpu.h"
+#include "symbols.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace i8080
+{
+// Keeps a shadow call stack from the CPU's calls, returns and interrupts, and attributes cycles
+// to the functions on it. Inclusive cycles count the function and everything it calls,
+// exclusive cycles only its own instructions.
+//
+// Frames are tracked by the SP at which their return address was pushed, and the stack is only
+// trusted as far as the guest SP agrees with it. A RET that pops a slot below the top frame
+// (PUSH H; RET used as a jump) leaves the shadow stack alone, and one that pops a slot at or
+// above it unwinds every frame up to that slot, as does a call made from a shallower SP. This
+// keeps the stack in step through XTHL, SPHL and return addresses popped or rewritten by hand.
+class CallGraph final
+{
+public:
+    struct Function
+    {
+        uint64_t calls = 0;
+        // Recursive calls are only counted once, at the outermost activation
+        uint64_t inclusive = 0;
+        uint64_t exclusive = 0;
+    };
+
+    struct Arc
+    {
+        uint64_t calls = 0;
+        uint64_t inclusive = 0;
+    };
+
+    // The root frame is the code running at the given state
+    explicit CallGraph(const Cpu::State& state);
+
+    // Fed by the CPU after each instruction, with the SP from before it
+    void observe(Instruction instruction, uint16_t previous_sp, const Cpu::State& state);
+
+    // Fed by the CPU after dispatching an interrupt to the vector
+    void interrupt(uint16_t vector, const Cpu::State& state);
+
+    // Closes every frame, including the root, as of the given cycle
+    void finish(uint64_t cycle);
+
+    // Entry addresses of the active frames, outermost first
+    void frames(std::vector<uint16_t>& frames) const;
+
+    size_t depth() const { return _stack.size(); }
+
+    const std::unordered_map<uint16_t, Function>& functions() const { return _functions; }
+
+    // Keyed by (caller, callee)
+    const std::map<std::pair<uint16_t, uint16_t>, Arc>& arcs() const { return _arcs; }
+
+    // Functions by inclusive cycles, each with its callers and callees
+    std::string report(const SymbolTable& symbols) const;
+
+    // Callgrind profile data, as read by KCachegrind and gprof2dot
+    std::string callgrind(const SymbolTable& symbols) const;
+
+private:
+    struct Frame
+    {
+        uint16_t function;
+        // Where the return address lives; wider than an address so the root is above them all
+        uint32_t sp;
+        uint64_t entry_cycle;
+        uint64_t children;
+    };
+
+    static constexpr uint32_t ROOT_SP = 0x10000;
+
+    void _push(uint16_t function, uint16_t sp, uint64_t cycle);
+    void _pop(uint64_t cycle);
+    void _unwind_to(uint32_t sp, uint64_t cycle);
+
+    std::vector<Frame> _stack;
+    // Activations per function on the stack, to spot recursion
+    std::unordered_map<uint16_t, uint32_t> _active;
+    std::unordered_map<uint16_t, Function> _functions;
+    std::map<std::pair<uint16_t, uint16_t>, Arc> _arcs;
+};
+} // namespace i8080
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "bus.h"
+#include "common.h"
+#include "cpu.h"
+#include "model.h"
+
+#include <optional>
+#include <string>
+
+namespace i8080
+{
+// Runs the reference model and a candidate CPU in lockstep, each over its own copy of the image,
+// and reports the first step after which their state or memory writes differ. The candidate is
+// the interpreter in either timing, with recompiled code when it is given some.
+class CoSimulator final
+{
+public:
+    enum class Granularity : uint8_t
+    {
+        // One instruction on each side
+        instruction,
+        // Whatever the candidate runs in one go: a recompiled block, a block in fast timing or
+        // an instruction, and as many instructions on the model. Interrupts are only raised
+        // between instructions at instruction granularity.
+        block
+    };
+
+    struct Divergence
+    {
+        uint64_t step;
+        uint16_t pc;
+        std::string description;
+    };
+
+    // Cycles are only compared in exact timing
+    CoSimulator(const buffer& image,
+                const Cpu::State& initial_state,
+                Cpu::Timing timing = Cpu::Timing::exact,
+                Cpu::NativeCode native_code = nullptr);
+    CoSimulator(const CoSimulator&) = delete;
+    CoSimulator& operator=(const CoSimulator&) = delete;
+
+    std::optional<Divergence> step(Granularity granularity = Granularity::instruction);
+    std::optional<Divergence> run(uint64_t steps,
+                                  Granularity granularity = Granularity::instruction);
+
+    void interrupt(uint8_t isr_number);
+
+    const ReferenceModel& reference() const { return _reference; }
+
+    const Cpu& candidate() const { return _candidate; }
+
+    uint64_t steps() const { return _steps; }
+
+private:
+    struct Memory
+    {
+        // The bus points at the bytes and the journal, so the memory stays where it was built
+        explicit Memory(const buffer& image);
+        Memory(const Memory&) = delete;
+        Memory& operator=(const Memory&) = delete;
+
+        buffer bytes;
+        Bus bus;
+        WriteJournal journal;
+    };
+
+    static void _compare_states(const Cpu::State& reference,
+                                const Cpu::State& candidate,
+                                bool compare_cycles,
+                                std::string& description);
+    static void _compare_journals(const WriteJournal& reference,
+                                  const WriteJournal& candidate,
+                                  std::string& description);
+
+    Memory _reference_memory;
+    ReferenceModel _reference;
+    Memory _candidate_memory;
+    Cpu _candidate;
+    bool _compare_cycles;
+    uint64_t _steps;
+};
+
+struct RandomScenario
+{
+    buffer image;
+    Cpu::State state;
+};
+
+// Fills the whole address space with a random stream of valid instructions and picks a random
+// register file. The same seed always produces the same scenario.
+RandomScenario make_random_scenario(uint64_t seed);
+
+// Runs a random scenario for the given number of steps, injecting random interrupts on the way.
+// Steps are instructions in exact timing and blocks in fast timing.
+std::optional<CoSimulator::Divergence> fuzz(uint64_t seed,
+                                            uint64_t steps,
+                                            Cpu::Timing timing = Cpu::Timing::exact);
+} // namespace i8080
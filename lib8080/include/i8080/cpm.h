@@ -0,0 +1,127 @@
+#pragma once
+
+#include "bus.h"
+#include "cpu.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <istream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace i8080
+{
+// Enough of CP/M 2.2 to run .COM programs against a host directory. Page zero, the BDOS entry
+// and the BIOS jump table are stubs that hand every call to host code through an OUT, so BDOS
+// and BIOS calls cost a few guest instructions. Files are matched case-insensitively to the host
+// files in the directory, whatever the drive. A file is read whole when it is first opened and
+// written back when it is closed or the program ends, so record I/O never reaches the host.
+//
+// A program ends by jumping to 0, returning from its entry point or calling BDOS function 0;
+// that halts the CPU.
+class Cpm final
+{
+public:
+    // BDOS calls go to this port and the 17 BIOS entries to the ones after it
+    static constexpr uint8_t DEFAULT_PORT = 0xe0;
+    static constexpr uint16_t BDOS_ENTRY = 0xfd00;
+    static constexpr uint16_t BIOS_BASE = 0xfe00;
+    static constexpr uint16_t PROGRAM_START = 0x100;
+    static constexpr uint16_t DEFAULT_DMA = 0x80;
+    static constexpr size_t RECORD_SIZE = 128;
+
+    using Sink = std::function<void(std::string_view)>;
+
+    struct Config
+    {
+        std::filesystem::path directory = ".";
+        // The command tail, also parsed into the default FCBs at 0x5c and 0x6c
+        std::vector<std::string> arguments;
+        // Console output, stdout when not set
+        Sink console;
+        // Console input, which reads as ^Z when not set or at its end
+        std::istream* input = nullptr;
+        uint8_t port = DEFAULT_PORT;
+    };
+
+    // Installs page zero, the stubs and the command tail into memory, registers the ports and
+    // points the CPU at the program with a return to warm boot on its stack
+    Cpm(Cpu& cpu, Bus& bus, Config config);
+    ~Cpm();
+
+    Cpm(const Cpm&) = delete;
+    Cpm& operator=(const Cpm&) = delete;
+
+    bool exited() const { return _exited; }
+
+    // Writes every modified file back to the host
+    void flush();
+
+private:
+    class Port;
+
+    struct File
+    {
+        std::filesystem::path path;
+        std::vector<uint8_t> data;
+        bool dirty = false;
+    };
+
+    void _install();
+    void _bdos(uint8_t function);
+    void _bios(uint8_t entry, uint8_t argument);
+    void _exit();
+
+    // BDOS results go to A and L, and their high byte to B and H
+    void _return(uint16_t value);
+    // BIOS results only go to A
+    void _set_accumulator(uint8_t value);
+
+    void _console_output(char character);
+    char _console_input();
+    bool _console_ready();
+    void _print_string(uint16_t address);
+    void _read_line(uint16_t address);
+
+    // The 11 upper case characters of the name and type, with attribute bits cleared
+    std::string _fcb_key(uint16_t fcb) const;
+    // Host files whose names match the key, with ? as a wildcard
+    std::vector<std::filesystem::path> _find(std::string_view key) const;
+    File* _open(uint16_t fcb, bool create);
+
+    uint8_t _open_file(uint16_t fcb);
+    uint8_t _close_file(uint16_t fcb);
+    uint8_t _search(uint16_t fcb, bool first);
+    uint8_t _delete_file(uint16_t fcb);
+    uint8_t _make_file(uint16_t fcb);
+    uint8_t _rename_file(uint16_t fcb);
+    uint8_t _read(File& file, uint32_t record);
+    uint8_t _write(File& file, uint32_t record);
+    uint8_t _transfer(uint16_t fcb, bool write, bool random);
+    void _file_size(uint16_t fcb);
+    void _set_random_record(uint16_t fcb);
+
+    uint32_t _sequential_record(uint16_t fcb) const;
+    void _set_sequential_record(uint16_t fcb, uint32_t record);
+
+    uint8_t& _byte(uint16_t address) { return _bus.get().mem_read_u8_ref(address); }
+
+    uint8_t _byte(uint16_t address) const { return _bus.get().mem_read_u8_ref(address); }
+
+    std::reference_wrapper<Cpu> _cpu;
+    std::reference_wrapper<Bus> _bus;
+    Config _config;
+
+    uint16_t _dma;
+    uint8_t _drive;
+    bool _exited;
+
+    // Open files by their FCB key
+    std::map<std::string, File> _files;
+    std::vector<std::filesystem::path> _search_results;
+    size_t _search_position;
+};
+} // namespace i8080
@@ -1,13 +1,24 @@
 #pragma once
 
 #include "asm.h"
+#include "blockcosts.h"
 #include "bus.h"
 
-#include <limits>
+#ifdef I8080_PROFILING
+#include "profile.h"
+#endif
+
+#include <functional>
+#include <memory>
 #include <optional>
 
 namespace i8080
 {
+class Breakpoints;
+class CallGraph;
+class Metrics;
+class Tracer;
+
 class Cpu final
 {
     struct Flags
@@ -41,8 +52,6 @@ class Cpu final
     }
 
 public:
-    static constexpr uint16_t NAMESPACE_SIZE = std::numeric_limits<uint16_t>::max();
-
     struct State
     {
         union
@@ -72,28 +81,122 @@ public:
 
 #undef DEFINE_REGISTER
 
+    enum class StopReason : uint8_t
+    {
+        cycles,
+        halt,
+        stop,
+        breakpoint
+    };
+
+    // How cycles are counted, fixed when the CPU is constructed
+    enum class Timing : uint8_t
+    {
+        // Taken conditional calls and returns cost their extra cycles, and devices see IN and OUT
+        // at the cycle their I/O machine cycle starts
+        exact,
+        // Every instruction costs its base cycles, so taken conditional calls and returns are
+        // undercounted. run() charges each basic block its precomputed cost when entering it,
+        // so devices see I/O at the end of the instruction, and only checks its budget and
+        // stop() between blocks.
+        fast
+    };
+
+    using InterruptCallback = std::function<void(Instruction)>;
+
+    // Recompiled code for the program in memory: runs the basic block at the state's PC and
+    // returns the number of instructions it retired, or 0 when there is no block there
+    using NativeCode = uint32_t (*)(State& state, Bus& bus);
+
+    // The flags bits that exist, and bit 1, which always reads as set
+    static constexpr uint8_t FLAGS_USED = 0xd5;
+    static constexpr uint8_t FLAGS_SET = 0x02;
+
 public:
-    Cpu(Bus& bus, uint16_t entry_point);
+    Cpu(Bus& bus, uint16_t entry_point, Timing timing = Timing::exact);
     Cpu(const Cpu&) = delete;
     Cpu& operator=(const Cpu&) = delete;
 
+    Timing timing() const { return _timing; }
+
     void set_debug(bool debug) { _debug = debug; }
 
+    // Records every executed instruction while set, far cheaper than set_debug
+    void set_tracer(Tracer* tracer) { _tracer = tracer; }
+
+    // Counts halts and interrupts into the metrics while set, and publishes the retired
+    // instructions and cycles whenever run() returns
+    void set_metrics(Metrics* metrics) { _metrics = metrics; }
+
+    // For callers driving the CPU with tick() rather than run()
+    void publish_metrics() const;
+
+    // Instructions executed so far
+    uint64_t retired() const { return _retired; }
+
+    // Tracks calls, returns and interrupts into the call graph while set
+    void set_call_graph(CallGraph* call_graph) { _call_graph = call_graph; }
+
+    // run() executes blocks of native code wherever it has them and interprets everything else.
+    // Tracers, call graphs, profiles and debug output only see the interpreted instructions, and
+    // interrupts are dispatched between blocks. Blocks count cycles exactly whatever the timing.
+    void set_native_code(NativeCode code) { _native_code = code; }
+
+    // run() stops before instructions with a breakpoint while set. Native blocks are only used
+    // on pages without one.
+    void set_breakpoints(Breakpoints* breakpoints) { _breakpoints = breakpoints; }
+
     const State& state() const { return _state; }
 
+    void set_state(const State& state) { _state = state; }
+
     void tick();
 
+    // Executes whole instructions until at least the given number of cycles have passed, the CPU
+    // halts or stop() is called, e.g. by a device
+    StopReason run(uint64_t cycles);
+    void stop() { _stop_requested = true; }
+
+    // Drops a stop() no run() has returned for yet, e.g. one requested during tick()
+    void clear_stop() { _stop_requested = false; }
+
     bool halt() const { return _state.halt; }
 
+    // Ignored while interrupts are disabled. Taken after the current instruction, or right away
+    // when halted, which wakes the CPU.
     void interrupt(Instruction instruction);
     void interrupt(uint8_t isr_number);
 
+#ifdef I8080_PROFILING
+    // Counts every executed instruction into the profile while one is set
+    void set_profile(OpcodeProfile* profile) { _profile = profile; }
+#endif
+
+    // Called when a pending interrupt is dispatched
+    void set_interrupt_callback(InterruptCallback callback)
+    {
+        _interrupt_callback = std::move(callback);
+    }
+
 private:
     static constexpr uint8_t CONDITION_MET_CYCLE_COUNT = 6;
+    // IN and OUT reach the bus after their opcode fetch and operand read
+    static constexpr uint8_t IO_ACCESS_CYCLE = 7;
 
     static bool _get_parity(uint16_t number);
     const Opcode& _fetch() const;
-    void _execute(const Opcode& opcode);
+    StopReason _run(uint64_t cycles);
+    StopReason _run_fast(uint64_t cycles);
+    StopReason _run_native(uint64_t cycles);
+    StopReason _run_breakpoints(uint64_t cycles);
+    void _step_native();
+    // Runs a measured block in fast timing, charging its cost up front
+    void _run_block(BlockCosts::Block block);
+    // Inside a block an instruction doesn't add its own cycles, and the block runs only when
+    // nothing watches single instructions and takes interrupts after its last one
+    template <bool in_block = false>
+    void _execute(const Opcode& fetched);
+    void _dispatch_interrupt();
 
     static bool _is_zero(uint8_t number) { return number == 0; }
 
@@ -118,11 +221,13 @@ private:
     }
 
     void _add(uint16_t value, uint8_t carry);
+    uint8_t _subtract(uint8_t value, uint8_t borrow);
     void _ret_if(bool condition);
     void _jmp_if(bool condition, uint16_t address);
     void _call_if(bool condition, uint16_t address);
     void _set_zero_parity_sign(uint16_t value);
     void _set_zero_parity_sign(uint8_t value);
+    uint8_t _read_m();
 
     // NOLINTBEGIN
     void _ADD(uint8_t reg);
@@ -141,9 +246,35 @@ private:
     void _DAA();
     // NOLINTEND
 
+    Timing _timing;
+    // How far into IN and OUT devices are called
+    uint8_t _io_access_cycle;
     bool _debug;
+    bool _stop_requested;
 
     std::reference_wrapper<Bus> _bus;
+    // Only in fast timing
+    std::unique_ptr<BlockCosts> _block_costs;
     State _state;
+    InterruptCallback _interrupt_callback;
+    Tracer* _tracer;
+    CallGraph* _call_graph;
+    Metrics* _metrics;
+    NativeCode _native_code;
+    Breakpoints* _breakpoints;
+    // Instructions executed when run() last stopped on a breakpoint, so the next run() steps over
+    // it unless something executed in between
+    uint64_t _breakpoint_retired;
+    // Set by whatever transfers control, so a branch to its own address isn't taken for one
+    // falling through
+    bool _branched;
+
+    uint64_t _retired;
+    // When the pending interrupt was raised, for its latency
+    uint64_t _interrupt_raised_cycle;
+
+#ifdef I8080_PROFILING
+    OpcodeProfile* _profile = nullptr;
+#endif
 };
 } // namespace i8080
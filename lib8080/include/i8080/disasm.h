@@ -0,0 +1,69 @@
+#pragma once
+
+#include "asm.h"
+#include "common.h"
+#include "symbols.h"
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace i8080
+{
+// Separates code from data in a memory image by following control flow from a set of entry
+// points: both ways of a conditional branch, call targets and the instruction after a call, RST
+// vectors. Indirect jumps end a path unless HL was loaded with a constant right before the PCHL,
+// so code only reachable through computed addresses stays data unless given as an entry point.
+class Disassembler final
+{
+public:
+    static constexpr size_t ADDRESS_SPACE = 0x10000;
+    // Data bytes rendered per DB line, as many as fit the object code column
+    static constexpr size_t DATA_BYTES_PER_LINE = 5;
+
+    enum class ByteKind : uint8_t
+    {
+        data,
+        instruction,
+        operand
+    };
+
+    // The image covers the address space from 0, shorter images read as zeros past their end
+    explicit Disassembler(const buffer& memory);
+    Disassembler(const buffer& memory, std::initializer_list<uint16_t> entry_points);
+
+    // Traces everything reachable from the address
+    void add_entry_point(uint16_t address);
+
+    ByteKind kind(uint16_t address) const { return _kinds[address]; }
+
+    bool is_instruction(uint16_t address) const { return kind(address) == ByteKind::instruction; }
+
+    // Branch, call and RST targets, and entry points
+    bool is_label(uint16_t address) const { return _labels[address]; }
+
+    size_t instruction_count() const { return _instruction_count; }
+
+    Opcode opcode(uint16_t address) const;
+
+    // Appends a listing of [first, last]: address, object code, label and source. Labels come
+    // from the symbol table when it has one for the address, which also labels data.
+    void render(fmt::memory_buffer& out,
+                uint16_t first = 0,
+                uint16_t last = ADDRESS_SPACE - 1,
+                const SymbolTable* symbols = nullptr) const;
+
+private:
+    uint8_t _byte(uint32_t address) const;
+    bool _has_label(uint16_t address, const SymbolTable* symbols) const;
+    std::string _label(uint16_t address, const SymbolTable* symbols) const;
+
+    const buffer& _memory;
+    std::vector<ByteKind> _kinds;
+    std::vector<bool> _labels;
+    size_t _instruction_count;
+    std::vector<uint16_t> _pending;
+};
+} // namespace i8080
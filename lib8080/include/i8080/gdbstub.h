@@ -0,0 +1,114 @@
+#pragma once
+
+#include "breakpoints.h"
+#include "bus.h"
+#include "cpu.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace i8080
+{
+// A GDB remote serial protocol server for one CPU, on a Unix domain socket or on a pair of file
+// descriptors such as the pipes of `target remote | ...`. GDB has no 8080 target, so the CPU is
+// presented as a Z80 (`set architecture z80`): its registers are a superset, and the ones the 8080
+// lacks read as zero and ignore writes.
+//
+// Call run() wherever Cpu::run() would be called. A background thread waits for connections and
+// for input from the debugger but only flags them; the thread calling run() notices the flag at
+// the next slice boundary and serves the debugger there, so the CPU is only ever touched by that
+// thread and a debugger that lets the guest run costs one atomic load per slice. Breakpoints and
+// watchpoints are attached to the CPU only while the debugger has some set.
+class GdbStub final
+{
+public:
+    static constexpr uint64_t DEFAULT_SLICE_CYCLES = 100'000;
+    static constexpr size_t MAX_PACKET_SIZE = 0x1000;
+
+    struct Config
+    {
+        // How long the guest can run before input from the debugger is noticed
+        uint64_t slice_cycles = DEFAULT_SLICE_CYCLES;
+    };
+
+    // Listens on a Unix domain socket at the path, replacing a stale socket file
+    GdbStub(Cpu& cpu, Bus& bus, const std::filesystem::path& socket, Config config);
+    GdbStub(Cpu& cpu, Bus& bus, const std::filesystem::path& socket) :
+        GdbStub(cpu, bus, socket, Config {})
+    {}
+
+    // Serves a debugger that is already connected through the descriptors, which are closed
+    // when it detaches
+    GdbStub(Cpu& cpu, Bus& bus, int input, int output, Config config);
+    GdbStub(Cpu& cpu, Bus& bus, int input, int output) :
+        GdbStub(cpu, bus, input, output, Config {})
+    {}
+
+    ~GdbStub();
+
+    GdbStub(const GdbStub&) = delete;
+    GdbStub& operator=(const GdbStub&) = delete;
+
+    // Runs like Cpu::run() and serves the debugger whenever it stops the guest. Halts and stops
+    // the debugger did not cause are returned to the caller.
+    Cpu::StopReason run(uint64_t cycles);
+
+    // Blocks until a debugger connects, and serves it until it lets the guest run
+    void wait_for_debugger();
+
+private:
+    void _start();
+    void _watch();
+    void _attend();
+    void _release();
+    void _serve(const std::optional<std::string>& stop_reply);
+    // Whether to keep serving rather than resume the guest
+    bool _execute(std::string_view packet);
+    std::string _step();
+    std::string _stop_reply(const std::optional<Breakpoints::Hit>& hit) const;
+
+    uint16_t _register(size_t index) const;
+    void _write_register(size_t index, uint16_t value);
+    std::string _read_registers() const;
+    std::string _write_registers(std::string_view values);
+    std::string _read_memory(std::string_view arguments) const;
+    std::string _write_memory(std::string_view arguments);
+    std::string _set_stop_point(std::string_view arguments, bool insert);
+
+    bool _fill();
+    std::optional<char> _read_byte();
+    std::optional<std::string> _read_packet();
+    void _send(std::string_view data);
+    void _send_packet(std::string_view data);
+    void _disconnect();
+
+    std::reference_wrapper<Cpu> _cpu;
+    std::reference_wrapper<Bus> _bus;
+    Config _config;
+
+    std::filesystem::path _socket_path;
+    int _listener;
+    // The connected debugger, or -1. Also polled by the background thread.
+    std::atomic<int> _input;
+    std::atomic<int> _output;
+    // Written to when the stub is destroyed
+    std::array<int, 2> _shutdown;
+
+    // Set by the background thread and cleared by run() once the debugger has been served
+    std::atomic<bool> _attention;
+
+    std::string _received;
+    size_t _received_position;
+    bool _acknowledge;
+    std::string _last_stop;
+    std::optional<Breakpoints> _breakpoints;
+
+    std::jthread _watcher;
+};
+} // namespace i8080
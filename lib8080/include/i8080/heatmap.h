@@ -0,0 +1,110 @@
+#pragma once
+
+#include "bus.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace i8080
+{
+// Counts guest memory accesses per 256 byte page, and per address inside tracked ranges. Fed by
+// a Bus it is attached to; time is split into windows by whoever drives the CPU calling
+// close_window(), and each window remembers which pages it touched to give the working set.
+// Reads and writes count bytes, fetches count instructions at the address of their opcode.
+class MemoryHeatmap final
+{
+public:
+    static constexpr size_t DEFAULT_TOP_PAGES = 16;
+
+    enum class Access : uint8_t
+    {
+        read,
+        write,
+        fetch
+    };
+
+    struct Counters
+    {
+        uint64_t reads = 0;
+        uint64_t writes = 0;
+        uint64_t fetches = 0;
+
+        uint64_t total() const { return reads + writes + fetches; }
+    };
+
+    struct Window
+    {
+        uint64_t first_cycle;
+        uint64_t last_cycle;
+        // Accesses per page during the window
+        std::array<uint32_t, Bus::PAGE_COUNT> accesses;
+        size_t pages;
+        size_t code_pages;
+    };
+
+    MemoryHeatmap();
+
+    void record(Access access, uint16_t address)
+    {
+        uint8_t page = address / Bus::PAGE_SIZE;
+        _count(_pages[page], access);
+        _window_accesses[page]++;
+        _window_fetches[page] |= (access == Access::fetch);
+
+        if (!_tracked.empty() && _tracked[address]) [[unlikely]] {
+            _count(_addresses[address], access);
+        }
+    }
+
+    // Also counts every address of [first, last] individually
+    void track(uint16_t first, uint16_t last);
+
+    // Ends the current window at the cycle; the next one starts right after it
+    void close_window(uint64_t cycle);
+
+    const Counters& page(uint8_t page) const { return _pages[page]; }
+
+    // Zero unless the address is tracked
+    Counters address(uint16_t address) const;
+
+    const std::vector<Window>& windows() const { return _windows; }
+
+    void reset();
+
+    // Hottest pages, tracked addresses and the working set across windows
+    std::string report(size_t top_pages = DEFAULT_TOP_PAGES) const;
+
+    // CSV with a row per window, or a single row without windows, and a column per page, for
+    // plotting as a heatmap of accesses over time
+    void write_heatmap(const std::filesystem::path& path) const;
+
+private:
+    static void _count(Counters& counters, Access access)
+    {
+        switch (access) {
+        case Access::read:
+            counters.reads++;
+            break;
+        case Access::write:
+            counters.writes++;
+            break;
+        case Access::fetch:
+            counters.fetches++;
+            break;
+        }
+    }
+
+    std::array<Counters, Bus::PAGE_COUNT> _pages;
+    std::array<uint32_t, Bus::PAGE_COUNT> _window_accesses;
+    std::array<bool, Bus::PAGE_COUNT> _window_fetches;
+    uint64_t _window_start;
+    std::vector<Window> _windows;
+
+    // Allocated on the first track()
+    std::vector<uint8_t> _tracked;
+    std::vector<Counters> _addresses;
+};
+} // namespace i8080
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "bus.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace i8080
+{
+class GuestMemory;
+
+// An image laid out the way it sits in guest memory, in a file the host can map into any number
+// of guests. The file covers the host pages the image touches, zeroed around the image.
+class SharedImage final
+{
+public:
+    SharedImage(int fd, std::string name, uint16_t base, size_t size, bool shared);
+    ~SharedImage();
+
+    SharedImage(const SharedImage&) = delete;
+    SharedImage& operator=(const SharedImage&) = delete;
+
+    // The guest address of the first page
+    uint16_t base() const { return _base; }
+
+    // Bytes from the first page to the end of the last one
+    size_t size() const { return _size; }
+
+    const std::string& name() const { return _name; }
+
+    // Whether other processes on the host map the same copy, rather than only this one's guests
+    bool shared() const { return _shared; }
+
+private:
+    friend class GuestMemory;
+
+    int _fd;
+    std::string _name;
+    uint16_t _base;
+    size_t _size;
+    bool _shared;
+};
+
+// A guest's memory mapped straight from the host, so images can be mapped into it page by page.
+// Converts to the span a Bus takes, and starts zeroed like any other.
+class GuestMemory final
+{
+public:
+    GuestMemory();
+    ~GuestMemory();
+
+    GuestMemory(const GuestMemory&) = delete;
+    GuestMemory& operator=(const GuestMemory&) = delete;
+
+    // Maps the image over the pages it covers, replacing what they held. The pages stay shared
+    // with every other guest of the image until this one writes to them, which gives it a
+    // private copy of the page written to. The mirror is kept in sync, so a bus can already be
+    // using the memory.
+    void map(const SharedImage& image);
+
+    uint8_t* data() const { return _memory; }
+
+    size_t size() const { return Bus::MEMORY_SIZE; }
+
+    operator std::span<uint8_t>() const { return { _memory, Bus::MEMORY_SIZE }; }
+
+private:
+    uint8_t* _memory;
+    size_t _mapped_size;
+};
+
+// Publishes images into named POSIX shared memory, keyed by their content and where they load, so
+// every emulator process on the host maps one physical copy and starts without reading it again.
+// Another process's object is only used once its content checks out; when it doesn't, or shared
+// memory is not available, the image goes into an anonymous file only this process maps.
+//
+// Objects outlive the processes that published them, until unpublish() or a reboot. Thread-safe.
+class ImageCache final
+{
+public:
+    static constexpr std::string_view DEFAULT_PREFIX = "/i8080-image-";
+
+    // The prefix is a shared memory name: a slash and no other
+    explicit ImageCache(std::string prefix = std::string(DEFAULT_PREFIX));
+
+    // The image of the data loaded at the origin, published if no process has yet
+    std::shared_ptr<const SharedImage> publish(std::span<const uint8_t> data, uint16_t origin);
+    // The same for a file's content
+    std::shared_ptr<const SharedImage> load(const std::filesystem::path& path, uint16_t origin);
+
+    // Removes the image's name from the host, guests that mapped it keep their pages
+    static void unpublish(const SharedImage& image);
+
+private:
+    std::string _prefix;
+    std::mutex _lock;
+    // Images this process already opened, by name
+    std::unordered_map<std::string, std::weak_ptr<const SharedImage>> _images;
+};
+} // namespace i8080
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "asm.h"
+#include "bus.h"
+#include "cpu.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace i8080
+{
+// A guest in one block: its memory, then its bus with the page table and ports, then its CPU
+// with the registers, each starting on a cache line of its own. Nothing is allocated until
+// devices are registered.
+struct Machine final
+{
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    Machine(uint16_t entry_point, Cpu::Timing timing) :
+        memory {},
+        bus(memory),
+        cpu(bus, entry_point, timing)
+    {}
+
+    Machine(const Machine&) = delete;
+    Machine& operator=(const Machine&) = delete;
+
+    alignas(CACHE_LINE_SIZE) std::array<uint8_t, Bus::MEMORY_SIZE> memory;
+    alignas(CACHE_LINE_SIZE) Bus bus;
+    alignas(CACHE_LINE_SIZE) Cpu cpu;
+};
+
+// A fixed number of machines in one arena, mapped up front with huge pages where the system has
+// them reserved and transparent huge pages requested otherwise. The pool itself never allocates
+// once constructed: slots come off a free list sized at construction, and a slot's pages stay
+// mapped for the next machine, so the pool's memory use only depends on its busiest moment. A
+// fast-timing CPU still allocates its block costs on the heap, and their tables as it runs.
+//
+// Not thread-safe; give each host thread its own pool.
+class MachinePool final
+{
+public:
+    static constexpr size_t HUGE_PAGE_SIZE = 2 << 20;
+
+    explicit MachinePool(size_t capacity);
+    ~MachinePool();
+
+    MachinePool(const MachinePool&) = delete;
+    MachinePool& operator=(const MachinePool&) = delete;
+
+    // A zeroed machine, or nullptr when every slot is taken
+    Machine* create(uint16_t entry_point, Cpu::Timing timing = Cpu::Timing::exact);
+    // The machine must come from this pool
+    void destroy(Machine* machine);
+
+    size_t size() const { return _capacity - _free.size(); }
+
+    size_t capacity() const { return _capacity; }
+
+    // Bytes mapped for the arena, whatever of it has been touched
+    size_t arena_size() const { return _arena_size; }
+
+    // Whether the arena got explicit huge pages rather than transparent ones
+    bool huge_pages() const { return _huge_pages; }
+
+private:
+    Machine* _slot(size_t index) const { return reinterpret_cast<Machine*>(_arena) + index; }
+
+    std::byte* _arena;
+    size_t _arena_size;
+    size_t _capacity;
+    bool _huge_pages;
+
+    // Free slots, the last one freed on top so the next machine reuses pages already backed
+    std::vector<uint32_t> _free;
+    std::vector<bool> _live;
+};
+} // namespace i8080
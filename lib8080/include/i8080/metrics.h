@@ -0,0 +1,151 @@
+#pragma once
+
+#include "bus.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace i8080
+{
+// Health and throughput counters of one emulator instance, readable from any thread. Each
+// instance has a single writer, the thread running its CPU, so counters are bumped with relaxed
+// loads and stores rather than read-modify-write atomics. The CPU keeps instructions and cycles
+// in plain members and publishes them when Cpu::run() returns, so the per-instruction path
+// never touches an atomic.
+class Metrics final
+{
+public:
+    struct Snapshot
+    {
+        uint64_t instructions;
+        uint64_t cycles;
+        uint64_t halts;
+        uint64_t interrupts;
+        // Cycles from Cpu::interrupt() to the dispatch, summed and worst case
+        uint64_t interrupt_latency;
+        uint64_t max_interrupt_latency;
+        std::array<uint64_t, Bus::PORT_COUNT> port_reads;
+        std::array<uint64_t, Bus::PORT_COUNT> port_writes;
+        // Block cost lookups of a fast-timing CPU
+        uint64_t block_hits;
+        uint64_t block_misses;
+        std::chrono::duration<double> uptime;
+
+        // Average since the metrics were created
+        double mips() const { return uptime.count() ? instructions / uptime.count() / 1e6 : 0.0; }
+
+        double block_hit_ratio() const
+        {
+            uint64_t lookups = block_hits + block_misses;
+            return lookups ? static_cast<double>(block_hits) / lookups : 0.0;
+        }
+    };
+
+    using Sink = std::function<void(std::string_view)>;
+
+    explicit Metrics(std::string instance = {});
+
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    const std::string& instance() const { return _instance; }
+
+    void publish(uint64_t instructions, uint64_t cycles)
+    {
+        _instructions.store(instructions, std::memory_order_relaxed);
+        _cycles.store(cycles, std::memory_order_relaxed);
+    }
+
+    // Published along with the instructions and cycles, from the CPU's block costs
+    void publish_blocks(uint64_t hits, uint64_t misses)
+    {
+        _block_hits.store(hits, std::memory_order_relaxed);
+        _block_misses.store(misses, std::memory_order_relaxed);
+    }
+
+    void add_halt() { _increment(_halts); }
+
+    void add_interrupt(uint64_t latency)
+    {
+        _increment(_interrupts);
+        _increment(_interrupt_latency, latency);
+        if (latency > _max_interrupt_latency.load(std::memory_order_relaxed)) {
+            _max_interrupt_latency.store(latency, std::memory_order_relaxed);
+        }
+    }
+
+    void add_port_read(uint8_t port) { _increment(_port_reads[port]); }
+
+    void add_port_write(uint8_t port) { _increment(_port_writes[port]); }
+
+    Snapshot snapshot() const;
+
+    // Prometheus text exposition format, one sample per instance for each metric
+    static std::string prometheus(std::span<const Metrics* const> instances);
+    std::string prometheus() const;
+
+    void export_prometheus(const Sink& sink) const;
+
+    // Replaces the file atomically, so a scraper never reads half of it
+    void export_prometheus(const std::filesystem::path& path) const;
+
+private:
+    static void _increment(std::atomic<uint64_t>& counter, uint64_t amount = 1)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount,
+                      std::memory_order_relaxed);
+    }
+
+    std::string _instance;
+    std::chrono::steady_clock::time_point _created;
+
+    std::atomic<uint64_t> _instructions;
+    std::atomic<uint64_t> _cycles;
+    std::atomic<uint64_t> _halts;
+    std::atomic<uint64_t> _interrupts;
+    std::atomic<uint64_t> _interrupt_latency;
+    std::atomic<uint64_t> _max_interrupt_latency;
+    std::array<std::atomic<uint64_t>, Bus::PORT_COUNT> _port_reads;
+    std::array<std::atomic<uint64_t>, Bus::PORT_COUNT> _port_writes;
+    std::atomic<uint64_t> _block_hits;
+    std::atomic<uint64_t> _block_misses;
+};
+
+// Hands the Prometheus text of a set of instances to a sink on a background thread, once per
+// period and once more when destroyed
+class MetricsExporter final
+{
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_PERIOD = std::chrono::seconds(1);
+
+    MetricsExporter(std::vector<const Metrics*> instances,
+                    Metrics::Sink sink,
+                    std::chrono::milliseconds period = DEFAULT_PERIOD);
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+private:
+    void _export() const;
+
+    std::vector<const Metrics*> _instances;
+    Metrics::Sink _sink;
+    std::chrono::milliseconds _period;
+
+    std::mutex _lock;
+    std::condition_variable_any _wakeup;
+    std::jthread _thread;
+};
+} // namespace i8080
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "bus.h"
+#include "cpu.h"
+
+#include <cstdint>
+#include <functional>
+
+namespace i8080
+{
+// An 8080 written from the datasheet for the co-simulator to hold the engines against: it decodes
+// the opcode bits itself, keeps its own cycle counts and shares no code with Cpu, so a mistake in
+// one is not repeated in the other. Slow, and only meant as the ground truth.
+//
+// An interrupt raised while they are enabled is taken after the next instruction, or right away
+// when the CPU is halted, which it wakes.
+class ReferenceModel final
+{
+public:
+    ReferenceModel(Bus& bus, const Cpu::State& state);
+
+    ReferenceModel(const ReferenceModel&) = delete;
+    ReferenceModel& operator=(const ReferenceModel&) = delete;
+
+    const Cpu::State& state() const { return _state; }
+
+    bool halt() const { return _state.halt; }
+
+    // Executes one instruction and a pending interrupt, nothing while halted
+    void step();
+    void interrupt(uint8_t isr_number);
+
+private:
+    uint8_t _read(uint16_t address);
+    uint16_t _read_word(uint16_t address);
+    void _write(uint16_t address, uint8_t value);
+    void _write_word(uint16_t address, uint16_t value);
+    uint8_t _fetch();
+    uint16_t _fetch_word();
+    void _push(uint16_t value);
+    uint16_t _pop();
+
+    // Registers in opcode order, 6 is memory at HL
+    uint8_t _get(uint8_t index);
+    void _set(uint8_t index, uint8_t value);
+    // BC, DE, HL and SP in opcode order
+    uint16_t _get_pair(uint8_t index) const;
+    void _set_pair(uint8_t index, uint16_t value);
+    bool _condition(uint8_t index) const;
+
+    void _set_flag(uint8_t flag, bool value);
+    bool _flag(uint8_t flag) const { return _state.flags.status & flag; }
+    void _set_zero_sign_parity(uint8_t value);
+    void _alu(uint8_t operation, uint8_t value);
+
+    void _execute(uint8_t opcode);
+    void _dispatch();
+
+    std::reference_wrapper<Bus> _bus;
+    Cpu::State _state;
+};
+} // namespace i8080
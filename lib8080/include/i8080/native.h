@@ -0,0 +1,235 @@
+#pragma once
+
+#include "bus.h"
+#include "common.h"
+#include "cpu.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+namespace i8080
+{
+// What the recompiler emits for a program: the code for Cpu::set_native_code() and the image it
+// was translated from. The code is only valid for memory that still holds that image.
+struct NativeProgram
+{
+    uint16_t origin;
+    std::span<const uint8_t> image;
+    Cpu::NativeCode code;
+
+    bool matches(std::span<const uint8_t> memory) const
+    {
+        return origin + image.size() <= memory.size() &&
+               std::ranges::equal(image, memory.subspan(origin, image.size()));
+    }
+};
+
+// The instruction semantics recompiled code is built from. Each one does exactly what the
+// interpreter does for the instruction, so a program behaves the same whether its blocks run
+// natively or interpreted.
+namespace native
+{
+using State = Cpu::State;
+
+inline void set_zero_parity_sign(State& s, uint8_t value)
+{
+    s.flags.zero = (value == 0);
+    s.flags.sign = (value & 0x80) != 0;
+    s.flags.parity = !(std::popcount(value) & 1);
+}
+
+inline void add(State& s, uint16_t value, uint8_t carry)
+{
+    uint16_t result = static_cast<uint16_t>(s.a) + (value + carry);
+
+    set_zero_parity_sign(s, result & 0xff);
+
+    s.flags.carry = (result > 0xff);
+    s.flags.aux = (((s.a & 0xf) + (value & 0xf) + carry) > 0xf);
+
+    s.a = result & 0xff;
+}
+
+// NOLINTBEGIN
+inline void add(State& s, uint8_t reg)
+{
+    add(s, reg, 0);
+}
+
+inline void adc(State& s, uint8_t reg)
+{
+    add(s, reg, s.flags.carry);
+}
+
+inline uint8_t subtract(State& s, uint8_t value, uint8_t borrow)
+{
+    uint8_t complement = ~value;
+    uint8_t carry = !borrow;
+    uint16_t result = static_cast<uint16_t>(s.a) + complement + carry;
+
+    set_zero_parity_sign(s, result & 0xff);
+
+    s.flags.carry = (result <= 0xff);
+    s.flags.aux = (((s.a & 0xf) + (complement & 0xf) + carry) > 0xf);
+
+    return result & 0xff;
+}
+
+inline void sub(State& s, uint8_t reg)
+{
+    s.a = subtract(s, reg, 0);
+}
+
+inline void sbb(State& s, uint8_t reg)
+{
+    s.a = subtract(s, reg, s.flags.carry);
+}
+
+inline void bitwise(State& s, uint8_t result)
+{
+    s.a = result;
+
+    set_zero_parity_sign(s, s.a);
+
+    s.flags.carry = 0;
+    s.flags.aux = 0;
+}
+
+inline void ana(State& s, uint8_t reg)
+{
+    uint8_t aux = ((s.a | reg) & 0x08) != 0;
+    bitwise(s, s.a & reg);
+    s.flags.aux = aux;
+}
+
+inline void xra(State& s, uint8_t reg)
+{
+    bitwise(s, s.a ^ reg);
+}
+
+inline void ora(State& s, uint8_t reg)
+{
+    bitwise(s, s.a | reg);
+}
+
+inline void cmp(State& s, uint8_t reg)
+{
+    subtract(s, reg, 0);
+}
+
+inline void inr(State& s, uint8_t& reg)
+{
+    reg++;
+    set_zero_parity_sign(s, reg);
+    s.flags.aux = ((reg & 0xf) == 0);
+}
+
+inline void dcr(State& s, uint8_t& reg)
+{
+    reg--;
+    set_zero_parity_sign(s, reg);
+    s.flags.aux = ((reg & 0xf) != 0xf);
+}
+
+inline void dad(State& s, uint16_t reg)
+{
+    uint32_t result = static_cast<uint32_t>(s.hl) + static_cast<uint32_t>(reg);
+    s.flags.carry = (result > 0xffff);
+    s.hl = result & 0xffff;
+}
+
+inline void daa(State& s)
+{
+    uint8_t addition = 0;
+    uint8_t lower_bits = s.a & 0x0f;
+    uint8_t higher_bits = s.a >> 4;
+
+    if (s.flags.aux || lower_bits > 9) {
+        addition += 0x06;
+    }
+
+    uint8_t carry = s.flags.carry;
+    if (s.flags.carry || higher_bits > 9 || (higher_bits == 9 && lower_bits > 9)) {
+        addition += 0x60;
+        carry = 1;
+    }
+
+    add(s, addition, 0);
+    s.flags.carry = carry;
+}
+
+inline void rlc(State& s)
+{
+    s.flags.carry = s.a >> 7;
+    s.a = (s.a << 1) | s.flags.carry;
+}
+
+inline void rrc(State& s)
+{
+    s.flags.carry = s.a & 1;
+    s.a = (s.a >> 1) | (s.flags.carry << 7);
+}
+
+inline void ral(State& s)
+{
+    uint8_t old_carry = s.flags.carry;
+    s.flags.carry = s.a >> 7;
+    s.a = (s.a << 1) | old_carry;
+}
+
+inline void rar(State& s)
+{
+    uint8_t old_carry = s.flags.carry;
+    s.flags.carry = s.a & 1;
+    s.a = (s.a >> 1) | old_carry << 7;
+}
+
+inline void cmc(State& s)
+{
+    s.flags.carry = ~s.flags.carry;
+}
+
+inline uint8_t read_m(State& s, Bus& bus)
+{
+    uint8_t value;
+    bus.mem_read(s.hl, value);
+    return value;
+}
+
+inline void push(State& s, Bus& bus, uint16_t reg)
+{
+    s.sp -= 2;
+    bus.mem_write(s.sp, reg);
+}
+
+inline void pop(State& s, Bus& bus, uint16_t& reg)
+{
+    bus.mem_read(s.sp, reg);
+    s.sp += 2;
+}
+
+inline void push_psw(State& s, Bus& bus)
+{
+    push(s, bus, (s.a << 8) | (s.flags.status & Cpu::FLAGS_USED) | Cpu::FLAGS_SET);
+}
+
+inline void pop_psw(State& s, Bus& bus)
+{
+    uint16_t psw;
+    pop(s, bus, psw);
+    s.a = psw >> 8;
+    s.flags.status = (psw & Cpu::FLAGS_USED) | Cpu::FLAGS_SET;
+}
+
+inline void xthl(State& s, Bus& bus)
+{
+    uint16_t current_hl = s.hl;
+    bus.mem_read(s.sp, s.hl);
+    bus.mem_write(s.sp, current_hl);
+}
+// NOLINTEND
+} // namespace native
+} // namespace i8080
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "cpu.h"
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <functional>
+
+namespace i8080
+{
+// Runs the guest in slices of cycles, sleeping until each slice's CLOCK_MONOTONIC deadline so
+// it advances at its nominal clock. Can be switched to and from running flat out, or to another
+// clock, at any time, also from another thread. Everything else belongs to the thread running it.
+class Pacer final
+{
+public:
+    static constexpr uint64_t DEFAULT_CLOCK_HZ = 2'000'000;
+    static constexpr std::chrono::nanoseconds DEFAULT_SLICE = std::chrono::milliseconds(1);
+
+    // Falling further behind than this many slices gives up on catching up
+    static constexpr uint64_t MAX_BACKLOG_SLICES = 50;
+
+    struct Config
+    {
+        uint64_t clock_hz = DEFAULT_CLOCK_HZ;
+        std::chrono::nanoseconds slice = DEFAULT_SLICE;
+    };
+
+    struct Statistics
+    {
+        uint64_t slices = 0;
+        // Slices that finished after their deadline
+        uint64_t overruns = 0;
+        // Times the schedule was reset after falling too far behind
+        uint64_t resyncs = 0;
+        // How late the last slice finished or woke up relative to its deadline
+        std::chrono::nanoseconds drift {};
+        std::chrono::nanoseconds max_drift {};
+        std::chrono::nanoseconds slept {};
+    };
+
+    // Runs the given number of cycles, by default Cpu::run
+    using Runner = std::function<Cpu::StopReason(uint64_t)>;
+
+    // The clock must not be 0, here or in set_clock()
+    Pacer(Cpu& cpu, Config config, Runner runner = {});
+    explicit Pacer(Cpu& cpu) :
+        Pacer(cpu, Config {})
+    {}
+
+    Pacer(const Pacer&) = delete;
+    Pacer& operator=(const Pacer&) = delete;
+
+    Cpu::StopReason run(uint64_t cycles);
+
+    void set_paced(bool paced) { _paced.store(paced, std::memory_order_relaxed); }
+
+    bool paced() const { return _paced.load(std::memory_order_relaxed); }
+
+    void set_clock(uint64_t clock_hz);
+
+    const Statistics& statistics() const { return _statistics; }
+
+    void reset_statistics() { _statistics = {}; }
+
+private:
+    static timespec _now();
+    static std::chrono::nanoseconds _difference(const timespec& later, const timespec& earlier);
+
+    void _anchor(uint64_t clock_hz);
+    timespec _deadline(uint64_t cycle) const;
+    void _wait(const timespec& deadline);
+
+    std::reference_wrapper<Cpu> _cpu;
+    Runner _runner;
+    Config _config;
+    // Written by set_clock() from any thread, picked up by run() at the next slice
+    std::atomic<uint64_t> _clock_hz;
+    std::atomic<bool> _paced;
+
+    // Only touched by the thread in run()
+    bool _anchored;
+    timespec _anchor_time;
+    uint64_t _anchor_cycle;
+    uint64_t _anchor_clock_hz;
+    Statistics _statistics;
+};
+} // namespace i8080
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "asm.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace i8080
+{
+// Execution and cycle counts per opcode, and optionally per pair of consecutive opcodes to find
+// fusion candidates. The CPU only feeds it when built with I8080_PROFILING.
+class OpcodeProfile final
+{
+public:
+    enum class Format : uint8_t
+    {
+        text,
+        json
+    };
+
+    static constexpr size_t DEFAULT_TOP_PAIRS = 32;
+
+    explicit OpcodeProfile(bool track_pairs = false);
+
+    void record(Instruction instruction, uint64_t cycles)
+    {
+        auto opcode = static_cast<uint8_t>(instruction);
+        _counters[opcode].executions++;
+        _counters[opcode].cycles += cycles;
+
+        if (!_pairs.empty()) {
+            _pairs[(_previous << 8) | opcode]++;
+        }
+
+        _previous = opcode;
+    }
+
+    void reset();
+
+    uint64_t executions(Instruction instruction) const
+    {
+        return _counters[static_cast<uint8_t>(instruction)].executions;
+    }
+
+    uint64_t cycles(Instruction instruction) const
+    {
+        return _counters[static_cast<uint8_t>(instruction)].cycles;
+    }
+
+    // Opcodes sorted by cycles spent, then the most frequent pairs
+    std::string report(Format format, size_t top_pairs = DEFAULT_TOP_PAIRS) const;
+
+private:
+    // Both counters of an opcode share a cache line
+    struct Counters
+    {
+        uint64_t executions;
+        uint64_t cycles;
+    };
+
+    std::array<Counters, 256> _counters;
+    std::vector<uint64_t> _pairs;
+    uint8_t _previous;
+};
+} // namespace i8080
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "common.h"
+#include "disasm.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace i8080
+{
+// Translates a program that never modifies its own code into C++ ahead of time: a function per
+// basic block built from the semantics in native.h, and a dispatcher over the block entries to
+// hand to Cpu::set_native_code(). Code is found by the Disassembler and only translated inside
+// the image. Computed jumps and returns to addresses that don't start a block fall back to the
+// interpreter, which carries on until it reaches one.
+//
+// Blocks end at every branch, call, return and HLT, and after IN and OUT so devices see the
+// PC and cycle count they would when interpreted with exact timing.
+class Recompiler final
+{
+public:
+    static constexpr uint16_t DEFAULT_ORIGIN = 0x100;
+
+    // The image is loaded at the origin, which is also the first entry point
+    explicit Recompiler(const buffer& image, uint16_t origin = DEFAULT_ORIGIN);
+
+    // For code only reachable through computed addresses
+    void add_entry_point(uint16_t address);
+
+    size_t block_count() const;
+
+    // Source defining `extern const i8080::NativeProgram <name>`
+    std::string translate(std::string_view name) const;
+
+private:
+    bool _in_image(uint16_t address, size_t size) const;
+    // Addresses where a block starts
+    std::vector<bool> _leaders() const;
+    // Whether a block running into the address carries on with it
+    bool _continues_block(uint16_t address, const std::vector<bool>& leaders) const;
+    void _translate_block(fmt::memory_buffer& out,
+                          uint16_t start,
+                          const std::vector<bool>& leaders) const;
+
+    uint16_t _origin;
+    size_t _image_size;
+    buffer _memory;
+    Disassembler _disassembler;
+};
+} // namespace i8080
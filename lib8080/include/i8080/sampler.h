@@ -0,0 +1,76 @@
+#pragma once
+
+#include "cpu.h"
+#include "symbols.h"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace i8080
+{
+// Statistical guest profiler. Runs the CPU in chunks of about `interval` cycles and samples the
+// PC between them, so the only cost while the guest runs is Cpu::run's cycle check. The chunk
+// length is jittered around the interval so loops whose period divides it are not always caught
+// at the same instruction.
+class SamplingProfiler final
+{
+public:
+    static constexpr uint64_t DEFAULT_INTERVAL = 1000;
+    static constexpr size_t DEFAULT_TOP_ADDRESSES = 20;
+
+    struct Config
+    {
+        uint64_t interval = DEFAULT_INTERVAL;
+        bool jitter = true;
+        uint64_t seed = 1;
+    };
+
+    // Appends the entry addresses of the active calls to frames, outermost first
+    using StackWalker = std::function<void(std::vector<uint16_t>& frames)>;
+
+    SamplingProfiler(Cpu& cpu, Config config);
+    explicit SamplingProfiler(Cpu& cpu) :
+        SamplingProfiler(cpu, Config {})
+    {}
+
+    SamplingProfiler(const SamplingProfiler&) = delete;
+    SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+
+    // Without a walker every sample is a single frame stack
+    void set_stack_walker(StackWalker walker) { _walker = std::move(walker); }
+
+    Cpu::StopReason run(uint64_t cycles);
+
+    // Takes a sample at the current PC, for callers driving the CPU themselves
+    void sample();
+
+    void reset();
+
+    uint64_t samples() const { return _samples; }
+
+    uint64_t samples(uint16_t address) const { return _histogram[address]; }
+
+    // Hottest addresses and symbols
+    std::string report(const SymbolTable& symbols,
+                       size_t top_addresses = DEFAULT_TOP_ADDRESSES) const;
+
+    // One "outer;inner;leaf count" line per distinct stack, as read by flamegraph.pl
+    std::string folded(const SymbolTable& symbols) const;
+
+private:
+    uint64_t _next_interval();
+
+    std::reference_wrapper<Cpu> _cpu;
+    Config _config;
+    StackWalker _walker;
+    uint64_t _random;
+
+    uint64_t _samples;
+    std::vector<uint64_t> _histogram;
+    // Frames followed by the sampled PC
+    std::map<std::vector<uint16_t>, uint64_t> _stacks;
+    std::vector<uint16_t> _frames;
+};
+} // namespace i8080
@@ -0,0 +1,252 @@
+#pragma once
+
+#include "asm.h"
+#include "bus.h"
+#include "cpu.h"
+#include "device.h"
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace i8080
+{
+class Scheduler;
+
+// Recycles coroutine frames in per-thread size classes, so spawning a device after warm-up
+// does not reach the global allocator. Frames must be freed on the thread that allocated them.
+class FramePool final
+{
+public:
+    static constexpr size_t GRANULARITY = 64;
+    static constexpr size_t SIZE_CLASSES = 32;
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    static void* allocate(size_t size);
+    static void deallocate(void* frame, size_t size);
+
+private:
+    struct FreeFrame
+    {
+        FreeFrame* next;
+    };
+
+    struct Pool
+    {
+        std::array<FreeFrame*, SIZE_CLASSES> free = {};
+        std::vector<std::unique_ptr<std::byte[]>> chunks;
+        size_t chunk_offset = CHUNK_SIZE;
+    };
+
+    static Pool& _pool();
+};
+
+// A device written as a coroutine. It starts when spawned on a scheduler, and may suspend on
+// guest time passing, port accesses or interrupt acknowledgement.
+class DeviceTask final
+{
+public:
+    struct promise_type
+    {
+        DeviceTask get_return_object()
+        {
+            return DeviceTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+
+        void unhandled_exception() { exception = std::current_exception(); }
+
+        static void* operator new(size_t size) { return FramePool::allocate(size); }
+
+        static void operator delete(void* frame, size_t size)
+        {
+            FramePool::deallocate(frame, size);
+        }
+
+        Scheduler* scheduler = nullptr;
+        uint8_t value = 0;
+        Instruction vector = Instruction::NOP;
+        std::exception_ptr exception;
+    };
+
+    using handle = std::coroutine_handle<promise_type>;
+
+    DeviceTask(DeviceTask&& other) noexcept :
+        _handle(std::exchange(other._handle, nullptr))
+    {}
+
+    DeviceTask& operator=(DeviceTask&& other) noexcept
+    {
+        std::swap(_handle, other._handle);
+        return *this;
+    }
+
+    DeviceTask(const DeviceTask&) = delete;
+    DeviceTask& operator=(const DeviceTask&) = delete;
+
+    ~DeviceTask()
+    {
+        if (_handle) {
+            _handle.destroy();
+        }
+    }
+
+    handle release() { return std::exchange(_handle, nullptr); }
+
+private:
+    explicit DeviceTask(handle handle) :
+        _handle(handle)
+    {}
+
+    handle _handle;
+};
+
+// Runs the CPU in slices that end at the next device deadline or port/interrupt event, and
+// resumes the devices waiting on it between instructions. While the CPU is halted the devices
+// keep running to their next wake-up, and run() only stops on a halt none of them can end.
+class Scheduler final
+{
+public:
+    enum class Event : uint8_t
+    {
+        port_write,
+        port_read,
+        irq_ack
+    };
+
+    Scheduler(Cpu& cpu, Bus& bus);
+    ~Scheduler();
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    void spawn(DeviceTask task);
+    Cpu::StopReason run(uint64_t cycles);
+
+    uint64_t now() const { return _cpu.get().state().cycle; }
+
+    // The value the guest reads from the port with IN
+    void set_input(uint8_t port, uint8_t value);
+    void raise_irq(uint8_t isr_number) { _cpu.get().interrupt(isr_number); }
+
+    // Used by the awaitables
+    void sleep(DeviceTask::handle handle, uint64_t cycles);
+    void wait(DeviceTask::handle handle, Event event, uint8_t port);
+
+private:
+    class Port;
+
+    struct Timer
+    {
+        uint64_t wake;
+        uint64_t sequence;
+        DeviceTask::handle handle;
+
+        bool operator>(const Timer& other) const
+        {
+            return (wake != other.wake) ? (wake > other.wake) : (sequence > other.sequence);
+        }
+    };
+
+    struct Waiter
+    {
+        DeviceTask::handle handle;
+        Event event;
+        uint8_t port;
+    };
+
+    void _listen(uint8_t port);
+    void _notify(Event event, uint8_t port, uint8_t value);
+    void _wake_timers();
+    void _resume_ready();
+
+    std::reference_wrapper<Cpu> _cpu;
+    std::reference_wrapper<Bus> _bus;
+
+    std::vector<DeviceTask::handle> _tasks;
+    std::vector<Timer> _timers;
+    std::vector<Waiter> _waiters;
+    std::vector<DeviceTask::handle> _ready;
+    std::vector<DeviceTask::handle> _resuming;
+    std::array<std::shared_ptr<Port>, Bus::PORT_COUNT> _ports;
+    uint64_t _sequence;
+    bool _event_pending;
+};
+
+struct CyclesAwaiter
+{
+    bool await_ready() const { return cycles == 0; }
+
+    void await_suspend(DeviceTask::handle handle) const
+    {
+        handle.promise().scheduler->sleep(handle, cycles);
+    }
+
+    void await_resume() const {}
+
+    uint64_t cycles;
+};
+
+struct PortAwaiter
+{
+    bool await_ready() const { return false; }
+
+    void await_suspend(DeviceTask::handle handle)
+    {
+        suspended = handle;
+        handle.promise().scheduler->wait(handle, event, port);
+    }
+
+    // The byte written by OUT, or the byte returned to IN
+    uint8_t await_resume() const { return suspended.promise().value; }
+
+    Scheduler::Event event;
+    uint8_t port;
+    DeviceTask::handle suspended = nullptr;
+};
+
+struct IrqAwaiter
+{
+    bool await_ready() const { return false; }
+
+    void await_suspend(DeviceTask::handle handle)
+    {
+        suspended = handle;
+        handle.promise().scheduler->wait(handle, Scheduler::Event::irq_ack, 0);
+    }
+
+    // The RST instruction that was dispatched
+    Instruction await_resume() const { return suspended.promise().vector; }
+
+    DeviceTask::handle suspended = nullptr;
+};
+
+inline CyclesAwaiter cycles(uint64_t count)
+{
+    return { .cycles = count };
+}
+
+inline PortAwaiter port_write(uint8_t port)
+{
+    return { .event = Scheduler::Event::port_write, .port = port };
+}
+
+inline PortAwaiter port_read(uint8_t port)
+{
+    return { .event = Scheduler::Event::port_read, .port = port };
+}
+
+inline IrqAwaiter irq_ack()
+{
+    return {};
+}
+} // namespace i8080
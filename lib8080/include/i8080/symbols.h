@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace i8080
+{
+// Maps guest addresses to the closest label at or before them
+class SymbolTable final
+{
+public:
+    struct Symbol
+    {
+        uint16_t address;
+        std::string name;
+    };
+
+    // Reads the labels out of an assembler listing laid out like resources/test8080.txt: a space,
+    // a 4 digit hex address, a space, 10 columns of object code and then the source line. EQU
+    // lines have '=' in place of object code and are skipped, they name constants rather than
+    // code.
+    static SymbolTable from_listing(std::istream& listing);
+    static SymbolTable from_listing(const std::filesystem::path& path);
+
+    void add(uint16_t address, std::string name);
+
+    // Nullptr if the address is before the first symbol
+    const Symbol* find(uint16_t address) const;
+
+    // "LABEL+0x12", or the bare address if no symbol covers it
+    std::string describe(uint16_t address) const;
+
+    // "LABEL", or the bare address if no symbol covers it
+    std::string name(uint16_t address) const;
+
+    size_t size() const { return _symbols.size(); }
+
+    bool empty() const { return _symbols.empty(); }
+
+private:
+    // Sorted by address
+    std::vector<Symbol> _symbols;
+};
+} // namespace i8080
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "bus.h"
+#include "common.h"
+#include "cpu.h"
+#include "device.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace i8080
+{
+// Serializes a device that is reachable from several CPUs
+class SynchronizedDevice final : public Device
+{
+public:
+    explicit SynchronizedDevice(Device::sptr device) :
+        _device(std::move(device))
+    {}
+
+    void write(uint8_t byte) override
+    {
+        std::lock_guard lock(_lock);
+        _device->write(byte);
+    }
+
+    void read(uint8_t& byte) override
+    {
+        std::lock_guard lock(_lock);
+        _device->read(byte);
+    }
+
+private:
+    Device::sptr _device;
+    std::mutex _lock;
+};
+
+// Several CPUs over one memory, each with its own bus and host thread. The CPUs run freely for a
+// quantum of cycles and then meet at a barrier, so a smaller quantum keeps them closer in guest
+// time at the cost of throughput. Pages shared between CPUs must be marked with share(), which
+// makes their data accesses atomic; other pages take the unsynchronized path and must only be
+// touched by one CPU. Instructions are always fetched unsynchronized, so code in shared pages
+// must not be modified while the system runs.
+class System final
+{
+public:
+    static constexpr uint64_t DEFAULT_QUANTUM = 10'000;
+
+    // The quantum must not be 0, here or in set_quantum()
+    System(buffer& memory,
+           const std::vector<uint16_t>& entry_points,
+           uint64_t quantum = DEFAULT_QUANTUM);
+    System(const System&) = delete;
+    System& operator=(const System&) = delete;
+
+    size_t size() const { return _nodes.size(); }
+
+    Cpu& cpu(size_t index) { return _nodes[index]->cpu; }
+
+    Bus& bus(size_t index) { return _nodes[index]->bus; }
+
+    void share(uint8_t first_page, size_t page_count);
+
+    // Registers the device on every CPU's bus behind a lock
+    void register_shared_device(uint8_t port, Device::sptr device);
+
+    void set_quantum(uint64_t quantum);
+
+    uint64_t quantum() const { return _quantum; }
+
+    // Runs every CPU for the given number of cycles, or until all of them halt
+    void run(uint64_t cycles);
+
+private:
+    struct Node
+    {
+        Node(buffer& memory, uint16_t entry_point) :
+            bus(memory),
+            cpu(bus, entry_point)
+        {}
+
+        Bus bus;
+        Cpu cpu;
+    };
+
+    std::vector<std::unique_ptr<Node>> _nodes;
+    uint64_t _quantum;
+};
+} // namespace i8080
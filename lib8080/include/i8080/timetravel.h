@@ -0,0 +1,121 @@
+#pragma once
+
+#include "bus.h"
+#include "common.h"
+#include "cpu.h"
+
+#include <deque>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace i8080
+{
+// Records periodic checkpoints while driving a CPU forward, and reaches any earlier cycle by
+// restoring the closest checkpoint and re-executing from it. A checkpoint only holds the pages
+// written since the previous one; when the budget is exceeded the oldest checkpoint is folded
+// into the base image. Devices see re-executed port accesses again, so they must be
+// deterministic, and interrupts must be raised through interrupt() so they can be replayed.
+class TimeMachine final
+{
+public:
+    struct Config
+    {
+        uint64_t checkpoint_interval = 1'000'000;
+        size_t memory_budget = 16 * 1024 * 1024;
+    };
+
+    struct Write
+    {
+        uint64_t cycle;
+        uint16_t pc;
+        uint8_t value;
+    };
+
+    using Predicate = std::function<bool(const Cpu::State&)>;
+
+    TimeMachine(Cpu& cpu, Bus& bus, buffer& memory, Config config);
+    TimeMachine(Cpu& cpu, Bus& bus, buffer& memory) :
+        TimeMachine(cpu, bus, memory, Config {})
+    {}
+    ~TimeMachine();
+
+    TimeMachine(const TimeMachine&) = delete;
+    TimeMachine& operator=(const TimeMachine&) = delete;
+
+    void tick();
+    void run(uint64_t cycles);
+    void interrupt(uint8_t isr_number);
+
+    // Moves to the last instruction boundary at or before the given cycle
+    bool seek(uint64_t cycle);
+    bool reverse_step();
+
+    // Moves back to the most recent earlier instruction boundary where the predicate holds
+    bool reverse_continue(const Predicate& predicate);
+    bool reverse_continue(uint16_t breakpoint);
+
+    // The most recent write to the address before the current cycle
+    std::optional<Write> last_write(uint16_t address);
+
+    uint64_t oldest_cycle() const { return _checkpoints.front().state.cycle; }
+
+    size_t checkpoint_count() const { return _checkpoints.size(); }
+
+    size_t memory_usage() const;
+
+private:
+    struct Page
+    {
+        uint8_t index;
+        std::array<uint8_t, Bus::PAGE_SIZE> data;
+    };
+
+    struct Checkpoint
+    {
+        Cpu::State state;
+        // Pages written since the previous checkpoint, as they were at this one
+        std::vector<Page> pages;
+    };
+
+    struct Interrupt
+    {
+        uint64_t cycle;
+        uint8_t isr_number;
+    };
+
+    using Visitor = std::function<void(const Cpu::State&)>;
+    using WriteVisitor = std::function<void(const MemoryWrite&)>;
+
+    void _step(const WriteVisitor& write_visitor = {});
+    void _collect_writes(const WriteVisitor& write_visitor = {});
+    void _checkpoint();
+    void _evict();
+    void _restore(size_t index);
+    void _return_to(uint64_t cycle);
+    void _discard_after(uint64_t cycle);
+    size_t _page_length(size_t index) const;
+
+    // Index of the latest checkpoint taken strictly before the cycle
+    size_t _checkpoint_before(uint64_t cycle) const;
+
+    // Restores a checkpoint and re-executes up to, not including, the end cycle. The visitor
+    // sees the state at every instruction boundary on the way.
+    void _replay(size_t index,
+                 uint64_t end_cycle,
+                 const Visitor& visitor = {},
+                 const WriteVisitor& write_visitor = {});
+
+    std::reference_wrapper<Cpu> _cpu;
+    std::reference_wrapper<Bus> _bus;
+    std::reference_wrapper<buffer> _memory;
+    Config _config;
+
+    buffer _base;
+    std::deque<Checkpoint> _checkpoints;
+    std::vector<bool> _dirty;
+    std::vector<Interrupt> _interrupts;
+    WriteJournal _journal;
+    size_t _delta_bytes;
+};
+} // namespace i8080
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "asm.h"
+#include "cpu.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <vector>
+
+namespace i8080
+{
+// One executed instruction, captured before it runs
+struct TraceRecord
+{
+    static constexpr uint8_t has_registers = 1 << 0;
+
+    uint64_t cycle;
+    uint16_t pc;
+    std::array<uint8_t, sizeof(Opcode)> bytes;
+    uint8_t flags;
+    uint16_t af;
+    uint16_t bc;
+    uint16_t de;
+    uint16_t hl;
+    uint16_t sp;
+};
+
+static_assert(sizeof(TraceRecord) == 24);
+
+// Starts a trace file, followed by `capacity` records. Once `written` exceeds the capacity the
+// oldest record is at index written % capacity.
+struct TraceHeader
+{
+    static constexpr std::array<char, 8> MAGIC = { 'I', '8', '0', '8', '0', 'T', 'R', 'C' };
+    static constexpr uint32_t VERSION = 1;
+
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t capacity;
+    uint64_t written;
+};
+
+// Records executed instructions into a ring of fixed size binary records, either in memory or
+// in a memory mapped file that survives the process. Decoding to text is left to
+// decode_trace(), so leaving tracing on costs a filter check and a 24 byte store per
+// instruction.
+class Tracer final
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 20;
+
+    struct Filter
+    {
+        uint16_t first_pc = 0;
+        uint16_t last_pc = std::numeric_limits<uint16_t>::max();
+        uint64_t first_cycle = 0;
+        uint64_t last_cycle = std::numeric_limits<uint64_t>::max();
+    };
+
+    struct Config
+    {
+        // Rounded up to a power of two
+        size_t capacity = DEFAULT_CAPACITY;
+        bool registers = false;
+        Filter filter;
+    };
+
+    explicit Tracer(Config config);
+    Tracer(const std::filesystem::path& path, Config config);
+    Tracer() :
+        Tracer(Config {})
+    {}
+    ~Tracer();
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    void record(const Opcode& opcode, const Cpu::State& state)
+    {
+        const Filter& filter = _config.filter;
+        if (state.pc < filter.first_pc || state.pc > filter.last_pc ||
+            state.cycle < filter.first_cycle || state.cycle > filter.last_cycle) {
+            return;
+        }
+
+        TraceRecord& record = _records[_header->written & _mask];
+        record.cycle = state.cycle;
+        record.pc = state.pc;
+        std::memcpy(record.bytes.data(), &opcode, sizeof(Opcode));
+
+        if (_config.registers) {
+            record.flags = TraceRecord::has_registers;
+            record.af = state.af;
+            record.bc = state.bc;
+            record.de = state.de;
+            record.hl = state.hl;
+            record.sp = state.sp;
+        } else {
+            record.flags = 0;
+        }
+
+        _header->written++;
+    }
+
+    void set_filter(const Filter& filter) { _config.filter = filter; }
+
+    // Records ever written, including overwritten ones
+    uint64_t written() const { return _header->written; }
+
+    size_t capacity() const { return _header->capacity; }
+
+    // The records still in the ring, oldest first
+    std::vector<TraceRecord> records() const;
+
+    void clear() { _header->written = 0; }
+
+    // Writes the ring as a trace file holding only the records still in it
+    void save(const std::filesystem::path& path) const;
+
+private:
+    Config _config;
+    size_t _mask;
+
+    // In memory the header and records live in _storage, otherwise in the mapping
+    std::vector<uint64_t> _storage;
+    void* _mapping;
+    size_t _mapping_size;
+
+    TraceHeader* _header;
+    TraceRecord* _records;
+};
+
+// Reads a trace file written by Tracer, oldest record first. Throws if it is not a trace.
+std::vector<TraceRecord> read_trace(const std::filesystem::path& path);
+
+// Appends the record in print_dissassembly's format, followed by the registers if it has them
+void decode_trace(fmt::memory_buffer& out, const TraceRecord& record);
+} // namespace i8080
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "common.h"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace i8080
+{
+// Generates 8080 programs of a given shape, for measuring the execution engines on something
+// closer to real guests than the diagnostic ROM. A program sets up its registers, data and
+// stack, then runs a loop body of about the requested number of instructions either forever or
+// for a number of iterations before halting. The same config gives the same program.
+//
+// Programs are loaded at ORIGIN, keep their data between DATA_BASE and the stack, and only talk
+// to STATUS_PORT and DATA_PORT. I/O polls give up after a few reads, so they end without a
+// device too.
+class WorkloadGenerator final
+{
+public:
+    enum class Kind : uint8_t
+    {
+        // Register and immediate arithmetic, logic and rotates
+        alu,
+        // Streams through the working set with two pointers, with occasional strides
+        memory,
+        // Data-dependent forward branches between short runs of arithmetic
+        branchy,
+        // Conditional and unconditional calls into a tree of subroutines
+        calls,
+        // Status port polls followed by data port transfers
+        io,
+        // Rewrites immediates and opcodes in the loop body as it runs
+        self_modifying
+    };
+
+    static constexpr std::array KINDS = { Kind::alu,   Kind::memory, Kind::branchy,
+                                          Kind::calls, Kind::io,     Kind::self_modifying };
+
+    static constexpr uint16_t ORIGIN = 0x100;
+    static constexpr uint16_t DATA_BASE = 0x8000;
+    static constexpr uint16_t STACK_TOP = 0xf000;
+    static constexpr uint8_t STATUS_PORT = 0x10;
+    static constexpr uint8_t DATA_PORT = 0x11;
+
+    static constexpr size_t DEFAULT_LENGTH = 256;
+    static constexpr size_t MAX_LENGTH = 4096;
+    static constexpr size_t DEFAULT_WORKING_SET = 0x1000;
+    // Working sets are rounded up to a power of two between these
+    static constexpr size_t MIN_WORKING_SET = 0x100;
+    static constexpr size_t MAX_WORKING_SET = 0x4000;
+
+    struct Config
+    {
+        Kind kind = Kind::alu;
+        // Instructions in the loop body, roughly
+        size_t length = DEFAULT_LENGTH;
+        // Bytes of data the memory workload walks through
+        size_t working_set = DEFAULT_WORKING_SET;
+        uint64_t seed = 0;
+        // Loop iterations before halting, forever when 0
+        uint16_t iterations = 0;
+    };
+
+    explicit WorkloadGenerator(Config config);
+
+    // The program, to load at ORIGIN
+    buffer generate();
+
+    static std::string_view kind_name(Kind kind);
+    static std::optional<Kind> parse_kind(std::string_view name);
+
+private:
+    // Where the loop keeps what it needs across iterations, just above the stack
+    static constexpr uint16_t COUNTER = STACK_TOP;
+    static constexpr uint16_t FIRST_POINTER = STACK_TOP + 2;
+    static constexpr uint16_t SECOND_POINTER = STACK_TOP + 4;
+
+    uint16_t _address() const { return ORIGIN + _program.size(); }
+
+    void _emit(uint8_t byte) { _program.push_back(byte); }
+
+    void _emit(uint8_t opcode, uint8_t operand);
+    void _emit_word(uint8_t opcode, uint16_t operand);
+    // Points the 16-bit operand at the byte offset to the current address
+    void _patch(size_t operand_offset);
+
+    // Uniform below the count
+    uint32_t _random(uint32_t count);
+
+    // One arithmetic, logic, move or rotate instruction touching only the given registers
+    void _alu(std::span<const uint8_t> registers);
+    // Keeps the pair's high register inside the working set
+    void _wrap(uint8_t high_register);
+
+    void _prologue();
+    void _epilogue(uint16_t loop);
+
+    void _alu_body();
+    void _memory_body();
+    void _branchy_body();
+    void _calls_body(const std::vector<uint16_t>& subroutines);
+    void _io_body();
+    void _self_modifying_body();
+    std::vector<uint16_t> _subroutines();
+
+    Config _config;
+    uint16_t _working_set_mask;
+    std::mt19937_64 _engine;
+    buffer _program;
+};
+} // namespace i8080
@@ -0,0 +1,111 @@
+#include "machine.h"
+
+#include <fmt/format.h>
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+#include <sys/mman.h>
+
+namespace i8080
+{
+MachinePool::MachinePool(size_t capacity) :
+    _arena(nullptr),
+    _arena_size(0),
+    _capacity(capacity),
+    _huge_pages(false),
+    _live(capacity, false)
+{
+    if (capacity == 0 || capacity > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error(fmt::format("Invalid machine pool capacity: {}", capacity));
+    }
+
+    _arena_size = (capacity * sizeof(Machine) + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE *
+                  HUGE_PAGE_SIZE;
+
+    // Explicit huge pages are taken from the reserved ones up front, so this fails rather than
+    // faulting later when there aren't enough
+    void* arena = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    arena = mmap(nullptr,
+                 _arena_size,
+                 PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                 -1,
+                 0);
+    _huge_pages = (arena != MAP_FAILED);
+#endif
+
+    // Otherwise pages are only backed once touched, so a large pool costs address space until
+    // it fills
+    if (arena == MAP_FAILED) {
+        arena = mmap(nullptr,
+                     _arena_size,
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                     -1,
+                     0);
+        if (arena == MAP_FAILED) {
+            throw std::runtime_error(fmt::format("Could not map {} bytes for {} machines: {}",
+                                                 _arena_size,
+                                                 capacity,
+                                                 std::strerror(errno)));
+        }
+
+#ifdef MADV_HUGEPAGE
+        // Only a hint, the pool works the same without transparent huge pages
+        madvise(arena, _arena_size, MADV_HUGEPAGE);
+#endif
+    }
+
+    _arena = static_cast<std::byte*>(arena);
+
+    _free.reserve(capacity);
+    for (size_t index = capacity; index > 0; index--) {
+        _free.push_back(index - 1);
+    }
+}
+
+MachinePool::~MachinePool()
+{
+    for (size_t index = 0; index < _capacity; index++) {
+        if (_live[index]) {
+            _slot(index)->~Machine();
+        }
+    }
+
+    munmap(_arena, _arena_size);
+}
+
+Machine* MachinePool::create(uint16_t entry_point, Cpu::Timing timing)
+{
+    if (_free.empty()) {
+        return nullptr;
+    }
+
+    // The slot is only taken once the machine is built, so a throwing constructor leaves it free
+    uint32_t index = _free.back();
+    Machine* machine = new (_slot(index)) Machine(entry_point, timing);
+    _free.pop_back();
+    _live[index] = true;
+
+    return machine;
+}
+
+void MachinePool::destroy(Machine* machine)
+{
+    // Compared as addresses, since subtracting a pointer from elsewhere is undefined
+    uintptr_t offset = reinterpret_cast<uintptr_t>(machine) - reinterpret_cast<uintptr_t>(_arena);
+    size_t index = offset / sizeof(Machine);
+    if (offset % sizeof(Machine) != 0 || index >= _capacity || !_live[index]) {
+        throw std::runtime_error("Machine does not belong to the pool");
+    }
+
+    machine->~Machine();
+    _live[index] = false;
+    _free.push_back(index);
+}
+} // namespace i8080
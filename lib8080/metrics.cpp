@@ -0,0 +1,225 @@
+#include "metrics.h"
+
+#include <fmt/format.h>
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace i8080
+{
+// Label values may not contain raw backslashes, quotes or newlines
+static std::string escape_label(std::string_view value)
+{
+    std::string escaped;
+    for (char c : value) {
+        switch (c) {
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        default:
+            escaped += c;
+        }
+    }
+
+    return escaped;
+}
+
+Metrics::Metrics(std::string instance) :
+    _instance(std::move(instance)),
+    _created(std::chrono::steady_clock::now()),
+    _instructions(0),
+    _cycles(0),
+    _halts(0),
+    _interrupts(0),
+    _interrupt_latency(0),
+    _max_interrupt_latency(0),
+    _block_hits(0),
+    _block_misses(0)
+{
+    for (size_t port = 0; port < Bus::PORT_COUNT; port++) {
+        _port_reads[port].store(0, std::memory_order_relaxed);
+        _port_writes[port].store(0, std::memory_order_relaxed);
+    }
+}
+
+Metrics::Snapshot Metrics::snapshot() const
+{
+    Snapshot snapshot;
+    snapshot.instructions = _instructions.load(std::memory_order_relaxed);
+    snapshot.cycles = _cycles.load(std::memory_order_relaxed);
+    snapshot.halts = _halts.load(std::memory_order_relaxed);
+    snapshot.interrupts = _interrupts.load(std::memory_order_relaxed);
+    snapshot.interrupt_latency = _interrupt_latency.load(std::memory_order_relaxed);
+    snapshot.max_interrupt_latency = _max_interrupt_latency.load(std::memory_order_relaxed);
+
+    for (size_t port = 0; port < Bus::PORT_COUNT; port++) {
+        snapshot.port_reads[port] = _port_reads[port].load(std::memory_order_relaxed);
+        snapshot.port_writes[port] = _port_writes[port].load(std::memory_order_relaxed);
+    }
+
+    snapshot.block_hits = _block_hits.load(std::memory_order_relaxed);
+    snapshot.block_misses = _block_misses.load(std::memory_order_relaxed);
+    snapshot.uptime = std::chrono::steady_clock::now() - _created;
+    return snapshot;
+}
+
+std::string Metrics::prometheus(std::span<const Metrics* const> instances)
+{
+    std::vector<Snapshot> snapshots;
+    std::vector<std::string> labels;
+    for (const Metrics* metrics : instances) {
+        snapshots.push_back(metrics->snapshot());
+        labels.push_back(fmt::format("instance=\"{}\"", escape_label(metrics->instance())));
+    }
+
+    fmt::memory_buffer out;
+    auto it = std::back_inserter(out);
+
+    auto family = [&](std::string_view name,
+                      std::string_view type,
+                      std::string_view help,
+                      auto value) {
+        fmt::format_to(it, "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+        for (size_t i = 0; i < snapshots.size(); i++) {
+            fmt::format_to(it, "{}{{{}}} {}\n", name, labels[i], value(snapshots[i]));
+        }
+    };
+
+    auto per_port = [&](std::string_view name,
+                        std::string_view help,
+                        const std::array<uint64_t, Bus::PORT_COUNT> Snapshot::*counters) {
+        fmt::format_to(it, "# HELP {} {}\n# TYPE {} counter\n", name, help, name);
+        for (size_t i = 0; i < snapshots.size(); i++) {
+            const auto& ports = snapshots[i].*counters;
+            for (size_t port = 0; port < Bus::PORT_COUNT; port++) {
+                if (ports[port]) {
+                    fmt::format_to(it,
+                                   "{}{{{},port=\"{}\"}} {}\n",
+                                   name,
+                                   labels[i],
+                                   port,
+                                   ports[port]);
+                }
+            }
+        }
+    };
+
+    family("i8080_instructions_retired_total",
+           "counter",
+           "Instructions executed by the guest CPU.",
+           [](const Snapshot& s) { return s.instructions; });
+    family("i8080_cycles_total",
+           "counter",
+           "Guest clock cycles executed.",
+           [](const Snapshot& s) { return s.cycles; });
+    family("i8080_guest_mips",
+           "gauge",
+           "Guest instructions per second in millions, averaged over the uptime.",
+           [](const Snapshot& s) { return s.mips(); });
+    family("i8080_halts_total",
+           "counter",
+           "HLT instructions executed.",
+           [](const Snapshot& s) { return s.halts; });
+    family("i8080_interrupts_total",
+           "counter",
+           "Interrupts dispatched.",
+           [](const Snapshot& s) { return s.interrupts; });
+    family("i8080_interrupt_latency_cycles_total",
+           "counter",
+           "Cycles from raising an interrupt to dispatching it, summed.",
+           [](const Snapshot& s) { return s.interrupt_latency; });
+    family("i8080_interrupt_latency_cycles_max",
+           "gauge",
+           "Longest cycles from raising an interrupt to dispatching it.",
+           [](const Snapshot& s) { return s.max_interrupt_latency; });
+    family("i8080_block_cache_hits_total",
+           "counter",
+           "Blocks fast timing found already measured.",
+           [](const Snapshot& s) { return s.block_hits; });
+    family("i8080_block_cache_misses_total",
+           "counter",
+           "Blocks fast timing had to measure, first or after their code was written.",
+           [](const Snapshot& s) { return s.block_misses; });
+    family("i8080_block_cache_hit_ratio",
+           "gauge",
+           "Share of block lookups that hit, over the uptime.",
+           [](const Snapshot& s) { return s.block_hit_ratio(); });
+    family("i8080_uptime_seconds",
+           "gauge",
+           "Seconds since the metrics were created.",
+           [](const Snapshot& s) { return s.uptime.count(); });
+
+    per_port("i8080_port_reads_total", "IN instructions per port.", &Snapshot::port_reads);
+    per_port("i8080_port_writes_total", "OUT instructions per port.", &Snapshot::port_writes);
+
+    return fmt::to_string(out);
+}
+
+std::string Metrics::prometheus() const
+{
+    const Metrics* self = this;
+    return prometheus(std::span(&self, 1));
+}
+
+void Metrics::export_prometheus(const Sink& sink) const
+{
+    sink(prometheus());
+}
+
+void Metrics::export_prometheus(const std::filesystem::path& path) const
+{
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error(fmt::format("Could not open file: {}", temporary.string()));
+        }
+
+        file << prometheus();
+    }
+
+    std::filesystem::rename(temporary, path);
+}
+
+MetricsExporter::MetricsExporter(std::vector<const Metrics*> instances,
+                                 Metrics::Sink sink,
+                                 std::chrono::milliseconds period) :
+    _instances(std::move(instances)),
+    _sink(std::move(sink)),
+    _period(period)
+{
+    _thread = std::jthread([this](std::stop_token stop) {
+        std::unique_lock lock(_lock);
+        while (true) {
+            // Only a stop request wakes it up early
+            _wakeup.wait_for(lock, stop, _period, [] { return false; });
+            if (stop.stop_requested()) {
+                return;
+            }
+
+            _export();
+        }
+    });
+}
+
+MetricsExporter::~MetricsExporter()
+{
+    _thread.request_stop();
+    _thread.join();
+    _export();
+}
+
+void MetricsExporter::_export() const
+{
+    _sink(Metrics::prometheus(_instances));
+}
+} // namespace i8080
@@ -0,0 +1,566 @@
+#include "model.h"
+
+#include <bit>
+#include <utility>
+
+namespace i8080
+{
+static constexpr uint8_t SIGN = 0x80;
+static constexpr uint8_t ZERO = 0x40;
+static constexpr uint8_t AUX = 0x10;
+static constexpr uint8_t PARITY = 0x04;
+static constexpr uint8_t CARRY = 0x01;
+// Bit 1 always reads as set, bits 3 and 5 as clear
+static constexpr uint8_t FLAGS_SET = 0x02;
+static constexpr uint8_t FLAGS_USED = SIGN | ZERO | AUX | PARITY | CARRY;
+
+static constexpr uint8_t MEMORY = 6;
+static constexpr uint8_t ACCUMULATOR = 7;
+static constexpr uint8_t STACK_POINTER = 3;
+
+// Cycles, from the datasheet
+static constexpr uint8_t SHORT_CYCLES = 4;
+static constexpr uint8_t REGISTER_CYCLES = 5;
+static constexpr uint8_t MEMORY_CYCLES = 7;
+static constexpr uint8_t MEMORY_MODIFY_CYCLES = 10;
+static constexpr uint8_t WORD_CYCLES = 10;
+static constexpr uint8_t PUSH_CYCLES = 11;
+static constexpr uint8_t DIRECT_CYCLES = 13;
+static constexpr uint8_t DIRECT_WORD_CYCLES = 16;
+static constexpr uint8_t CALL_CYCLES = 17;
+static constexpr uint8_t XTHL_CYCLES = 18;
+static constexpr uint8_t BRANCH_TAKEN_CYCLES = 6;
+// IN and OUT reach the bus after their opcode fetch and operand read
+static constexpr uint8_t IO_ACCESS_CYCLES = 7;
+
+ReferenceModel::ReferenceModel(Bus& bus, const Cpu::State& state) :
+    _bus(bus),
+    _state(state)
+{}
+
+void ReferenceModel::step()
+{
+    if (_state.halt) {
+        return;
+    }
+
+    _execute(_fetch());
+
+    if (_state.interrupt_vector) {
+        _dispatch();
+    }
+}
+
+void ReferenceModel::interrupt(uint8_t isr_number)
+{
+    if (!_state.interrupts_enabled) {
+        return;
+    }
+
+    _state.interrupts_enabled = false;
+    _state.interrupt_vector = static_cast<Instruction>(0xc7 | (isr_number << 3));
+
+    // An interrupt is the only way out of HLT, and the RST runs right away
+    if (_state.halt) {
+        _dispatch();
+    }
+}
+
+void ReferenceModel::_dispatch()
+{
+    auto vector = static_cast<uint8_t>(*_state.interrupt_vector);
+    _state.interrupt_vector.reset();
+    _state.halt = false;
+
+    _push(_state.pc);
+    _state.pc = vector & 0x38;
+    _state.cycle += PUSH_CYCLES;
+}
+
+uint8_t ReferenceModel::_read(uint16_t address)
+{
+    uint8_t value;
+    _bus.get().mem_read(address, value);
+    return value;
+}
+
+uint16_t ReferenceModel::_read_word(uint16_t address)
+{
+    uint8_t low = _read(address);
+    return low | (_read(address + 1) << 8);
+}
+
+void ReferenceModel::_write(uint16_t address, uint8_t value)
+{
+    _bus.get().mem_write(address, value);
+}
+
+void ReferenceModel::_write_word(uint16_t address, uint16_t value)
+{
+    _write(address, value & 0xff);
+    _write(address + 1, value >> 8);
+}
+
+uint8_t ReferenceModel::_fetch()
+{
+    return _read(_state.pc++);
+}
+
+uint16_t ReferenceModel::_fetch_word()
+{
+    uint8_t low = _fetch();
+    return low | (_fetch() << 8);
+}
+
+void ReferenceModel::_push(uint16_t value)
+{
+    _state.sp -= 2;
+    _write_word(_state.sp, value);
+}
+
+uint16_t ReferenceModel::_pop()
+{
+    uint16_t value = _read_word(_state.sp);
+    _state.sp += 2;
+    return value;
+}
+
+uint8_t ReferenceModel::_get(uint8_t index)
+{
+    switch (index) {
+    case 0:
+        return _state.b;
+    case 1:
+        return _state.c;
+    case 2:
+        return _state.d;
+    case 3:
+        return _state.e;
+    case 4:
+        return _state.h;
+    case 5:
+        return _state.l;
+    case MEMORY:
+        return _read(_state.hl);
+    default:
+        return _state.a;
+    }
+}
+
+void ReferenceModel::_set(uint8_t index, uint8_t value)
+{
+    switch (index) {
+    case 0:
+        _state.b = value;
+        break;
+    case 1:
+        _state.c = value;
+        break;
+    case 2:
+        _state.d = value;
+        break;
+    case 3:
+        _state.e = value;
+        break;
+    case 4:
+        _state.h = value;
+        break;
+    case 5:
+        _state.l = value;
+        break;
+    case MEMORY:
+        _write(_state.hl, value);
+        break;
+    default:
+        _state.a = value;
+        break;
+    }
+}
+
+uint16_t ReferenceModel::_get_pair(uint8_t index) const
+{
+    switch (index) {
+    case 0:
+        return _state.bc;
+    case 1:
+        return _state.de;
+    case 2:
+        return _state.hl;
+    default:
+        return _state.sp;
+    }
+}
+
+void ReferenceModel::_set_pair(uint8_t index, uint16_t value)
+{
+    switch (index) {
+    case 0:
+        _state.bc = value;
+        break;
+    case 1:
+        _state.de = value;
+        break;
+    case 2:
+        _state.hl = value;
+        break;
+    default:
+        _state.sp = value;
+        break;
+    }
+}
+
+// NZ, Z, NC, C, PO, PE, P and M
+bool ReferenceModel::_condition(uint8_t index) const
+{
+    static constexpr uint8_t FLAGS[] = { ZERO, CARRY, PARITY, SIGN };
+    return _flag(FLAGS[index >> 1]) == (index & 1);
+}
+
+void ReferenceModel::_set_flag(uint8_t flag, bool value)
+{
+    _state.flags.status = value ? (_state.flags.status | flag) : (_state.flags.status & ~flag);
+}
+
+void ReferenceModel::_set_zero_sign_parity(uint8_t value)
+{
+    _set_flag(ZERO, value == 0);
+    _set_flag(SIGN, value & 0x80);
+    _set_flag(PARITY, std::popcount(value) % 2 == 0);
+}
+
+// ADD, ADC, SUB, SBB, ANA, XRA, ORA and CMP. Subtraction adds the complement with the carry
+// inverted, which is where its auxiliary carry comes from; the carry flag is then the borrow.
+void ReferenceModel::_alu(uint8_t operation, uint8_t value)
+{
+    uint8_t a = _state.a;
+    uint8_t result;
+
+    switch (operation) {
+    case 0:
+    case 1:
+    {
+        unsigned carry = (operation == 1) && _flag(CARRY);
+        unsigned sum = a + value + carry;
+        result = sum & 0xff;
+        _set_flag(CARRY, sum > 0xff);
+        _set_flag(AUX, (a & 0xf) + (value & 0xf) + carry > 0xf);
+    } break;
+    case 2:
+    case 3:
+    case 7:
+    {
+        unsigned carry = !((operation == 3) && _flag(CARRY));
+        unsigned sum = a + static_cast<uint8_t>(~value) + carry;
+        result = sum & 0xff;
+        _set_flag(CARRY, sum <= 0xff);
+        _set_flag(AUX, (a & 0xf) + (~value & 0xf) + carry > 0xf);
+    } break;
+    case 4:
+        result = a & value;
+        _set_flag(CARRY, false);
+        _set_flag(AUX, (a | value) & 0x08);
+        break;
+    case 5:
+        result = a ^ value;
+        _set_flag(CARRY, false);
+        _set_flag(AUX, false);
+        break;
+    default:
+        result = a | value;
+        _set_flag(CARRY, false);
+        _set_flag(AUX, false);
+        break;
+    }
+
+    _set_zero_sign_parity(result);
+    if (operation != 7) {
+        _state.a = result;
+    }
+}
+
+void ReferenceModel::_execute(uint8_t opcode)
+{
+    uint8_t destination = (opcode >> 3) & 7;
+    uint8_t source = opcode & 7;
+    uint8_t pair = (opcode >> 4) & 3;
+    uint8_t cycles = SHORT_CYCLES;
+
+    if (opcode == 0x76) {
+        // HLT
+        _state.halt = true;
+        _state.cycle += MEMORY_CYCLES;
+        return;
+    }
+
+    if (opcode >= 0x40 && opcode < 0x80) {
+        // MOV
+        _set(destination, _get(source));
+        _state.cycle += (destination == MEMORY || source == MEMORY) ? MEMORY_CYCLES
+                                                                    : REGISTER_CYCLES;
+        return;
+    }
+
+    if (opcode >= 0x80 && opcode < 0xc0) {
+        _alu(destination, _get(source));
+        _state.cycle += (source == MEMORY) ? MEMORY_CYCLES : SHORT_CYCLES;
+        return;
+    }
+
+    if (opcode < 0x40) {
+        switch (opcode & 0x0f) {
+        case 0x01:
+            _set_pair(pair, _fetch_word());
+            cycles = WORD_CYCLES;
+            break;
+        case 0x03:
+            _set_pair(pair, _get_pair(pair) + 1);
+            cycles = REGISTER_CYCLES;
+            break;
+        case 0x09:
+        {
+            uint32_t sum = _state.hl + _get_pair(pair);
+            _state.hl = sum & 0xffff;
+            _set_flag(CARRY, sum > 0xffff);
+            cycles = WORD_CYCLES;
+        } break;
+        case 0x0b:
+            _set_pair(pair, _get_pair(pair) - 1);
+            cycles = REGISTER_CYCLES;
+            break;
+        default:
+            break;
+        }
+
+        switch (opcode & 0x07) {
+        case 0x04:
+        case 0x05:
+        {
+            // INR and DCR leave the carry alone
+            uint8_t value = _get(destination) + ((opcode & 1) ? -1 : 1);
+            _set(destination, value);
+            _set_zero_sign_parity(value);
+            _set_flag(AUX, (opcode & 1) ? (value & 0xf) != 0xf : (value & 0xf) == 0);
+            cycles = (destination == MEMORY) ? MEMORY_MODIFY_CYCLES : REGISTER_CYCLES;
+        } break;
+        case 0x06:
+            _set(destination, _fetch());
+            cycles = (destination == MEMORY) ? MEMORY_MODIFY_CYCLES : MEMORY_CYCLES;
+            break;
+        default:
+            break;
+        }
+
+        switch (opcode) {
+        case 0x02:
+        case 0x12:
+            _write(_get_pair(pair), _state.a);
+            cycles = MEMORY_CYCLES;
+            break;
+        case 0x0a:
+        case 0x1a:
+            _state.a = _read(_get_pair(pair));
+            cycles = MEMORY_CYCLES;
+            break;
+        case 0x22:
+            _write_word(_fetch_word(), _state.hl);
+            cycles = DIRECT_WORD_CYCLES;
+            break;
+        case 0x2a:
+            _state.hl = _read_word(_fetch_word());
+            cycles = DIRECT_WORD_CYCLES;
+            break;
+        case 0x32:
+            _write(_fetch_word(), _state.a);
+            cycles = DIRECT_CYCLES;
+            break;
+        case 0x3a:
+            _state.a = _read(_fetch_word());
+            cycles = DIRECT_CYCLES;
+            break;
+        case 0x07:
+            _set_flag(CARRY, _state.a & 0x80);
+            _state.a = std::rotl(_state.a, 1);
+            break;
+        case 0x0f:
+            _set_flag(CARRY, _state.a & 1);
+            _state.a = std::rotr(_state.a, 1);
+            break;
+        case 0x17:
+        {
+            bool carry = _flag(CARRY);
+            _set_flag(CARRY, _state.a & 0x80);
+            _state.a = (_state.a << 1) | carry;
+        } break;
+        case 0x1f:
+        {
+            bool carry = _flag(CARRY);
+            _set_flag(CARRY, _state.a & 1);
+            _state.a = (_state.a >> 1) | (carry << 7);
+        } break;
+        case 0x27:
+        {
+            uint8_t correction = 0;
+            bool carry = _flag(CARRY);
+            if ((_state.a & 0xf) > 9 || _flag(AUX)) {
+                correction |= 0x06;
+            }
+
+            if (_state.a > 0x99 || carry) {
+                correction |= 0x60;
+                carry = true;
+            }
+
+            _alu(0, correction);
+            _set_flag(CARRY, carry);
+        } break;
+        case 0x2f:
+            _state.a = ~_state.a;
+            break;
+        case 0x37:
+            _set_flag(CARRY, true);
+            break;
+        case 0x3f:
+            _set_flag(CARRY, !_flag(CARRY));
+            break;
+        default:
+            break;
+        }
+
+        _state.cycle += cycles;
+        return;
+    }
+
+    switch (opcode & 0x07) {
+    case 0x00:
+        // Rcc
+        cycles = REGISTER_CYCLES;
+        if (_condition(destination)) {
+            _state.pc = _pop();
+            cycles += BRANCH_TAKEN_CYCLES;
+        }
+        break;
+    case 0x02:
+    {
+        uint16_t target = _fetch_word();
+        if (_condition(destination)) {
+            _state.pc = target;
+        }
+
+        cycles = WORD_CYCLES;
+    } break;
+    case 0x04:
+    {
+        uint16_t target = _fetch_word();
+        cycles = PUSH_CYCLES;
+        if (_condition(destination)) {
+            _push(_state.pc);
+            _state.pc = target;
+            cycles += BRANCH_TAKEN_CYCLES;
+        }
+    } break;
+    case 0x06:
+        _alu(destination, _fetch());
+        cycles = MEMORY_CYCLES;
+        break;
+    case 0x07:
+        _push(_state.pc);
+        _state.pc = opcode & 0x38;
+        cycles = PUSH_CYCLES;
+        break;
+    default:
+        break;
+    }
+
+    switch (opcode & 0x0f) {
+    case 0x01:
+        if (pair == STACK_POINTER) {
+            uint16_t value = _pop();
+            _state.a = value >> 8;
+            _state.flags.status = (value & FLAGS_USED) | FLAGS_SET;
+        } else {
+            _set_pair(pair, _pop());
+        }
+
+        cycles = WORD_CYCLES;
+        break;
+    case 0x05:
+        if (pair == STACK_POINTER) {
+            _push((_state.a << 8) | (_state.flags.status & FLAGS_USED) | FLAGS_SET);
+        } else {
+            _push(_get_pair(pair));
+        }
+
+        cycles = PUSH_CYCLES;
+        break;
+    default:
+        break;
+    }
+
+    switch (opcode) {
+    case 0xc3:
+    case 0xcb:
+        _state.pc = _fetch_word();
+        cycles = WORD_CYCLES;
+        break;
+    case 0xc9:
+    case 0xd9:
+        _state.pc = _pop();
+        cycles = WORD_CYCLES;
+        break;
+    case 0xcd:
+    case 0xdd:
+    case 0xed:
+    case 0xfd:
+    {
+        uint16_t target = _fetch_word();
+        _push(_state.pc);
+        _state.pc = target;
+        cycles = CALL_CYCLES;
+    } break;
+    case 0xd3:
+    {
+        uint8_t port = _fetch();
+        _state.cycle += IO_ACCESS_CYCLES;
+        _bus.get().write(port, _state.a);
+        _state.cycle -= IO_ACCESS_CYCLES;
+        cycles = WORD_CYCLES;
+    } break;
+    case 0xdb:
+    {
+        uint8_t port = _fetch();
+        _state.cycle += IO_ACCESS_CYCLES;
+        _bus.get().read(port, _state.a);
+        _state.cycle -= IO_ACCESS_CYCLES;
+        cycles = WORD_CYCLES;
+    } break;
+    case 0xe3:
+    {
+        uint16_t value = _read_word(_state.sp);
+        _write_word(_state.sp, _state.hl);
+        _state.hl = value;
+        cycles = XTHL_CYCLES;
+    } break;
+    case 0xe9:
+        _state.pc = _state.hl;
+        cycles = REGISTER_CYCLES;
+        break;
+    case 0xeb:
+        std::swap(_state.de, _state.hl);
+        break;
+    case 0xf3:
+        _state.interrupts_enabled = false;
+        break;
+    case 0xf9:
+        _state.sp = _state.hl;
+        cycles = REGISTER_CYCLES;
+        break;
+    case 0xfb:
+        _state.interrupts_enabled = true;
+        break;
+    default:
+        break;
+    }
+
+    _state.cycle += cycles;
+}
+} // namespace i8080
@@ -0,0 +1,144 @@
+#include "pacer.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+
+namespace i8080
+{
+static constexpr int64_t NANOSECONDS_PER_SECOND = 1'000'000'000;
+
+// Deadlines divide by the clock
+static void check_clock(uint64_t clock_hz)
+{
+    if (clock_hz == 0) {
+        throw std::runtime_error(fmt::format("Invalid pacer clock: {} Hz", clock_hz));
+    }
+}
+
+Pacer::Pacer(Cpu& cpu, Config config, Runner runner) :
+    _cpu(cpu),
+    _runner(std::move(runner)),
+    _config(config),
+    _clock_hz(config.clock_hz),
+    _paced(true),
+    _anchored(false),
+    _anchor_time {},
+    _anchor_cycle(0),
+    _anchor_clock_hz(config.clock_hz)
+{
+    check_clock(config.clock_hz);
+
+    if (!_runner) {
+        _runner = [&cpu](uint64_t cycles) { return cpu.run(cycles); };
+    }
+}
+
+Cpu::StopReason Pacer::run(uint64_t cycles)
+{
+    const Cpu& cpu = _cpu.get();
+    uint64_t end = cpu.state().cycle + cycles;
+
+    while (cpu.state().cycle < end) {
+        // Flat out still runs in slices, so switching back to paced takes effect quickly
+        uint64_t clock_hz = _clock_hz.load(std::memory_order_relaxed);
+        uint64_t slice_cycles = std::max<uint64_t>(
+            1, (clock_hz * _config.slice.count()) / NANOSECONDS_PER_SECOND);
+        bool paced = this->paced();
+
+        // A new clock starts a new schedule from here
+        if (paced && (!_anchored || clock_hz != _anchor_clock_hz)) {
+            _anchor(clock_hz);
+        } else if (!paced) {
+            _anchored = false;
+        }
+
+        Cpu::StopReason reason = _runner(std::min(slice_cycles, end - cpu.state().cycle));
+
+        if (paced) {
+            _statistics.slices++;
+            _wait(_deadline(cpu.state().cycle));
+        }
+
+        if (reason != Cpu::StopReason::cycles) {
+            return reason;
+        }
+    }
+
+    return Cpu::StopReason::cycles;
+}
+
+void Pacer::set_clock(uint64_t clock_hz)
+{
+    check_clock(clock_hz);
+    _clock_hz.store(clock_hz, std::memory_order_relaxed);
+}
+
+timespec Pacer::_now()
+{
+    timespec now {};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now;
+}
+
+std::chrono::nanoseconds Pacer::_difference(const timespec& later, const timespec& earlier)
+{
+    return std::chrono::nanoseconds(((later.tv_sec - earlier.tv_sec) * NANOSECONDS_PER_SECOND) +
+                                    (later.tv_nsec - earlier.tv_nsec));
+}
+
+void Pacer::_anchor(uint64_t clock_hz)
+{
+    _anchor_time = _now();
+    _anchor_cycle = _cpu.get().state().cycle;
+    _anchor_clock_hz = clock_hz;
+    _anchored = true;
+}
+
+timespec Pacer::_deadline(uint64_t cycle) const
+{
+    // Split into whole seconds first so long runs don't overflow
+    uint64_t elapsed = cycle - _anchor_cycle;
+    uint64_t seconds = elapsed / _anchor_clock_hz;
+    uint64_t nanoseconds = ((elapsed % _anchor_clock_hz) * NANOSECONDS_PER_SECOND) /
+                           _anchor_clock_hz;
+
+    timespec deadline = _anchor_time;
+    deadline.tv_sec += static_cast<time_t>(seconds);
+    deadline.tv_nsec += static_cast<long>(nanoseconds);
+    if (deadline.tv_nsec >= NANOSECONDS_PER_SECOND) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= NANOSECONDS_PER_SECOND;
+    }
+
+    return deadline;
+}
+
+void Pacer::_wait(const timespec& deadline)
+{
+    timespec before = _now();
+    std::chrono::nanoseconds lateness = _difference(before, deadline);
+
+    if (lateness.count() >= 0) {
+        _statistics.overruns++;
+        _statistics.drift = lateness;
+        _statistics.max_drift = std::max(_statistics.max_drift, lateness);
+
+        if (lateness > _config.slice * MAX_BACKLOG_SLICES) {
+            _statistics.resyncs++;
+            _anchor(_anchor_clock_hz);
+        }
+        return;
+    }
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+    }
+
+    timespec after = _now();
+    _statistics.slept += _difference(after, before);
+    _statistics.drift = _difference(after, deadline);
+    _statistics.max_drift = std::max(_statistics.max_drift, _statistics.drift);
+}
+} // namespace i8080
@@ -0,0 +1,138 @@
+#include "profile.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace i8080
+{
+// "MVI B," reads better as "MVI B" in a report
+static std::string_view mnemonic(uint8_t opcode)
+{
+    std::string_view name = get_opcode_metadata(static_cast<Instruction>(opcode)).name;
+    while (!name.empty() && (name.back() == ',' || name.back() == ' ')) {
+        name.remove_suffix(1);
+    }
+
+    return name;
+}
+
+static double percent(uint64_t part, uint64_t total)
+{
+    return total ? (100.0 * part / total) : 0.0;
+}
+
+OpcodeProfile::OpcodeProfile(bool track_pairs) :
+    _pairs(track_pairs ? 0x10000 : 0)
+{
+    reset();
+}
+
+void OpcodeProfile::reset()
+{
+    _counters.fill({});
+    std::ranges::fill(_pairs, 0);
+    _previous = static_cast<uint8_t>(Instruction::NOP);
+}
+
+std::string OpcodeProfile::report(Format format, size_t top_pairs) const
+{
+    std::vector<uint16_t> opcodes;
+    uint64_t total_executions = 0;
+    uint64_t total_cycles = 0;
+    for (uint16_t opcode = 0; opcode < _counters.size(); opcode++) {
+        total_executions += _counters[opcode].executions;
+        total_cycles += _counters[opcode].cycles;
+        if (_counters[opcode].executions) {
+            opcodes.push_back(opcode);
+        }
+    }
+
+    std::ranges::sort(opcodes, [this](uint16_t a, uint16_t b) {
+        return _counters[a].cycles > _counters[b].cycles;
+    });
+
+    std::vector<uint32_t> pairs;
+    for (uint32_t pair = 0; pair < _pairs.size(); pair++) {
+        if (_pairs[pair]) {
+            pairs.push_back(pair);
+        }
+    }
+
+    auto by_count = [this](uint32_t a, uint32_t b) { return _pairs[a] > _pairs[b]; };
+    size_t shown_pairs = std::min(top_pairs, pairs.size());
+    std::ranges::partial_sort(pairs, pairs.begin() + shown_pairs, by_count);
+    pairs.resize(shown_pairs);
+
+    fmt::memory_buffer out;
+    auto it = std::back_inserter(out);
+
+    if (format == Format::text) {
+        fmt::format_to(it,
+                       "{:<6} {:<10} {:>14} {:>7} {:>16} {:>7}\n",
+                       "opcode",
+                       "mnemonic",
+                       "executions",
+                       "%",
+                       "cycles",
+                       "%");
+
+        for (uint16_t opcode : opcodes) {
+            fmt::format_to(it,
+                           "{:#04x}   {:<10} {:>14} {:>6.2f}% {:>16} {:>6.2f}%\n",
+                           opcode,
+                           mnemonic(opcode),
+                           _counters[opcode].executions,
+                           percent(_counters[opcode].executions, total_executions),
+                           _counters[opcode].cycles,
+                           percent(_counters[opcode].cycles, total_cycles));
+        }
+
+        if (!pairs.empty()) {
+            fmt::format_to(it, "\n{:<24} {:>14}\n", "pair", "count");
+        }
+
+        for (uint32_t pair : pairs) {
+            fmt::format_to(it,
+                           "{:<24} {:>14}\n",
+                           fmt::format("{} -> {}", mnemonic(pair >> 8), mnemonic(pair & 0xff)),
+                           _pairs[pair]);
+        }
+
+        return fmt::to_string(out);
+    }
+
+    fmt::format_to(it,
+                   "{{\"executions\": {}, \"cycles\": {}, \"opcodes\": [",
+                   total_executions,
+                   total_cycles);
+
+    for (size_t i = 0; i < opcodes.size(); i++) {
+        uint16_t opcode = opcodes[i];
+        fmt::format_to(it,
+                       "{}\n  {{\"opcode\": {}, \"mnemonic\": \"{}\", \"executions\": {}, "
+                       "\"cycles\": {}}}",
+                       i ? "," : "",
+                       opcode,
+                       mnemonic(opcode),
+                       _counters[opcode].executions,
+                       _counters[opcode].cycles);
+    }
+
+    fmt::format_to(it, "\n], \"pairs\": [");
+
+    for (size_t i = 0; i < pairs.size(); i++) {
+        uint32_t pair = pairs[i];
+        fmt::format_to(it,
+                       "{}\n  {{\"first\": \"{}\", \"second\": \"{}\", \"count\": {}}}",
+                       i ? "," : "",
+                       mnemonic(pair >> 8),
+                       mnemonic(pair & 0xff),
+                       _pairs[pair]);
+    }
+
+    fmt::format_to(it, "\n]}}\n");
+    return fmt::to_string(out);
+}
+} // namespace i8080
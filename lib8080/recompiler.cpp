@@ -0,0 +1,493 @@
+#include "recompiler.h"
+#include "bus.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <optional>
+
+namespace i8080
+{
+// Register operands in opcode order, M is memory at HL
+static constexpr std::array<std::string_view, 8> REGISTERS = { "s.b", "s.c", "s.d", "s.e",
+                                                               "s.h", "s.l", "",    "s.a" };
+static constexpr std::array<std::string_view, 4> PAIRS = { "s.bc", "s.de", "s.hl", "s.sp" };
+static constexpr std::array<std::string_view, 8> ALU_OPERATIONS = { "add", "adc", "sub", "sbb",
+                                                                    "ana", "xra", "ora", "cmp" };
+static constexpr std::array<std::string_view, 8> CONDITIONS = {
+    "!s.flags.zero",   "s.flags.zero",   "!s.flags.carry", "s.flags.carry",
+    "!s.flags.parity", "s.flags.parity", "!s.flags.sign",  "s.flags.sign"
+};
+static constexpr uint8_t MEMORY_OPERAND = 6;
+static constexpr uint8_t CONDITION_MET_CYCLE_COUNT = 6;
+static constexpr uint8_t IO_ACCESS_CYCLE = 7;
+static constexpr size_t IMAGE_BYTES_PER_LINE = 16;
+
+enum class Ending : uint8_t
+{
+    none,
+    jump,
+    conditional_jump,
+    call,
+    conditional_call,
+    ret,
+    conditional_ret,
+    rst,
+    pchl,
+    halt,
+    io,
+    // Left to the interpreter
+    unsupported
+};
+
+static Ending get_ending(Instruction instruction)
+{
+    auto byte = static_cast<uint8_t>(instruction);
+
+    switch (instruction) {
+    case Instruction::JMP:
+        return Ending::jump;
+    case Instruction::CALL:
+        return Ending::call;
+    case Instruction::RET:
+        return Ending::ret;
+    case Instruction::PCHL:
+        return Ending::pchl;
+    case Instruction::HLT:
+        return Ending::halt;
+    case Instruction::IN:
+    case Instruction::OUT:
+        return Ending::io;
+    // The undocumented aliases of JMP, RET and CALL are left to the interpreter
+    case Instruction::NOP6:
+    case Instruction::NOP7:
+    case Instruction::NOP8:
+    case Instruction::NOP9:
+    case Instruction::NOP10:
+        return Ending::unsupported;
+    default:
+        break;
+    }
+
+    switch (byte & 0xc7) {
+    case 0xc0:
+        return Ending::conditional_ret;
+    case 0xc2:
+        return Ending::conditional_jump;
+    case 0xc4:
+        return Ending::conditional_call;
+    case 0xc7:
+        return Ending::rst;
+    default:
+        return Ending::none;
+    }
+}
+
+static uint8_t condition_index(Instruction instruction)
+{
+    return (static_cast<uint8_t>(instruction) >> 3) & 7;
+}
+
+// The disassembly, for comments
+static std::string source(const Opcode& opcode, uint16_t address)
+{
+    fmt::memory_buffer out;
+    format_dissassembly(out, opcode, address);
+    return std::string(out.data(), out.size() - 1);
+}
+
+static std::string register_operand(uint8_t index)
+{
+    return (index == MEMORY_OPERAND) ? "read_m(s, bus)" : std::string(REGISTERS[index]);
+}
+
+// C++ for an instruction that doesn't end a block
+static std::string statement(const Opcode& opcode)
+{
+    auto byte = static_cast<uint8_t>(opcode.instruction);
+    uint8_t u8operand = opcode.u8operand;
+    uint16_t u16operand = opcode.u16operand;
+    uint8_t destination = (byte >> 3) & 7;
+    uint8_t source = byte & 7;
+    std::string_view pair = PAIRS[(byte >> 4) & 3];
+
+    switch (opcode.instruction) {
+    case Instruction::STAX_B:
+        return "bus.mem_write(s.bc, s.a);";
+    case Instruction::STAX_D:
+        return "bus.mem_write(s.de, s.a);";
+    case Instruction::LDAX_B:
+        return "bus.mem_read(s.bc, s.a);";
+    case Instruction::LDAX_D:
+        return "bus.mem_read(s.de, s.a);";
+    case Instruction::SHLD:
+        return fmt::format("bus.mem_write({:#06x}, s.hl);", u16operand);
+    case Instruction::LHLD:
+        return fmt::format("bus.mem_read({:#06x}, s.hl);", u16operand);
+    case Instruction::STA:
+        return fmt::format("bus.mem_write({:#06x}, s.a);", u16operand);
+    case Instruction::LDA:
+        return fmt::format("bus.mem_read({:#06x}, s.a);", u16operand);
+    case Instruction::RLC:
+        return "rlc(s);";
+    case Instruction::RRC:
+        return "rrc(s);";
+    case Instruction::RAL:
+        return "ral(s);";
+    case Instruction::RAR:
+        return "rar(s);";
+    case Instruction::DAA:
+        return "daa(s);";
+    case Instruction::CMA:
+        return "s.a = ~s.a;";
+    case Instruction::STC:
+        return "s.flags.carry = 1;";
+    case Instruction::CMC:
+        return "cmc(s);";
+    case Instruction::EI:
+        return "s.interrupts_enabled = true;";
+    case Instruction::DI:
+        return "s.interrupts_enabled = false;";
+    case Instruction::XCHG:
+        return "std::swap(s.de, s.hl);";
+    case Instruction::XTHL:
+        return "xthl(s, bus);";
+    case Instruction::SPHL:
+        return "s.sp = s.hl;";
+    case Instruction::PUSH_PSW:
+        return "push_psw(s, bus);";
+    case Instruction::POP_PSW:
+        return "pop_psw(s, bus);";
+    default:
+        break;
+    }
+
+    // MOV
+    if (byte >= 0x40 && byte < 0x80) {
+        if (destination == source) {
+            return "";
+        }
+
+        if (destination == MEMORY_OPERAND) {
+            return fmt::format("bus.mem_write(s.hl, {});", REGISTERS[source]);
+        }
+
+        if (source == MEMORY_OPERAND) {
+            return fmt::format("bus.mem_read(s.hl, {});", REGISTERS[destination]);
+        }
+
+        return fmt::format("{} = {};", REGISTERS[destination], REGISTERS[source]);
+    }
+
+    // Register and immediate ALU operations
+    if (byte >= 0x80 && byte < 0xc0) {
+        return fmt::format("{}(s, {});", ALU_OPERATIONS[destination], register_operand(source));
+    }
+
+    if ((byte & 0xc7) == 0xc6) {
+        return fmt::format("{}(s, {:#04x});", ALU_OPERATIONS[destination], u8operand);
+    }
+
+    switch (byte & 0xc7) {
+    case 0x04:
+    case 0x05:
+    {
+        std::string_view operation = (byte & 1) ? "dcr" : "inr";
+        if (destination == MEMORY_OPERAND) {
+            // Read-modify-write so the store is visible to the bus
+            return fmt::format("{{ uint8_t value = read_m(s, bus); {}(s, value); "
+                               "bus.mem_write(s.hl, value); }}",
+                               operation);
+        }
+
+        return fmt::format("{}(s, {});", operation, REGISTERS[destination]);
+    }
+    case 0x06:
+        if (destination == MEMORY_OPERAND) {
+            return fmt::format("bus.mem_write(s.hl, static_cast<uint8_t>({:#04x}));", u8operand);
+        }
+
+        return fmt::format("{} = {:#04x};", REGISTERS[destination], u8operand);
+    default:
+        break;
+    }
+
+    switch (byte & 0xcf) {
+    case 0x01:
+        return fmt::format("{} = {:#06x};", pair, u16operand);
+    case 0x03:
+        return fmt::format("{}++;", pair);
+    case 0x09:
+        return fmt::format("dad(s, {});", pair);
+    case 0x0b:
+        return fmt::format("{}--;", pair);
+    case 0xc1:
+        return fmt::format("pop(s, bus, {});", pair);
+    case 0xc5:
+        return fmt::format("push(s, bus, {});", pair);
+    default:
+        break;
+    }
+
+    // NOPs
+    return "";
+}
+
+Recompiler::Recompiler(const buffer& image, uint16_t origin) :
+    _origin(origin),
+    _image_size(std::min<size_t>(image.size(), Disassembler::ADDRESS_SPACE - origin)),
+    _memory(Disassembler::ADDRESS_SPACE),
+    _disassembler(_memory)
+{
+    std::copy_n(image.begin(), _image_size, _memory.begin() + origin);
+    _disassembler.add_entry_point(origin);
+}
+
+void Recompiler::add_entry_point(uint16_t address)
+{
+    _disassembler.add_entry_point(address);
+}
+
+bool Recompiler::_in_image(uint16_t address, size_t size) const
+{
+    return address >= _origin && address + size <= _origin + _image_size;
+}
+
+std::vector<bool> Recompiler::_leaders() const
+{
+    std::vector<bool> leaders(Disassembler::ADDRESS_SPACE, false);
+    bool after_ending = true;
+    uint32_t page = _origin / Bus::PAGE_SIZE;
+
+    for (uint32_t address = _origin; address < _origin + _image_size; address++) {
+        if (!_disassembler.is_instruction(address)) {
+            after_ending |= (_disassembler.kind(address) == Disassembler::ByteKind::data);
+            continue;
+        }
+
+        Instruction instruction = _disassembler.opcode(address).instruction;
+        bool supported = get_ending(instruction) != Ending::unsupported &&
+                         _in_image(address, get_opcode_metadata(instruction).size);
+
+        // Blocks stay on one page, so breakpoints only need to keep the CPU out of their pages
+        bool new_page = (address / Bus::PAGE_SIZE) != page;
+        page = address / Bus::PAGE_SIZE;
+
+        leaders[address] =
+            supported && (after_ending || new_page || _disassembler.is_label(address));
+        after_ending = (get_ending(instruction) != Ending::none) || !supported;
+    }
+
+    return leaders;
+}
+
+size_t Recompiler::block_count() const
+{
+    return std::ranges::count(_leaders(), true);
+}
+
+bool Recompiler::_continues_block(uint16_t address, const std::vector<bool>& leaders) const
+{
+    return !leaders[address] && _disassembler.is_instruction(address) &&
+           _in_image(address, get_opcode_metadata(_disassembler.opcode(address).instruction).size);
+}
+
+void Recompiler::_translate_block(fmt::memory_buffer& out,
+                                  uint16_t start,
+                                  const std::vector<bool>& leaders) const
+{
+    auto it = std::back_inserter(out);
+    // Blocks without memory access or I/O leave the bus alone
+    fmt::format_to(it,
+                   "\nuint32_t block_{:04x}(State& s, [[maybe_unused]] i8080::Bus& bus)\n{{\n",
+                   start);
+
+    uint32_t instructions = 0;
+    uint64_t cycles = 0;
+    uint32_t address = start;
+
+    auto flush_cycles = [&]() {
+        if (cycles) {
+            fmt::format_to(it, "    s.cycle += {};\n", cycles);
+            cycles = 0;
+        }
+    };
+
+    while (true) {
+        Opcode opcode = _disassembler.opcode(address);
+        const OpcodeMetadata& metadata = get_opcode_metadata(opcode.instruction);
+        Ending ending = get_ending(opcode.instruction);
+        uint16_t next = address + metadata.size;
+
+        if (ending == Ending::unsupported) {
+            flush_cycles();
+            fmt::format_to(it, "    s.pc = {:#06x};\n    return {};\n}}\n", address, instructions);
+            break;
+        }
+
+        instructions++;
+        cycles += metadata.cycles;
+
+        if (ending == Ending::none) {
+            std::string code = statement(opcode);
+            fmt::format_to(it,
+                           "    {}{}// {}\n",
+                           code,
+                           code.empty() ? "" : " ",
+                           source(opcode, address));
+
+            address = next;
+            if (_continues_block(address, leaders)) {
+                continue;
+            }
+
+            flush_cycles();
+            fmt::format_to(it, "    s.pc = {:#06x};\n    return {};\n}}\n", next, instructions);
+            break;
+        }
+
+        uint16_t target = opcode.u16operand;
+        if (ending == Ending::rst) {
+            target = isr_offset(opcode.instruction);
+        }
+
+        std::string_view condition = CONDITIONS[condition_index(opcode.instruction)];
+
+        fmt::format_to(it, "    // {}\n", source(opcode, address));
+        switch (ending) {
+        case Ending::jump:
+            flush_cycles();
+            fmt::format_to(it, "    s.pc = {:#06x};\n", target);
+            break;
+        case Ending::conditional_jump:
+            flush_cycles();
+            fmt::format_to(it, "    s.pc = {} ? {:#06x} : {:#06x};\n", condition, target, next);
+            break;
+        case Ending::call:
+            flush_cycles();
+            fmt::format_to(it, "    push(s, bus, {:#06x});\n    s.pc = {:#06x};\n", next, target);
+            break;
+        case Ending::conditional_call:
+            flush_cycles();
+            fmt::format_to(it,
+                           "    if ({}) {{\n"
+                           "        push(s, bus, {:#06x});\n"
+                           "        s.pc = {:#06x};\n"
+                           "        s.cycle += {};\n"
+                           "    }} else {{\n"
+                           "        s.pc = {:#06x};\n"
+                           "    }}\n",
+                           condition,
+                           next,
+                           target,
+                           CONDITION_MET_CYCLE_COUNT,
+                           next);
+            break;
+        case Ending::ret:
+            flush_cycles();
+            fmt::format_to(it, "    pop(s, bus, s.pc);\n");
+            break;
+        case Ending::conditional_ret:
+            flush_cycles();
+            fmt::format_to(it,
+                           "    if ({}) {{\n"
+                           "        pop(s, bus, s.pc);\n"
+                           "        s.cycle += {};\n"
+                           "    }} else {{\n"
+                           "        s.pc = {:#06x};\n"
+                           "    }}\n",
+                           condition,
+                           CONDITION_MET_CYCLE_COUNT,
+                           next);
+            break;
+        case Ending::rst:
+            flush_cycles();
+            fmt::format_to(it, "    push(s, bus, {:#06x});\n    s.pc = {:#06x};\n", next, target);
+            break;
+        case Ending::pchl:
+            flush_cycles();
+            fmt::format_to(it, "    s.pc = s.hl;\n");
+            break;
+        case Ending::halt:
+            flush_cycles();
+            fmt::format_to(it, "    s.pc = {:#06x};\n    s.halt = true;\n", next);
+            break;
+        case Ending::io:
+        {
+            uint8_t port = opcode.u8operand;
+            std::string_view call = (opcode.instruction == Instruction::OUT) ? "write" : "read";
+
+            // Devices see the PC of the instruction and the cycle its I/O machine cycle starts
+            cycles -= metadata.cycles - IO_ACCESS_CYCLE;
+            flush_cycles();
+            fmt::format_to(it,
+                           "    s.pc = {:#06x};\n"
+                           "    bus.{}({:#04x}, s.a);\n"
+                           "    s.cycle += {};\n"
+                           "    s.pc = {:#06x};\n",
+                           address,
+                           call,
+                           port,
+                           metadata.cycles - IO_ACCESS_CYCLE,
+                           next);
+        } break;
+        default:
+            break;
+        }
+
+        fmt::format_to(it, "    return {};\n}}\n", instructions);
+        break;
+    }
+}
+
+std::string Recompiler::translate(std::string_view name) const
+{
+    fmt::memory_buffer out;
+    auto it = std::back_inserter(out);
+    std::vector<bool> leaders = _leaders();
+
+    fmt::format_to(it,
+                   "// Generated by the i8080 recompiler, do not edit\n\n"
+                   "#include <i8080/native.h>\n\n"
+                   "#include <utility>\n\n"
+                   "using namespace i8080::native;\n\n"
+                   "namespace\n{{\n");
+
+    fmt::format_to(it, "const uint8_t IMAGE[] = {{");
+    for (size_t i = 0; i < _image_size; i++) {
+        fmt::format_to(it,
+                       "{}{:#04x},",
+                       (i % IMAGE_BYTES_PER_LINE) ? " " : "\n    ",
+                       _memory[_origin + i]);
+    }
+
+    fmt::format_to(it, "\n}};\n");
+
+    std::vector<uint16_t> blocks;
+    for (uint32_t address = _origin; address < _origin + _image_size; address++) {
+        if (leaders[address]) {
+            blocks.push_back(address);
+            _translate_block(out, address, leaders);
+        }
+    }
+
+    fmt::format_to(it, "\nuint32_t run_block(State& s, i8080::Bus& bus)\n{{\n");
+    fmt::format_to(it, "    switch (s.pc) {{\n");
+    for (uint16_t block : blocks) {
+        fmt::format_to(it, "    case {0:#06x}:\n        return block_{0:04x}(s, bus);\n", block);
+    }
+
+    fmt::format_to(it, "    default:\n        return 0;\n    }}\n}}\n}} // namespace\n\n");
+
+    fmt::format_to(it,
+                   "extern const i8080::NativeProgram {0};\n"
+                   "const i8080::NativeProgram {0} {{ .origin = {1:#06x}, .image = IMAGE, "
+                   ".code = run_block }};\n",
+                   name,
+                   _origin);
+
+    return fmt::to_string(out);
+}
+} // namespace i8080
@@ -0,0 +1,148 @@
+#include "sampler.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace i8080
+{
+SamplingProfiler::SamplingProfiler(Cpu& cpu, Config config) :
+    _cpu(cpu),
+    _config(config),
+    _random(config.seed ? config.seed : 1),
+    _samples(0),
+    _histogram(Bus::ADDRESS_SPACE_SIZE, 0)
+{}
+
+Cpu::StopReason SamplingProfiler::run(uint64_t cycles)
+{
+    uint64_t end = _cpu.get().state().cycle + cycles;
+
+    while (_cpu.get().state().cycle < end) {
+        uint64_t remaining = end - _cpu.get().state().cycle;
+        Cpu::StopReason reason = _cpu.get().run(std::min(_next_interval(), remaining));
+
+        sample();
+        if (reason != Cpu::StopReason::cycles) {
+            return reason;
+        }
+    }
+
+    return Cpu::StopReason::cycles;
+}
+
+void SamplingProfiler::sample()
+{
+    uint16_t pc = _cpu.get().state().pc;
+    _samples++;
+    _histogram[pc]++;
+
+    if (_walker) {
+        _frames.clear();
+        _walker(_frames);
+        _frames.push_back(pc);
+        _stacks[_frames]++;
+    }
+}
+
+void SamplingProfiler::reset()
+{
+    _samples = 0;
+    std::ranges::fill(_histogram, 0);
+    _stacks.clear();
+}
+
+uint64_t SamplingProfiler::_next_interval()
+{
+    if (!_config.jitter || _config.interval < 2) {
+        return std::max<uint64_t>(_config.interval, 1);
+    }
+
+    // xorshift64, uniform over [interval / 2, interval * 3 / 2)
+    _random ^= _random << 13;
+    _random ^= _random >> 7;
+    _random ^= _random << 17;
+    return _config.interval / 2 + _random % _config.interval;
+}
+
+std::string SamplingProfiler::report(const SymbolTable& symbols, size_t top_addresses) const
+{
+    std::vector<uint16_t> addresses;
+    std::map<std::string, uint64_t> by_symbol;
+
+    for (size_t address = 0; address < _histogram.size(); address++) {
+        if (_histogram[address]) {
+            addresses.push_back(address);
+            by_symbol[symbols.name(address)] += _histogram[address];
+        }
+    }
+
+    size_t shown = std::min(top_addresses, addresses.size());
+    std::ranges::partial_sort(addresses, addresses.begin() + shown, [this](uint16_t a, uint16_t b) {
+        return _histogram[a] > _histogram[b];
+    });
+    addresses.resize(shown);
+
+    std::vector<std::pair<std::string, uint64_t>> functions(by_symbol.begin(), by_symbol.end());
+    std::ranges::stable_sort(functions, [](const auto& a, const auto& b) {
+        return a.second > b.second;
+    });
+
+    auto percent = [this](uint64_t count) { return _samples ? 100.0 * count / _samples : 0.0; };
+
+    fmt::memory_buffer out;
+    auto it = std::back_inserter(out);
+
+    fmt::format_to(it, "{} samples\n\n{:<24} {:>12} {:>7}\n", _samples, "symbol", "samples", "%");
+    for (const auto& [name, count] : functions) {
+        fmt::format_to(it, "{:<24} {:>12} {:>6.2f}%\n", name, count, percent(count));
+    }
+
+    fmt::format_to(it, "\n{:<6} {:<24} {:>12} {:>7}\n", "pc", "location", "samples", "%");
+    for (uint16_t address : addresses) {
+        fmt::format_to(it,
+                       "{:#06x} {:<24} {:>12} {:>6.2f}%\n",
+                       address,
+                       symbols.describe(address),
+                       _histogram[address],
+                       percent(_histogram[address]));
+    }
+
+    return fmt::to_string(out);
+}
+
+std::string SamplingProfiler::folded(const SymbolTable& symbols) const
+{
+    // Distinct addresses often fold into the same symbol stack
+    std::map<std::string, uint64_t> stacks;
+
+    if (!_stacks.empty()) {
+        for (const auto& [frames, count] : _stacks) {
+            std::string stack;
+            for (uint16_t frame : frames) {
+                if (!stack.empty()) {
+                    stack += ';';
+                }
+
+                stack += symbols.name(frame);
+            }
+
+            stacks[stack] += count;
+        }
+    } else {
+        for (size_t address = 0; address < _histogram.size(); address++) {
+            if (_histogram[address]) {
+                stacks[symbols.name(address)] += _histogram[address];
+            }
+        }
+    }
+
+    fmt::memory_buffer out;
+    for (const auto& [stack, count] : stacks) {
+        fmt::format_to(std::back_inserter(out), "{} {}\n", stack, count);
+    }
+
+    return fmt::to_string(out);
+}
+} // namespace i8080
@@ -0,0 +1,239 @@
+#include "scheduler.h"
+
+#include <algorithm>
+#include <functional>
+#include <new>
+
+namespace i8080
+{
+// Routes guest port accesses to the scheduler, and answers IN with the latched input
+class Scheduler::Port final : public Device
+{
+public:
+    Port(Scheduler& scheduler, uint8_t id) :
+        _scheduler(scheduler),
+        _id(id),
+        _input(0)
+    {}
+
+    void write(uint8_t byte) override { _scheduler.get()._notify(Event::port_write, _id, byte); }
+
+    void read(uint8_t& byte) override
+    {
+        byte = _input;
+        _scheduler.get()._notify(Event::port_read, _id, byte);
+    }
+
+    void set_input(uint8_t value) { _input = value; }
+
+private:
+    std::reference_wrapper<Scheduler> _scheduler;
+    uint8_t _id;
+    uint8_t _input;
+};
+
+void* FramePool::allocate(size_t size)
+{
+    size_t size_class = (size + GRANULARITY - 1) / GRANULARITY;
+    if (size_class >= SIZE_CLASSES) {
+        return ::operator new(size);
+    }
+
+    Pool& pool = _pool();
+    if (FreeFrame* frame = pool.free[size_class]) {
+        pool.free[size_class] = frame->next;
+        return frame;
+    }
+
+    size_t frame_size = size_class * GRANULARITY;
+    if (pool.chunk_offset + frame_size > CHUNK_SIZE) {
+        // The rest of the old chunk is abandoned, frames of this size recycle through the list
+        pool.chunks.push_back(std::make_unique_for_overwrite<std::byte[]>(CHUNK_SIZE));
+        pool.chunk_offset = 0;
+    }
+
+    void* frame = pool.chunks.back().get() + pool.chunk_offset;
+    pool.chunk_offset += frame_size;
+    return frame;
+}
+
+void FramePool::deallocate(void* frame, size_t size)
+{
+    size_t size_class = (size + GRANULARITY - 1) / GRANULARITY;
+    if (size_class >= SIZE_CLASSES) {
+        ::operator delete(frame);
+        return;
+    }
+
+    Pool& pool = _pool();
+    pool.free[size_class] = new (frame) FreeFrame { .next = pool.free[size_class] };
+}
+
+FramePool::Pool& FramePool::_pool()
+{
+    thread_local Pool pool;
+    return pool;
+}
+
+Scheduler::Scheduler(Cpu& cpu, Bus& bus) :
+    _cpu(cpu),
+    _bus(bus),
+    _sequence(0),
+    _event_pending(false)
+{
+    _cpu.get().set_interrupt_callback([this](Instruction vector) {
+        _notify(Event::irq_ack, 0, static_cast<uint8_t>(vector));
+    });
+}
+
+Scheduler::~Scheduler()
+{
+    _cpu.get().set_interrupt_callback({});
+
+    for (size_t port = 0; port < _ports.size(); port++) {
+        if (_ports[port]) {
+            _bus.get().register_device(port, nullptr);
+        }
+    }
+
+    for (DeviceTask::handle task : _tasks) {
+        task.destroy();
+    }
+}
+
+void Scheduler::spawn(DeviceTask task)
+{
+    DeviceTask::handle handle = task.release();
+    handle.promise().scheduler = this;
+
+    _tasks.push_back(handle);
+    _ready.push_back(handle);
+}
+
+Cpu::StopReason Scheduler::run(uint64_t cycles)
+{
+    Cpu& cpu = _cpu.get();
+    uint64_t end = cpu.state().cycle + cycles;
+
+    _resume_ready();
+
+    while (cpu.state().cycle < end) {
+        uint64_t deadline = _timers.empty() ? end : std::min(end, _timers.front().wake);
+
+        Cpu::StopReason reason = Cpu::StopReason::cycles;
+        if (deadline > cpu.state().cycle) {
+            reason = cpu.run(deadline - cpu.state().cycle);
+        }
+
+        // A stop the scheduler did not ask for belongs to the caller, as do breakpoints
+        bool ours = std::exchange(_event_pending, false);
+        if ((reason == Cpu::StopReason::stop && !ours) || reason == Cpu::StopReason::breakpoint) {
+            return reason;
+        }
+
+        _wake_timers();
+        _resume_ready();
+
+        if (cpu.halt()) {
+            // Only a device can wake the CPU, so the time until the next one is due passes idle
+            if (_timers.empty()) {
+                return Cpu::StopReason::halt;
+            }
+
+            Cpu::State state = cpu.state();
+            state.cycle = std::min(end, _timers.front().wake);
+            cpu.set_state(state);
+        }
+    }
+
+    return Cpu::StopReason::cycles;
+}
+
+void Scheduler::set_input(uint8_t port, uint8_t value)
+{
+    _listen(port);
+    _ports[port]->set_input(value);
+}
+
+void Scheduler::sleep(DeviceTask::handle handle, uint64_t cycles)
+{
+    _timers.push_back({ .wake = now() + cycles, .sequence = _sequence++, .handle = handle });
+    std::ranges::push_heap(_timers, std::greater {});
+}
+
+void Scheduler::wait(DeviceTask::handle handle, Event event, uint8_t port)
+{
+    if (event != Event::irq_ack) {
+        _listen(port);
+    }
+
+    _waiters.push_back({ .handle = handle, .event = event, .port = port });
+}
+
+void Scheduler::_listen(uint8_t port)
+{
+    if (!_ports[port]) {
+        _ports[port] = std::make_shared<Port>(*this, port);
+        _bus.get().register_device(port, _ports[port]);
+    }
+}
+
+void Scheduler::_notify(Event event, uint8_t port, uint8_t value)
+{
+    auto woken = std::ranges::partition(_waiters, [event, port](const Waiter& waiter) {
+        return waiter.event != event || waiter.port != port;
+    });
+
+    if (woken.empty()) {
+        return;
+    }
+
+    for (const Waiter& waiter : woken) {
+        waiter.handle.promise().value = value;
+        waiter.handle.promise().vector = static_cast<Instruction>(value);
+        _ready.push_back(waiter.handle);
+    }
+
+    _waiters.erase(woken.begin(), woken.end());
+
+    // End the slice so the devices run before the next instruction
+    _event_pending = true;
+    _cpu.get().stop();
+}
+
+void Scheduler::_wake_timers()
+{
+    while (!_timers.empty() && _timers.front().wake <= now()) {
+        std::ranges::pop_heap(_timers, std::greater {});
+        _ready.push_back(_timers.back().handle);
+        _timers.pop_back();
+    }
+}
+
+void Scheduler::_resume_ready()
+{
+    // Resumed devices may wake others, keep going until everyone is blocked
+    while (!_ready.empty()) {
+        std::swap(_ready, _resuming);
+
+        for (DeviceTask::handle handle : _resuming) {
+            handle.resume();
+
+            if (!handle.done()) {
+                continue;
+            }
+
+            std::erase(_tasks, handle);
+            std::exception_ptr exception = handle.promise().exception;
+            handle.destroy();
+
+            if (exception) {
+                _resuming.clear();
+                std::rethrow_exception(exception);
+            }
+        }
+
+        _resuming.clear();
+    }
+}
+} // namespace i8080
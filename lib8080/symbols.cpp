@@ -0,0 +1,105 @@
+#include "symbols.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <stdexcept>
+
+namespace i8080
+{
+static constexpr size_t LISTING_ADDRESS_COLUMN = 1;
+static constexpr size_t LISTING_ADDRESS_WIDTH = 4;
+static constexpr size_t LISTING_CODE_COLUMN = 6;
+static constexpr size_t LISTING_SOURCE_COLUMN = 16;
+
+static bool is_label_character(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$' || c == '?' ||
+           c == '@' || c == '.';
+}
+
+SymbolTable SymbolTable::from_listing(std::istream& listing)
+{
+    SymbolTable table;
+    std::string line;
+
+    while (std::getline(listing, line)) {
+        if (line.size() <= LISTING_SOURCE_COLUMN || line[0] != ' ' ||
+            line[LISTING_CODE_COLUMN] == '=') {
+            continue;
+        }
+
+        uint16_t address;
+        const char* first = line.data() + LISTING_ADDRESS_COLUMN;
+        const char* last = first + LISTING_ADDRESS_WIDTH;
+        auto [end, error] = std::from_chars(first, last, address, 16);
+        if (error != std::errc() || end != last) {
+            continue;
+        }
+
+        // Labels start right at the source column, instructions are indented
+        std::string_view source = std::string_view(line).substr(LISTING_SOURCE_COLUMN);
+        if (!std::isalpha(static_cast<unsigned char>(source.front()))) {
+            continue;
+        }
+
+        size_t length = 0;
+        while (length < source.size() && is_label_character(source[length])) {
+            length++;
+        }
+
+        table.add(address, std::string(source.substr(0, length)));
+    }
+
+    return table;
+}
+
+SymbolTable SymbolTable::from_listing(const std::filesystem::path& path)
+{
+    std::ifstream listing(path);
+    if (!listing.is_open()) {
+        throw std::runtime_error(fmt::format("Could not open file: {}", path.string()));
+    }
+
+    return from_listing(listing);
+}
+
+void SymbolTable::add(uint16_t address, std::string name)
+{
+    auto position = std::ranges::upper_bound(_symbols, address, {}, &Symbol::address);
+    _symbols.insert(position, { address, std::move(name) });
+}
+
+const SymbolTable::Symbol* SymbolTable::find(uint16_t address) const
+{
+    auto position = std::ranges::upper_bound(_symbols, address, {}, &Symbol::address);
+    if (position == _symbols.begin()) {
+        return nullptr;
+    }
+
+    return &*std::prev(position);
+}
+
+std::string SymbolTable::describe(uint16_t address) const
+{
+    const Symbol* symbol = find(address);
+    if (!symbol) {
+        return fmt::format("{:#06x}", address);
+    }
+
+    if (symbol->address == address) {
+        return symbol->name;
+    }
+
+    return fmt::format("{}+{:#x}", symbol->name, address - symbol->address);
+}
+
+std::string SymbolTable::name(uint16_t address) const
+{
+    const Symbol* symbol = find(address);
+    return symbol ? symbol->name : fmt::format("{:#06x}", address);
+}
+} // namespace i8080
@@ -0,0 +1,76 @@
+#include "system.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <stdexcept>
+#include <thread>
+
+namespace i8080
+{
+System::System(buffer& memory, const std::vector<uint16_t>& entry_points, uint64_t quantum) :
+    _quantum(DEFAULT_QUANTUM)
+{
+    set_quantum(quantum);
+
+    for (uint16_t entry_point : entry_points) {
+        _nodes.push_back(std::make_unique<Node>(memory, entry_point));
+    }
+}
+
+void System::set_quantum(uint64_t quantum)
+{
+    if (quantum == 0) {
+        throw std::runtime_error(fmt::format("Invalid system quantum: {}", quantum));
+    }
+
+    _quantum = quantum;
+}
+
+void System::share(uint8_t first_page, size_t page_count)
+{
+    for (size_t page = first_page; page < first_page + page_count && page < Bus::PAGE_COUNT;
+         page++) {
+        for (auto& node : _nodes) {
+            node->bus.share_page(page);
+        }
+    }
+}
+
+void System::register_shared_device(uint8_t port, Device::sptr device)
+{
+    auto shared = std::make_shared<SynchronizedDevice>(std::move(device));
+    for (auto& node : _nodes) {
+        node->bus.register_device(port, shared);
+    }
+}
+
+void System::run(uint64_t cycles)
+{
+    uint64_t quantum = _quantum;
+    uint64_t quanta = (cycles + quantum - 1) / quantum;
+    bool all_halted = false;
+
+    // Runs on one thread once everyone has arrived, before any of them is released
+    auto on_quantum_end = [this, &all_halted]() noexcept {
+        all_halted = std::ranges::all_of(_nodes, [](const auto& node) { return node->cpu.halt(); });
+    };
+
+    std::barrier barrier(static_cast<std::ptrdiff_t>(_nodes.size()), on_quantum_end);
+
+    auto worker = [&](Cpu& cpu) {
+        for (uint64_t i = 0; i < quanta && !all_halted; i++) {
+            cpu.run(quantum);
+            barrier.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::jthread> threads;
+    threads.reserve(_nodes.size());
+    for (auto& node : _nodes) {
+        threads.emplace_back(worker, std::ref(node->cpu));
+    }
+}
+} // namespace i8080
@@ -0,0 +1,321 @@
+#include "timetravel.h"
+
+#include <algorithm>
+
+namespace i8080
+{
+TimeMachine::TimeMachine(Cpu& cpu, Bus& bus, buffer& memory, Config config) :
+    _cpu(cpu),
+    _bus(bus),
+    _memory(memory),
+    _config(config),
+    _base(memory),
+    _dirty(Bus::PAGE_COUNT, false),
+    _delta_bytes(0)
+{
+    _checkpoints.push_back({ .state = cpu.state(), .pages = {} });
+    _bus.get().set_write_journal(&_journal);
+}
+
+TimeMachine::~TimeMachine()
+{
+    _bus.get().set_write_journal(nullptr);
+}
+
+void TimeMachine::tick()
+{
+    _step();
+
+    if (_cpu.get().state().cycle >=
+        _checkpoints.back().state.cycle + _config.checkpoint_interval) {
+        _checkpoint();
+    }
+}
+
+void TimeMachine::run(uint64_t cycles)
+{
+    uint64_t end = _cpu.get().state().cycle + cycles;
+    while (_cpu.get().state().cycle < end && !_cpu.get().halt()) {
+        tick();
+    }
+}
+
+void TimeMachine::interrupt(uint8_t isr_number)
+{
+    _interrupts.push_back({ .cycle = _cpu.get().state().cycle, .isr_number = isr_number });
+    _cpu.get().interrupt(isr_number);
+
+    // Taking the interrupt out of HLT pushes the return address right away
+    _collect_writes();
+}
+
+bool TimeMachine::seek(uint64_t cycle)
+{
+    if (cycle < oldest_cycle() || cycle >= _cpu.get().state().cycle) {
+        return false;
+    }
+
+    // The first pass finds the boundary, the second stops right on it
+    size_t index = _checkpoint_before(cycle + 1);
+    uint64_t boundary = _checkpoints[index].state.cycle;
+    _replay(index, cycle + 1, [&boundary](const Cpu::State& state) { boundary = state.cycle; });
+    _replay(index, boundary);
+
+    _discard_after(boundary);
+    return true;
+}
+
+bool TimeMachine::reverse_step()
+{
+    uint64_t cycle = _cpu.get().state().cycle;
+    return (cycle > 0) && seek(cycle - 1);
+}
+
+bool TimeMachine::reverse_continue(const Predicate& predicate)
+{
+    uint64_t current = _cpu.get().state().cycle;
+    if (current <= oldest_cycle()) {
+        return false;
+    }
+
+    for (size_t index = _checkpoint_before(current) + 1; index-- > 0;) {
+        uint64_t end = (index + 1 < _checkpoints.size())
+                           ? std::min(_checkpoints[index + 1].state.cycle, current)
+                           : current;
+
+        std::optional<uint64_t> found;
+        _replay(index, end, [&](const Cpu::State& state) {
+            if (predicate(state)) {
+                found = state.cycle;
+            }
+        });
+
+        if (found) {
+            _replay(index, *found);
+            _discard_after(*found);
+            return true;
+        }
+    }
+
+    _return_to(current);
+    return false;
+}
+
+bool TimeMachine::reverse_continue(uint16_t breakpoint)
+{
+    return reverse_continue([breakpoint](const Cpu::State& state) {
+        return state.pc == breakpoint;
+    });
+}
+
+std::optional<TimeMachine::Write> TimeMachine::last_write(uint16_t address)
+{
+    uint64_t current = _cpu.get().state().cycle;
+    size_t page = address / Bus::PAGE_SIZE;
+    std::optional<Write> write;
+
+    for (size_t index = _checkpoints.size(); index-- > 0 && !write;) {
+        bool last = (index + 1 == _checkpoints.size());
+
+        // Only replay intervals that touched the page at all
+        if (last) {
+            if (!_dirty[page]) {
+                continue;
+            }
+        } else {
+            const auto& pages = _checkpoints[index + 1].pages;
+            if (std::ranges::none_of(pages, [page](const Page& p) { return p.index == page; })) {
+                continue;
+            }
+        }
+
+        Cpu::State boundary;
+        _replay(
+            index,
+            last ? current : _checkpoints[index + 1].state.cycle,
+            [&boundary](const Cpu::State& state) { boundary = state; },
+            [&](const MemoryWrite& memory_write) {
+                if (memory_write.address == address) {
+                    write = { .cycle = boundary.cycle,
+                              .pc = boundary.pc,
+                              .value = memory_write.value };
+                }
+            });
+    }
+
+    _return_to(current);
+    return write;
+}
+
+size_t TimeMachine::memory_usage() const
+{
+    return _base.size() + _delta_bytes + (_checkpoints.size() * sizeof(Checkpoint)) +
+           (_interrupts.size() * sizeof(Interrupt));
+}
+
+void TimeMachine::_step(const WriteVisitor& write_visitor)
+{
+    _cpu.get().tick();
+    _collect_writes(write_visitor);
+}
+
+void TimeMachine::_collect_writes(const WriteVisitor& write_visitor)
+{
+    for (const MemoryWrite& write : _journal) {
+        _dirty[write.address / Bus::PAGE_SIZE] = true;
+
+        if (write_visitor) {
+            write_visitor(write);
+        }
+    }
+
+    _journal.clear();
+}
+
+void TimeMachine::_checkpoint()
+{
+    Checkpoint checkpoint { .state = _cpu.get().state(), .pages = {} };
+    const buffer& memory = _memory.get();
+
+    for (size_t index = 0; index < Bus::PAGE_COUNT; index++) {
+        if (!_dirty[index]) {
+            continue;
+        }
+
+        Page& page = checkpoint.pages.emplace_back(Page { .index = static_cast<uint8_t>(index),
+                                                          .data = {} });
+        std::copy_n(memory.begin() + (index * Bus::PAGE_SIZE),
+                    _page_length(index),
+                    page.data.begin());
+        _dirty[index] = false;
+    }
+
+    _delta_bytes += checkpoint.pages.size() * sizeof(Page);
+    _checkpoints.push_back(std::move(checkpoint));
+
+    _evict();
+}
+
+void TimeMachine::_evict()
+{
+    while (_checkpoints.size() > 1 && memory_usage() > _config.memory_budget) {
+        _checkpoints.pop_front();
+
+        // The new oldest checkpoint becomes the base image
+        Checkpoint& oldest = _checkpoints.front();
+        for (const Page& page : oldest.pages) {
+            std::copy_n(page.data.begin(),
+                        _page_length(page.index),
+                        _base.begin() + (page.index * Bus::PAGE_SIZE));
+        }
+
+        _delta_bytes -= oldest.pages.size() * sizeof(Page);
+        oldest.pages.clear();
+        oldest.pages.shrink_to_fit();
+
+        std::erase_if(_interrupts, [&oldest](const Interrupt& interrupt) {
+            return interrupt.cycle < oldest.state.cycle;
+        });
+    }
+}
+
+void TimeMachine::_restore(size_t index)
+{
+    buffer& memory = _memory.get();
+    std::ranges::copy(_base, memory.begin());
+
+    for (size_t i = 1; i <= index; i++) {
+        for (const Page& page : _checkpoints[i].pages) {
+            std::copy_n(page.data.begin(),
+                        _page_length(page.index),
+                        memory.begin() + (page.index * Bus::PAGE_SIZE));
+        }
+    }
+
+    _bus.get().sync_mirror();
+    _cpu.get().set_state(_checkpoints[index].state);
+    std::fill(_dirty.begin(), _dirty.end(), false);
+}
+
+void TimeMachine::_return_to(uint64_t cycle)
+{
+    _replay(_checkpoint_before(cycle + 1), cycle);
+
+    // Interrupts raised at the cycle itself were already pending there
+    for (const Interrupt& interrupt : _interrupts) {
+        if (interrupt.cycle == cycle) {
+            _cpu.get().interrupt(interrupt.isr_number);
+        }
+    }
+}
+
+void TimeMachine::_discard_after(uint64_t cycle)
+{
+    while (_checkpoints.size() > 1 && _checkpoints.back().state.cycle > cycle) {
+        _delta_bytes -= _checkpoints.back().pages.size() * sizeof(Page);
+        _checkpoints.pop_back();
+    }
+
+    std::erase_if(_interrupts,
+                  [cycle](const Interrupt& interrupt) { return interrupt.cycle >= cycle; });
+}
+
+size_t TimeMachine::_page_length(size_t index) const
+{
+    return std::min<size_t>(Bus::PAGE_SIZE, _memory.get().size() - (index * Bus::PAGE_SIZE));
+}
+
+size_t TimeMachine::_checkpoint_before(uint64_t cycle) const
+{
+    auto it = std::ranges::partition_point(_checkpoints, [cycle](const Checkpoint& checkpoint) {
+        return checkpoint.state.cycle < cycle;
+    });
+
+    return (it == _checkpoints.begin()) ? 0 : (it - _checkpoints.begin() - 1);
+}
+
+void TimeMachine::_replay(size_t index,
+                          uint64_t end_cycle,
+                          const Visitor& visitor,
+                          const WriteVisitor& write_visitor)
+{
+    _restore(index);
+
+    Cpu& cpu = _cpu.get();
+    auto interrupt = std::ranges::lower_bound(_interrupts,
+                                              cpu.state().cycle,
+                                              {},
+                                              &Interrupt::cycle);
+
+    while (cpu.state().cycle < end_cycle) {
+        // A halted CPU still takes the interrupts raised at its halt cycle
+        bool halted = cpu.halt();
+        bool pending = interrupt != _interrupts.end() && interrupt->cycle <= cpu.state().cycle;
+        if (halted && !pending) {
+            break;
+        }
+
+        if (visitor) {
+            visitor(cpu.state());
+        }
+
+        for (; interrupt != _interrupts.end() && interrupt->cycle <= cpu.state().cycle;
+             interrupt++) {
+            cpu.interrupt(interrupt->isr_number);
+        }
+
+        _collect_writes(write_visitor);
+
+        // Taking one out of HLT is a boundary of its own, with interrupts disabled it stays halted
+        if (halted) {
+            if (cpu.halt()) {
+                break;
+            }
+
+            continue;
+        }
+
+        _step(write_visitor);
+    }
+}
+} // namespace i8080
@@ -0,0 +1,151 @@
+#include "trace.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace i8080
+{
+static_assert(sizeof(TraceHeader) % alignof(TraceRecord) == 0);
+
+static size_t round_capacity(size_t capacity)
+{
+    return std::bit_ceil(std::max<size_t>(capacity, 1));
+}
+
+static TraceHeader make_header(uint64_t capacity, uint64_t written)
+{
+    return { .magic = TraceHeader::MAGIC,
+             .version = TraceHeader::VERSION,
+             .record_size = sizeof(TraceRecord),
+             .capacity = capacity,
+             .written = written };
+}
+
+Tracer::Tracer(Config config) :
+    _config(config),
+    _mask(round_capacity(config.capacity) - 1),
+    _storage((sizeof(TraceHeader) + (_mask + 1) * sizeof(TraceRecord)) / sizeof(uint64_t)),
+    _mapping(nullptr),
+    _mapping_size(0)
+{
+    _header = reinterpret_cast<TraceHeader*>(_storage.data());
+    _records = reinterpret_cast<TraceRecord*>(_header + 1);
+    *_header = make_header(_mask + 1, 0);
+}
+
+Tracer::Tracer(const std::filesystem::path& path, Config config) :
+    _config(config),
+    _mask(round_capacity(config.capacity) - 1),
+    _mapping(nullptr),
+    _mapping_size(sizeof(TraceHeader) + (_mask + 1) * sizeof(TraceRecord))
+{
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error(fmt::format("Could not open file: {}", path.string()));
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(_mapping_size)) == 0) {
+        _mapping = mmap(nullptr, _mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    close(fd);
+    if (!_mapping || _mapping == MAP_FAILED) {
+        throw std::runtime_error(fmt::format("Could not map file: {}", path.string()));
+    }
+
+    _header = static_cast<TraceHeader*>(_mapping);
+    _records = reinterpret_cast<TraceRecord*>(_header + 1);
+    *_header = make_header(_mask + 1, 0);
+}
+
+Tracer::~Tracer()
+{
+    if (_mapping) {
+        munmap(_mapping, _mapping_size);
+    }
+}
+
+std::vector<TraceRecord> Tracer::records() const
+{
+    uint64_t written = _header->written;
+    uint64_t count = std::min<uint64_t>(written, _mask + 1);
+
+    std::vector<TraceRecord> records;
+    records.reserve(count);
+    for (uint64_t i = written - count; i < written; i++) {
+        records.push_back(_records[i & _mask]);
+    }
+
+    return records;
+}
+
+void Tracer::save(const std::filesystem::path& path) const
+{
+    std::vector<TraceRecord> records = this->records();
+    TraceHeader header = make_header(records.size(), records.size());
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error(fmt::format("Could not open file: {}", path.string()));
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(records.data()),
+               static_cast<std::streamsize>(records.size() * sizeof(TraceRecord)));
+}
+
+std::vector<TraceRecord> read_trace(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error(fmt::format("Could not open file: {}", path.string()));
+    }
+
+    TraceHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != TraceHeader::MAGIC || header.version != TraceHeader::VERSION ||
+        header.record_size != sizeof(TraceRecord) || header.capacity == 0) {
+        throw std::runtime_error(fmt::format("Not a trace file: {}", path.string()));
+    }
+
+    std::vector<TraceRecord> ring(std::min<uint64_t>(header.written, header.capacity));
+    if (!file.read(reinterpret_cast<char*>(ring.data()),
+                   static_cast<std::streamsize>(ring.size() * sizeof(TraceRecord)))) {
+        throw std::runtime_error(fmt::format("Truncated trace file: {}", path.string()));
+    }
+
+    // Rotate so the oldest record comes first
+    if (header.written > header.capacity) {
+        std::ranges::rotate(ring, ring.begin() + (header.written % header.capacity));
+    }
+
+    return ring;
+}
+
+void decode_trace(fmt::memory_buffer& out, const TraceRecord& record)
+{
+    Opcode opcode;
+    std::memcpy(&opcode, record.bytes.data(), sizeof(Opcode));
+    format_dissassembly(out, opcode, record.pc);
+
+    if (record.flags & TraceRecord::has_registers) {
+        // Replace the newline so the registers share the instruction's line
+        out.resize(out.size() - 1);
+        fmt::format_to(std::back_inserter(out),
+                       "    ; cycle={} af={:#06x} bc={:#06x} de={:#06x} hl={:#06x} sp={:#06x}\n",
+                       record.cycle,
+                       record.af,
+                       record.bc,
+                       record.de,
+                       record.hl,
+                       record.sp);
+    }
+}
+} // namespace i8080
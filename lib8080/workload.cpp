@@ -0,0 +1,443 @@
+#include "workload.h"
+#include "asm.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace i8080
+{
+// Register codes as they appear in opcodes, M is memory at HL
+static constexpr uint8_t REGISTER_B = 0;
+static constexpr uint8_t REGISTER_C = 1;
+static constexpr uint8_t REGISTER_D = 2;
+static constexpr uint8_t REGISTER_E = 3;
+static constexpr uint8_t REGISTER_H = 4;
+static constexpr uint8_t REGISTER_L = 5;
+static constexpr uint8_t REGISTER_M = 6;
+static constexpr uint8_t REGISTER_A = 7;
+
+static constexpr std::array<uint8_t, 7> ALL_REGISTERS = { REGISTER_B, REGISTER_C, REGISTER_D,
+                                                          REGISTER_E, REGISTER_H, REGISTER_L,
+                                                          REGISTER_A };
+// Everything but the pointers of the memory workload
+static constexpr std::array<uint8_t, 3> DATA_REGISTERS = { REGISTER_B, REGISTER_C, REGISTER_A };
+static constexpr std::array<uint8_t, 5> BRANCH_REGISTERS = { REGISTER_B, REGISTER_C, REGISTER_D,
+                                                             REGISTER_E, REGISTER_A };
+
+// The register forms of the ALU, immediate and condition code opcodes, by their three bit field
+static constexpr uint8_t ALU_REGISTER = 0x80;
+static constexpr uint8_t ALU_IMMEDIATE = 0xc6;
+static constexpr uint8_t MOV = 0x40;
+static constexpr uint8_t MVI = 0x06;
+static constexpr uint8_t INR = 0x04;
+static constexpr uint8_t DCR = 0x05;
+static constexpr uint8_t RETURN_IF = 0xc0;
+static constexpr uint8_t JUMP_IF = 0xc2;
+static constexpr uint8_t CALL_IF = 0xc4;
+static constexpr std::array<Instruction, 8> ACCUMULATOR_OPERATIONS = {
+    Instruction::RLC, Instruction::RRC, Instruction::RAL, Instruction::RAR,
+    Instruction::DAA, Instruction::CMA, Instruction::STC, Instruction::CMC
+};
+
+// Instructions between the memory workload's pointer wraps, so a pointer runs at most this many
+// bytes past the working set
+static constexpr size_t WRAP_INTERVAL = 32;
+static constexpr size_t MIN_SUBROUTINES = 4;
+static constexpr size_t MAX_SUBROUTINES = 64;
+static constexpr uint32_t MAX_POLLS = 8;
+
+static constexpr std::array<std::string_view, 6> KIND_NAMES = {
+    "alu", "memory", "branchy", "calls", "io", "self-modifying"
+};
+
+static uint8_t op(Instruction instruction)
+{
+    return static_cast<uint8_t>(instruction);
+}
+
+WorkloadGenerator::WorkloadGenerator(Config config) :
+    _config(config),
+    _working_set_mask(
+        std::bit_ceil(std::clamp(config.working_set, MIN_WORKING_SET, MAX_WORKING_SET)) - 1)
+{
+    if (config.length == 0 || config.length > MAX_LENGTH) {
+        throw std::runtime_error(
+            fmt::format("Workload length must be between 1 and {}: {}", MAX_LENGTH, config.length));
+    }
+}
+
+buffer WorkloadGenerator::generate()
+{
+    _engine.seed(_config.seed);
+    _program.clear();
+
+    _prologue();
+
+    std::vector<uint16_t> subroutines;
+    if (_config.kind == Kind::calls) {
+        size_t over = _program.size() + 1;
+        _emit_word(op(Instruction::JMP), 0);
+        subroutines = _subroutines();
+        _patch(over);
+    }
+
+    uint16_t loop = _address();
+    switch (_config.kind) {
+    case Kind::alu:
+        _alu_body();
+        break;
+    case Kind::memory:
+        _memory_body();
+        break;
+    case Kind::branchy:
+        _branchy_body();
+        break;
+    case Kind::calls:
+        _calls_body(subroutines);
+        break;
+    case Kind::io:
+        _io_body();
+        break;
+    case Kind::self_modifying:
+        _self_modifying_body();
+        break;
+    }
+
+    _epilogue(loop);
+
+    if (ORIGIN + _program.size() > DATA_BASE) {
+        throw std::runtime_error(
+            fmt::format("Workload of {} bytes runs into its data", _program.size()));
+    }
+
+    return _program;
+}
+
+std::string_view WorkloadGenerator::kind_name(Kind kind)
+{
+    return KIND_NAMES[static_cast<size_t>(kind)];
+}
+
+std::optional<WorkloadGenerator::Kind> WorkloadGenerator::parse_kind(std::string_view name)
+{
+    for (Kind kind : KINDS) {
+        if (kind_name(kind) == name) {
+            return kind;
+        }
+    }
+
+    return std::nullopt;
+}
+
+void WorkloadGenerator::_emit(uint8_t opcode, uint8_t operand)
+{
+    _emit(opcode);
+    _emit(operand);
+}
+
+void WorkloadGenerator::_emit_word(uint8_t opcode, uint16_t operand)
+{
+    _emit(opcode);
+    _emit(operand & 0xff);
+    _emit(operand >> 8);
+}
+
+void WorkloadGenerator::_patch(size_t operand_offset)
+{
+    uint16_t address = _address();
+    _program[operand_offset] = address & 0xff;
+    _program[operand_offset + 1] = address >> 8;
+}
+
+uint32_t WorkloadGenerator::_random(uint32_t count)
+{
+    return std::uniform_int_distribution<uint32_t>(0, count - 1)(_engine);
+}
+
+void WorkloadGenerator::_alu(std::span<const uint8_t> registers)
+{
+    auto any = [&]() { return registers[_random(registers.size())]; };
+    auto immediate = [&]() { return static_cast<uint8_t>(_random(0x100)); };
+
+    switch (_random(8)) {
+    case 0:
+        _emit(ALU_IMMEDIATE | (_random(8) << 3), immediate());
+        break;
+    case 1:
+        _emit(INR | (any() << 3));
+        break;
+    case 2:
+        _emit(DCR | (any() << 3));
+        break;
+    case 3:
+    {
+        uint8_t destination = any();
+        _emit(MOV | (destination << 3) | any());
+    } break;
+    case 4:
+        _emit(MVI | (any() << 3), immediate());
+        break;
+    case 5:
+        _emit(op(ACCUMULATOR_OPERATIONS[_random(ACCUMULATOR_OPERATIONS.size())]));
+        break;
+    default:
+        _emit(ALU_REGISTER | (_random(8) << 3) | any());
+        break;
+    }
+}
+
+void WorkloadGenerator::_wrap(uint8_t high_register)
+{
+    _emit(MOV | (REGISTER_A << 3) | high_register);
+    _emit(op(Instruction::ANI), _working_set_mask >> 8);
+    _emit(op(Instruction::ORI), DATA_BASE >> 8);
+    _emit(MOV | (high_register << 3) | REGISTER_A);
+}
+
+void WorkloadGenerator::_prologue()
+{
+    _emit_word(op(Instruction::LXI_SP), STACK_TOP);
+
+    if (_config.iterations) {
+        _emit_word(op(Instruction::LXI_H), _config.iterations);
+        _emit_word(op(Instruction::SHLD), COUNTER);
+    }
+
+    _emit_word(op(Instruction::LXI_H), DATA_BASE);
+    _emit_word(op(Instruction::SHLD), FIRST_POINTER);
+    _emit_word(op(Instruction::LXI_H), DATA_BASE + (_working_set_mask + 1) / 2);
+    _emit_word(op(Instruction::SHLD), SECOND_POINTER);
+
+    for (uint8_t reg : ALL_REGISTERS) {
+        _emit(MVI | (reg << 3), _random(0x100));
+    }
+}
+
+void WorkloadGenerator::_epilogue(uint16_t loop)
+{
+    if (!_config.iterations) {
+        _emit_word(op(Instruction::JMP), loop);
+        return;
+    }
+
+    _emit_word(op(Instruction::LHLD), COUNTER);
+    _emit(op(Instruction::DCX_H));
+    _emit_word(op(Instruction::SHLD), COUNTER);
+    _emit(op(Instruction::MOV_A_H));
+    _emit(op(Instruction::ORA_L));
+    _emit_word(op(Instruction::JNZ), loop);
+    _emit(op(Instruction::HLT));
+}
+
+void WorkloadGenerator::_alu_body()
+{
+    for (size_t count = 0; count < _config.length; count++) {
+        _alu(ALL_REGISTERS);
+    }
+}
+
+void WorkloadGenerator::_memory_body()
+{
+    // HL and DE are the pointers, kept in memory while the epilogue uses HL
+    _emit_word(op(Instruction::LHLD), SECOND_POINTER);
+    _emit(op(Instruction::XCHG));
+    _emit_word(op(Instruction::LHLD), FIRST_POINTER);
+
+    auto data = [&]() { return DATA_REGISTERS[_random(DATA_REGISTERS.size())]; };
+
+    for (size_t count = 0; count < _config.length; count++) {
+        switch (_random(8)) {
+        case 0:
+            _emit(MOV | (data() << 3) | REGISTER_M);
+            _emit(op(Instruction::INX_H));
+            break;
+        case 1:
+            _emit(MOV | (REGISTER_M << 3) | data());
+            _emit(op(Instruction::INX_H));
+            break;
+        case 2:
+            _emit(ALU_REGISTER | (_random(8) << 3) | REGISTER_M);
+            break;
+        case 3:
+            _emit(op(Instruction::LDAX_D));
+            _emit(op(Instruction::INX_D));
+            break;
+        case 4:
+            _emit(op(Instruction::STAX_D));
+            _emit(op(Instruction::INX_D));
+            break;
+        case 5:
+            // A jump elsewhere in the working set
+            _emit_word(op(Instruction::LXI_B), 1 + _random(_working_set_mask));
+            _emit(op(Instruction::DAD_B));
+            _wrap(REGISTER_H);
+            break;
+        default:
+            _alu(DATA_REGISTERS);
+            break;
+        }
+
+        if ((count + 1) % WRAP_INTERVAL == 0) {
+            _wrap(REGISTER_H);
+            _wrap(REGISTER_D);
+        }
+    }
+
+    _wrap(REGISTER_H);
+    _wrap(REGISTER_D);
+    _emit_word(op(Instruction::SHLD), FIRST_POINTER);
+    _emit(op(Instruction::XCHG));
+    _emit_word(op(Instruction::SHLD), SECOND_POINTER);
+}
+
+void WorkloadGenerator::_branchy_body()
+{
+    for (size_t count = 0; count < _config.length;) {
+        uint32_t before = 1 + _random(3);
+        for (uint32_t i = 0; i < before; i++) {
+            _alu(BRANCH_REGISTERS);
+        }
+
+        // Skips a few instructions on whatever the flags are by now
+        size_t skip = _program.size() + 1;
+        _emit_word(JUMP_IF | (_random(8) << 3), 0);
+
+        uint32_t skipped = 1 + _random(3);
+        for (uint32_t i = 0; i < skipped; i++) {
+            _alu(BRANCH_REGISTERS);
+        }
+
+        _patch(skip);
+        count += before + 1 + skipped;
+    }
+}
+
+std::vector<uint16_t> WorkloadGenerator::_subroutines()
+{
+    size_t count = std::clamp(_config.length / 16, MIN_SUBROUTINES, MAX_SUBROUTINES);
+    std::vector<uint16_t> addresses(count);
+
+    // Each one may call a later one, so the deepest are emitted first and nothing recurses
+    for (size_t index = count; index-- > 0;) {
+        addresses[index] = _address();
+
+        for (uint32_t i = 0, n = 1 + _random(4); i < n; i++) {
+            _alu(ALL_REGISTERS);
+        }
+
+        if (_random(2)) {
+            _emit(RETURN_IF | (_random(8) << 3));
+        }
+
+        if (index + 1 < count && _random(2)) {
+            _emit_word(op(Instruction::CALL), addresses[index + 1 + _random(count - index - 1)]);
+        }
+
+        _alu(ALL_REGISTERS);
+        _emit(op(Instruction::RET));
+    }
+
+    return addresses;
+}
+
+void WorkloadGenerator::_calls_body(const std::vector<uint16_t>& subroutines)
+{
+    for (size_t count = 0; count < _config.length;) {
+        uint32_t between = _random(3);
+        for (uint32_t i = 0; i < between; i++) {
+            _alu(ALL_REGISTERS);
+        }
+
+        uint16_t target = subroutines[_random(subroutines.size())];
+        if (_random(3) == 0) {
+            _emit_word(op(Instruction::CALL), target);
+        } else {
+            _emit_word(CALL_IF | (_random(8) << 3), target);
+        }
+
+        count += between + 1;
+    }
+}
+
+void WorkloadGenerator::_io_body()
+{
+    for (size_t count = 0; count < _config.length;) {
+        switch (_random(3)) {
+        case 0:
+        {
+            // Waits for the ready bit, giving up after a few polls
+            _emit(MVI | (REGISTER_B << 3), 1 + _random(MAX_POLLS));
+            uint16_t poll = _address();
+            _emit(op(Instruction::IN), STATUS_PORT);
+            _emit(op(Instruction::ANI), 0x01);
+            size_t ready = _program.size() + 1;
+            _emit_word(op(Instruction::JNZ), 0);
+            _emit(DCR | (REGISTER_B << 3));
+            _emit_word(op(Instruction::JNZ), poll);
+            _patch(ready);
+            _emit(op(Instruction::IN), DATA_PORT);
+            _emit(op(Instruction::OUT), DATA_PORT);
+            count += 8;
+        } break;
+        case 1:
+            _alu(ALL_REGISTERS);
+            _emit(op(Instruction::OUT), DATA_PORT);
+            count += 2;
+            break;
+        default:
+            _emit(op(Instruction::IN), DATA_PORT);
+            _alu(ALL_REGISTERS);
+            count += 2;
+            break;
+        }
+    }
+}
+
+void WorkloadGenerator::_self_modifying_body()
+{
+    // Addresses of immediates in the body, which later instructions keep rewriting
+    std::vector<uint16_t> immediates;
+
+    for (size_t count = 0; count < _config.length;) {
+        switch (_random(4)) {
+        case 0:
+        {
+            // Hands the very next instruction its immediate
+            uint16_t operand = _address() + 2 + 3 + 1;
+            _emit(MVI | (REGISTER_A << 3), _random(0x100));
+            _emit_word(op(Instruction::STA), operand);
+            _emit(ALU_IMMEDIATE | (_random(8) << 3), 0);
+            immediates.push_back(operand);
+            count += 3;
+        } break;
+        case 1:
+            // Bumps one of the immediates already emitted, seen from the next pass on
+            if (!immediates.empty()) {
+                uint16_t operand = immediates[_random(immediates.size())];
+                _emit_word(op(Instruction::LDA), operand);
+                _emit(op(Instruction::INR_A));
+                _emit_word(op(Instruction::STA), operand);
+                count += 3;
+            }
+            break;
+        case 2:
+        {
+            // Turns the INR B after it into a DCR B and back on every pass
+            uint16_t target = _address() + 3 + 2 + 3;
+            _emit_word(op(Instruction::LDA), target);
+            _emit(op(Instruction::XRI), INR ^ DCR);
+            _emit_word(op(Instruction::STA), target);
+            _emit(op(Instruction::INR_B));
+            count += 4;
+        } break;
+        default:
+            _alu(ALL_REGISTERS);
+            count++;
+            break;
+        }
+    }
+}
+} // namespace i8080
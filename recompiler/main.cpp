@@ -0,0 +1,61 @@
+#include <i8080/recompiler.h>
+
+#include <fmt/core.h>
+#include <fmt/os.h>
+
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static buffer read_image(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error(fmt::format("Could not open file: {}", path));
+    }
+
+    return buffer(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 4) {
+        fmt::println("Usage: recompile <rom> <output> <name> [--origin <address>] "
+                     "[--entry <address>]...");
+        return 1;
+    }
+
+    try {
+        uint16_t origin = i8080::Recompiler::DEFAULT_ORIGIN;
+        std::vector<uint16_t> entry_points;
+
+        for (int i = 4; i + 1 < argc; i += 2) {
+            std::string argument = argv[i];
+            auto address = static_cast<uint16_t>(std::stoul(argv[i + 1], nullptr, 0));
+
+            if (argument == "--origin") {
+                origin = address;
+            } else if (argument == "--entry") {
+                entry_points.push_back(address);
+            } else {
+                throw std::runtime_error(fmt::format("Unknown option: {}", argument));
+            }
+        }
+
+        i8080::Recompiler recompiler(read_image(argv[1]), origin);
+        for (uint16_t entry_point : entry_points) {
+            recompiler.add_entry_point(entry_point);
+        }
+
+        fmt::output_file(argv[2]).print("{}", recompiler.translate(argv[3]));
+        fmt::println("{}: {} blocks", argv[1], recompiler.block_count());
+    } catch (const std::exception& e) {
+        fmt::println(stderr, "Recompiling failed: {}", e.what());
+        return 2;
+    }
+
+    return 0;
+}
@@ -0,0 +1,26 @@
+;***********************************************************************
+; CALL GRAPH ALIAS TEST
+;
+; START calls INNER through the undocumented alias of CALL, and INNER
+; returns through the alias of RET. INNER must get its own frame, and
+; the loop that follows back in START must not be charged to it.
+;***********************************************************************
+;
+WBOOT	EQU	0
+;
+	ORG	00100H
+;
+START:	LXI	SP,STACK
+	DB	0DDH		;CALL INNER
+	DW	INNER
+	MVI	B,100
+SPIN:	DCR	B
+	JNZ	SPIN
+	JMP	WBOOT
+;
+INNER:	MVI	A,10
+	DB	0D9H		;RET
+;
+	DS	16
+STACK:
+	END
@@ -0,0 +1,28 @@
+;***********************************************************************
+; CALL GRAPH SKIP-FRAME RETURN TEST
+;
+; INNER drops the return address OUTER called it with and returns
+; straight to START, closing both frames with one RET. The loop that
+; follows back in START must not be charged to OUTER or INNER.
+;***********************************************************************
+;
+WBOOT	EQU	0
+;
+	ORG	00100H
+;
+START:	LXI	SP,STACK
+	CALL	OUTER
+	MVI	B,100
+SPIN:	DCR	B
+	JNZ	SPIN
+	JMP	WBOOT
+;
+OUTER:	CALL	INNER
+	RET			;NEVER REACHED
+;
+INNER:	POP	H		;DROP THE RETURN TO OUTER
+	RET			;AND RETURN TO START
+;
+	DS	16
+STACK:
+	END
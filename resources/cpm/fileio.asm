@@ -0,0 +1,183 @@
+;***********************************************************************
+; CP/M FILE FUNCTION TEST
+;
+; Makes, writes, closes, reopens, reads, overwrites, searches for and
+; deletes TEST.DAT in the current directory through the BDOS, checking
+; every result. Prints FILE IO OK, or the step that failed.
+;***********************************************************************
+;
+BDOS	EQU	5
+DMA	EQU	80H
+;
+	ORG	00100H
+;
+START:	LXI	SP,STACK
+;A PREVIOUS RUN MAY HAVE LEFT THE FILE BEHIND
+	MVI	C,19		;DELETE FILE
+	LXI	D,FCB
+	CALL	BDOS
+	MVI	C,22		;MAKE FILE
+	LXI	D,FCB
+	CALL	BDOS
+	MVI	B,'1'
+	CPI	0FFH
+	JZ	FAIL
+;THREE RECORDS, OF 'A', 'B' AND 'C'
+	MVI	A,'A'
+WLOOP:	STA	FILL
+	CALL	FILDMA
+	MVI	C,21		;WRITE SEQUENTIAL
+	LXI	D,FCB
+	CALL	BDOS
+	MVI	B,'2'
+	ORA	A
+	JNZ	FAIL
+	LDA	FILL
+	INR	A
+	CPI	'D'
+	JNZ	WLOOP
+	MVI	C,16		;CLOSE FILE
+	LXI	D,FCB
+	CALL	BDOS
+	MVI	B,'3'
+	CPI	0FFH
+	JZ	FAIL
+;REOPEN IT AND READ THE RECORDS BACK IN ORDER
+	CALL	CLRFCB
+	MVI	C,15		;OPEN FILE
+	LXI	D,FCB
+	CALL	BDOS
+	MVI	B,'4'
+	CPI	0FFH
+	JZ	FAIL
+	MVI	A,'A'
+RLOOP:	STA	FILL
+	MVI	C,20		;READ SEQUENTIAL
+	LXI	D,FCB
+	CALL	BDOS
+	MVI	B,'5'
+	ORA	A
+	JNZ	FAIL
+	CALL	CHECK
+	LDA	FILL
+	INR	A
+	CPI	'D'
+	JNZ	RLOOP
+;A FOURTH READ IS PAST THE END OF THE FILE
+	MVI	C,20		;READ SEQUENTIAL
+	LXI	D,FCB
+	CALL	BDOS
+	MVI	B,'6'
+	CPI	1
+	JNZ	FAIL
+;OVERWRITE RECORD 1, THEN READ RECORDS 2 AND 1 AT RANDOM
+	MVI	A,'X'
+	STA	FILL
+	CALL	FILDMA
+	LXI	H,1
+	SHLD	FCB+33
+	MVI	C,34		;WRITE RANDOM
+	LXI	D,FCB
+	CALL	BDOS
+	MVI	B,'7'
+	ORA	A
+	JNZ	FAIL
+	MVI	A,'C'
+	STA	FILL
+	LXI	H,2
+	CALL	RREAD
+	MVI	A,'X'
+	STA	FILL
+	LXI	H,1
+	CALL	RREAD
+	MVI	C,16		;CLOSE FILE
+	LXI	D,FCB
+	CALL	BDOS
+;THE FILE IS IN THE DIRECTORY AND STILL THREE RECORDS LONG
+	MVI	C,17		;SEARCH FIRST
+	LXI	D,FCB
+	CALL	BDOS
+	MVI	B,'8'
+	CPI	0FFH
+	JZ	FAIL
+	MVI	C,35		;COMPUTE FILE SIZE
+	LXI	D,FCB
+	CALL	BDOS
+	MVI	B,'9'
+	LDA	FCB+33
+	CPI	3
+	JNZ	FAIL
+;AND GONE ONCE DELETED
+	MVI	C,19		;DELETE FILE
+	LXI	D,FCB
+	CALL	BDOS
+	MVI	C,17		;SEARCH FIRST
+	LXI	D,FCB
+	CALL	BDOS
+	MVI	B,'0'
+	CPI	0FFH
+	JNZ	FAIL
+	LXI	D,OKMSG
+	MVI	C,9		;PRINT STRING
+	CALL	BDOS
+	JMP	0
+;
+;READ THE RECORD IN HL AT RANDOM AND CHECK IT HOLDS FILL
+RREAD:	SHLD	FCB+33
+	MVI	C,33		;READ RANDOM
+	LXI	D,FCB
+	CALL	BDOS
+	MVI	B,'R'
+	ORA	A
+	JNZ	FAIL
+;CHECK THE DMA BUFFER HOLDS FILL
+CHECK:	LDA	FILL
+	MOV	C,A
+	LXI	H,DMA
+	MVI	D,128
+	MVI	B,'C'
+CLOOP:	MOV	A,M
+	CMP	C
+	JNZ	FAIL
+	INX	H
+	DCR	D
+	JNZ	CLOOP
+	RET
+;
+;FILL THE DMA BUFFER WITH FILL
+FILDMA:	LDA	FILL
+	LXI	H,DMA
+	MVI	D,128
+FLOOP:	MOV	M,A
+	INX	H
+	DCR	D
+	JNZ	FLOOP
+	RET
+;
+;CLEAR THE EXTENT AND RECORD FIELDS OF THE FCB
+CLRFCB:	XRA	A
+	LXI	H,FCB+12
+	MVI	D,24
+ZLOOP:	MOV	M,A
+	INX	H
+	DCR	D
+	JNZ	ZLOOP
+	RET
+;
+;B HOLDS THE STEP THAT FAILED
+FAIL:	MOV	A,B
+	STA	STEP
+	LXI	D,ERRMSG
+	MVI	C,9		;PRINT STRING
+	CALL	BDOS
+	JMP	0
+;
+FCB:	DB	0,'TEST    DAT'
+	DS	24
+FILL:	DB	0
+OKMSG:	DB	'FILE IO OK',13,10,'$'
+ERRMSG:	DB	'FILE IO FAILED AT STEP '
+STEP:	DB	'?',13,10,'$'
+	DS	64
+STACK:
+	END
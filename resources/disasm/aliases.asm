@@ -0,0 +1,20 @@
+;***********************************************************************
+; UNDOCUMENTED ALIAS TEST
+;
+; Calls, jumps and returns through the undocumented aliases of CALL,
+; JMP and RET, which the assembler has no mnemonics for. The
+; disassembler has to follow them as the CPU does, to SUB and to DONE,
+; and leave the bytes they skip over as data.
+;***********************************************************************
+;
+	ORG	00100H
+;
+START:	DB	0DDH		;CALL SUB
+	DW	SUB
+	DB	0CBH		;JMP DONE
+	DW	DONE
+	DB	0
+SUB:	DB	0D9H		;RET
+	DB	0,0
+DONE:	HLT
+	END
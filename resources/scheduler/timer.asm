@@ -0,0 +1,33 @@
+;***********************************************************************
+; SCHEDULER TIMER TEST
+;
+; Halts until a timer device has interrupted through RST 1 three times,
+; then ends the test. The CPU spends nearly all of its time halted, so
+; the devices must keep running while it is.
+;***********************************************************************
+;
+WBOOT	EQU	0
+RST1	EQU	8
+TICKS	EQU	3
+;
+	ORG	00100H
+;
+START:	LXI	SP,STACK
+	MVI	A,0C3H		;JMP TICK AT THE RST 1 VECTOR
+	STA	RST1
+	LXI	H,TICK
+	SHLD	RST1+1
+	MVI	B,TICKS
+WAIT:	EI
+	HLT
+	MOV	A,B
+	ORA	A
+	JNZ	WAIT
+	JMP	WBOOT
+;
+TICK:	DCR	B
+	RET
+;
+	DS	16
+STACK:
+	END
@@ -0,0 +1,39 @@
+;***********************************************************************
+; SYSTEM PING-PONG TEST
+;
+; Two CPUs pass a ball back and forth through a shared page. PING only
+; moves an even ball and PONG only an odd one, so just one of them
+; writes it at a time. Each moves it ROUNDS times, then both spin.
+;***********************************************************************
+;
+BALL	EQU	0200H
+ROUNDS	EQU	100
+;
+	ORG	00100H
+;
+	JMP	PING		;ENTRY OF THE FIRST CPU
+	JMP	PONG		;ENTRY OF THE SECOND CPU
+;
+PING:	MVI	B,ROUNDS
+PING1:	LDA	BALL
+	ANI	1
+	JNZ	PING1		;WAIT FOR AN EVEN BALL
+	LDA	BALL
+	INR	A
+	STA	BALL
+	DCR	B
+	JNZ	PING1
+	JMP	DONE
+;
+PONG:	MVI	B,ROUNDS
+PONG1:	LDA	BALL
+	ANI	1
+	JZ	PONG1		;WAIT FOR AN ODD BALL
+	LDA	BALL
+	INR	A
+	STA	BALL
+	DCR	B
+	JNZ	PONG1
+;
+DONE:	JMP	DONE
+	END
@@ -0,0 +1,56 @@
+# cmake -DTESTER=<tester> -DROM=<test_rom> -DLISTING=<listing> -DFOLDED=<folded_output>
+#       -DSYMBOLS=<name,...> -P check_profile.cmake
+#
+# Profiles the ROM with the tester and checks that each of the given routines has samples in the
+# flat report and in the folded stacks, and that the folded stacks add up to the report's total.
+execute_process(
+    COMMAND ${TESTER} --profile ${ROM} ${LISTING} ${FOLDED}
+    RESULT_VARIABLE RESULT
+    OUTPUT_VARIABLE REPORT
+)
+
+if(NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "Profiling ${ROM} failed: ${RESULT}")
+endif()
+
+if(NOT REPORT MATCHES "\n([0-9]+) samples\n")
+    message(FATAL_ERROR "No sample total in the report:\n${REPORT}")
+endif()
+
+set(TOTAL ${CMAKE_MATCH_1})
+string(REPLACE "," ";" SYMBOLS "${SYMBOLS}")
+file(STRINGS ${FOLDED} STACKS)
+
+foreach(SYMBOL IN LISTS SYMBOLS)
+    if(NOT REPORT MATCHES "\n${SYMBOL} +[1-9][0-9]* ")
+        message(FATAL_ERROR "${SYMBOL} has no samples in the report")
+    endif()
+
+    set(FOUND FALSE)
+
+    foreach(STACK IN LISTS STACKS)
+        if(STACK MATCHES "(^|;)${SYMBOL}[; ]")
+            set(FOUND TRUE)
+        endif()
+    endforeach()
+
+    if(NOT FOUND)
+        message(FATAL_ERROR "${SYMBOL} is on no folded stack")
+    endif()
+endforeach()
+
+set(SUM 0)
+
+foreach(STACK IN LISTS STACKS)
+    if(NOT STACK MATCHES " ([0-9]+)$")
+        message(FATAL_ERROR "Not a folded stack: ${STACK}")
+    endif()
+
+    math(EXPR SUM "${SUM} + ${CMAKE_MATCH_1}")
+endforeach()
+
+if(NOT SUM EQUAL TOTAL)
+    message(FATAL_ERROR "The folded stacks hold ${SUM} samples, the report ${TOTAL}")
+endif()
+
+message(STATUS "${TOTAL} samples profiled")
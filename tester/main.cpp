@@ -1,32 +1,193 @@
+#include <i8080/breakpoints.h>
 #include <i8080/bus.h>
+#include <i8080/callgraph.h>
+#include <i8080/cosim.h>
+#include <i8080/cpm.h>
 #include <i8080/cpu.h>
 #include <i8080/device.h>
+#include <i8080/disasm.h>
+#include <i8080/gdbstub.h>
+#include <i8080/heatmap.h>
+#include <i8080/imagecache.h>
+#include <i8080/machine.h>
+#include <i8080/metrics.h>
+#include <i8080/native.h>
+#include <i8080/pacer.h>
+#include <i8080/profile.h>
+#include <i8080/sampler.h>
+#include <i8080/scheduler.h>
+#include <i8080/symbols.h>
+#include <i8080/system.h>
+#include <i8080/timetravel.h>
+#include <i8080/trace.h>
+#include <i8080/workload.h>
 
 #include <fmt/core.h>
+#include <fmt/os.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <span>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
 namespace fs = std::filesystem;
 using buffer = std::vector<uint8_t>;
 
+// Recompiled at build time by i8080_recompile()
+extern const i8080::NativeProgram test8080_native;
+
+static const std::array NATIVE_PROGRAMS = { &test8080_native };
+
 static constexpr uint16_t PROGRAM_START_OFFSET = 0x100;
+static constexpr uint64_t DEFAULT_COSIM_STEPS = 100000;
+static constexpr uint64_t DEFAULT_SAMPLE_INTERVAL = 10;
+static constexpr uint64_t DEFAULT_HEATMAP_WINDOW = 1000;
+static constexpr uint64_t DEFAULT_TIMER_PERIOD = 1000;
+// Where resources/system/pingpong.com keeps its ball, in a page the CPUs share
+static constexpr uint16_t SYSTEM_BALL_ADDRESS = 0x0200;
+// Plenty for the ping-pong ROM to finish, even if every pass waits out a quantum
+static constexpr uint64_t SYSTEM_CYCLES = 1'000'000;
+// Of the slowest instruction, which is how far a CPU may run past the end of a quantum
+static constexpr uint64_t MAX_INSTRUCTION_CYCLES = 18;
+// Long past the end of any ROM the timer is meant to wake
+static constexpr uint64_t TIMER_MAX_CYCLES = 100'000'000;
+static constexpr size_t DEFAULT_POOL_CAPACITY = 4;
+// Short, so a diagnostic ROM spans many checkpoints
+static constexpr uint64_t DEFAULT_CHECKPOINT_INTERVAL = 1000;
+// Enough for the exerciser ROMs, which run for tens of billions of cycles
+static constexpr uint64_t DEFAULT_BATCH_MAX_CYCLES = 100'000'000'000;
+static constexpr std::chrono::seconds DEFAULT_BATCH_TIMEOUT = std::chrono::minutes(10);
+// Cycles between checks of the time limit
+static constexpr uint64_t BATCH_SLICE_CYCLES = 1 << 22;
+static constexpr uint16_t DEFAULT_WORKLOAD_ITERATIONS = 1000;
+// Far more than any workload takes for its iterations
+static constexpr uint64_t WORKLOAD_MAX_CYCLES = 1'000'000'000;
+
+struct ProfileOptions
+{
+    fs::path listing;
+    // Sampled stacks, for flamegraph.pl
+    std::optional<fs::path> folded_output;
+    // The call graph, for KCachegrind
+    std::optional<fs::path> callgrind_output;
+    uint64_t interval = DEFAULT_SAMPLE_INTERVAL;
+};
+
+struct HeatmapOptions
+{
+    fs::path output;
+    uint64_t window = DEFAULT_HEATMAP_WINDOW;
+};
+
+// Stops at an instruction, or at accesses to a byte, and reports every hit before resuming
+struct StopOptions
+{
+    bool watch = false;
+    uint16_t address = 0;
+    std::optional<std::string> condition;
+};
+
+// Runs the ROM as a CP/M program with its files in the directory
+struct CpmOptions
+{
+    fs::path directory;
+    std::vector<std::string> arguments;
+};
+
+struct RunOptions
+{
+    bool debug = false;
+    // Runs the recompiled code for the ROM
+    bool native = false;
+    std::optional<ProfileOptions> profile;
+    // Records every instruction into a trace file, for tracedump to decode
+    std::optional<fs::path> trace;
+    std::optional<HeatmapOptions> heatmap;
+    std::optional<StopOptions> stop;
+    // Waits for GDB on this Unix domain socket before running
+    std::optional<fs::path> gdb_socket;
+    std::optional<CpmOptions> cpm;
+    // Paces the guest to this clock, in Hz
+    std::optional<uint64_t> realtime_hz;
+};
+
+// Runs many ROMs side by side, each to the end of the test or to one of the limits
+struct BatchOptions
+{
+    std::vector<fs::path> roms;
+    unsigned jobs = std::max(1U, std::thread::hardware_concurrency());
+    uint64_t max_cycles = DEFAULT_BATCH_MAX_CYCLES;
+    std::chrono::duration<double> timeout = DEFAULT_BATCH_TIMEOUT;
+    std::optional<fs::path> json;
+    // Runs recompiled code for the ROMs that have some
+    bool native = false;
+    // Interprets with fast timing, which undercounts taken conditional calls and returns
+    bool fast = false;
+    // Runs the ROMs as CP/M programs with their files in this directory
+    std::optional<fs::path> cpm_directory;
+    // Maps the ROMs from the host's shared image cache instead of reading a copy for each
+    bool shared_roms = false;
+};
+
+enum class Outcome : uint8_t
+{
+    passed,
+    // Finished, but printed a failure
+    failed,
+    cycle_limit,
+    timeout,
+    // Could not be loaded
+    error
+};
+
+struct RomResult
+{
+    fs::path rom;
+    Outcome outcome = Outcome::error;
+    uint64_t cycles = 0;
+    double seconds = 0;
+    std::string console;
+
+    double emulated_mhz() const { return seconds ? cycles / seconds / 1e6 : 0.0; }
+};
 
 class TestControlDevice : public i8080::Device
 {
 public:
-    TestControlDevice(bool& finished) :
-        _finished(finished)
+    TestControlDevice(bool& finished, i8080::Cpu& cpu) :
+        _finished(finished),
+        _cpu(cpu)
     {}
 
-    void write(uint8_t) override { _finished.get() = true; }
+    // Also ends a Cpu::run() early, so nothing runs past the end of the test
+    void write(uint8_t) override
+    {
+        _finished.get() = true;
+        _cpu.get().stop();
+    }
 
 private:
     std::reference_wrapper<bool> _finished;
+    std::reference_wrapper<i8080::Cpu> _cpu;
 };
 
 class IODevice : public i8080::Device
@@ -35,16 +196,21 @@ class IODevice : public i8080::Device
     static constexpr uint8_t PRINT_MESSAGE = 9;
 
 public:
-    IODevice(const i8080::Cpu& cpu, const buffer& memory) :
+    // Prints to stdout, or collects the output in the console if there is one
+    IODevice(const i8080::Cpu& cpu,
+             std::span<const uint8_t> memory,
+             std::string* console = nullptr) :
         _cpu(cpu),
-        _memory(memory)
+        _memory(memory),
+        _console(console)
     {}
 
-    void write(uint8_t byte) override
+    // The BDOS function is in C, whatever OUT sends
+    void write(uint8_t) override
     {
-        switch (byte) {
+        switch (_cpu.get().state().c) {
         case PRINT_STATUS_REG_E:
-            fmt::print("{:c}", static_cast<char>(_cpu.get().state().e));
+            _print(static_cast<char>(_cpu.get().state().e));
             break;
         case PRINT_MESSAGE:
             _print_message_in_de();
@@ -55,20 +221,47 @@ public:
     }
 
 private:
+    void _print(char character)
+    {
+        if (_console) {
+            _console->push_back(character);
+        } else {
+            std::cout << character;
+        }
+    }
+
     void _print_message_in_de()
     {
         uint16_t address = _cpu.get().state().de;
-        for (; _memory.get()[address] != '$'; address++) {
-            std::cout << _memory.get()[address];
+        for (; _memory[address] != '$'; address++) {
+            _print(static_cast<char>(_memory[address]));
         }
 
-        std::cout << std::endl;
+        if (_console) {
+            _console->push_back('\n');
+        } else {
+            std::cout << std::endl;
+        }
     }
 
     std::reference_wrapper<const i8080::Cpu> _cpu;
-    std::reference_wrapper<const buffer> _memory;
+    std::span<const uint8_t> _memory;
+    std::string* _console;
 };
 
+// The CP/M entry points the diagnostic ROMs call, answered by the test devices
+void inject_test_hooks(std::span<uint8_t> memory)
+{
+    // Inject "OUT 0" at 0 (stop test)
+    memory[0] = 0xD3;
+    memory[1] = 0x00;
+
+    // Inject "OUT 1" at 5 (print characters)
+    memory[5] = 0xD3;
+    memory[6] = 0x01;
+    memory[7] = 0xC9;
+}
+
 bool load_binary(const fs::path& path, buffer& memory)
 {
     std::memset(memory.data(), 0, memory.capacity());
@@ -78,52 +271,1482 @@ bool load_binary(const fs::path& path, buffer& memory)
     }
 
     if (test_file.read(reinterpret_cast<char*>(memory.data() + PROGRAM_START_OFFSET),
-                       memory.size())) {
+                       memory.size() - PROGRAM_START_OFFSET)) {
         throw std::runtime_error(fmt::format("Could not read file: {}", path.string()));
     }
 
-    // Inject "OUT 0" at 0 (stop test)
-    memory[0] = 0xD3;
-    memory[1] = 0x00;
+    inject_test_hooks(memory);
+    return true;
+}
 
-    // Inject "OUT 1" at 5 (print characters)
-    memory[5] = 0xD3;
-    memory[6] = 0x01;
-    memory[7] = 0xC9;
+static const i8080::NativeProgram* find_native_program(std::span<const uint8_t> memory)
+{
+    for (const i8080::NativeProgram* program : NATIVE_PROGRAMS) {
+        if (program->matches(memory)) {
+            return program;
+        }
+    }
 
-    return true;
+    return nullptr;
+}
+
+static std::string_view hit_kind(i8080::Breakpoints::Hit::Kind kind)
+{
+    switch (kind) {
+    case i8080::Breakpoints::Hit::Kind::breakpoint:
+        return "Breakpoint";
+    case i8080::Breakpoints::Hit::Kind::read:
+        return "Read";
+    case i8080::Breakpoints::Hit::Kind::write:
+        return "Write";
+    }
+
+    return "";
 }
 
-static uint64_t run_test(const fs::path& test_rom, bool debug)
+static void run_stopping(i8080::Cpu& cpu,
+                         i8080::Bus& bus,
+                         const StopOptions& options,
+                         const bool& test_finished)
 {
-    buffer memory(i8080::Cpu::NAMESPACE_SIZE);
+    i8080::Breakpoints breakpoints(cpu, bus);
+
+    std::optional<i8080::Condition> condition;
+    if (options.condition) {
+        condition.emplace(*options.condition);
+    }
+
+    if (options.watch) {
+        breakpoints.add_watchpoint(options.address,
+                                   options.address,
+                                   i8080::Breakpoints::Access::read_write,
+                                   std::move(condition));
+    } else {
+        breakpoints.add_breakpoint(options.address, std::move(condition));
+    }
+
+    uint64_t hits = 0;
+    while (!test_finished && !cpu.halt()) {
+        i8080::Cpu::StopReason reason = cpu.run(BATCH_SLICE_CYCLES);
+        if (reason != i8080::Cpu::StopReason::breakpoint &&
+            (reason != i8080::Cpu::StopReason::stop || test_finished)) {
+            continue;
+        }
+
+        const i8080::Breakpoints::Hit& hit = *breakpoints.last_hit();
+        const i8080::Cpu::State& state = cpu.state();
+        fmt::println("\n{} at {:#06x} value={:#04x} pc={:#06x} cycle={} "
+                     "a={:#04x} bc={:#06x} de={:#06x} hl={:#06x} sp={:#06x}",
+                     hit_kind(hit.kind),
+                     hit.address,
+                     hit.value,
+                     hit.pc,
+                     hit.cycle,
+                     state.a,
+                     state.bc,
+                     state.de,
+                     state.hl,
+                     state.sp);
+        hits++;
+    }
+
+    fmt::println("\n{} hits", hits);
+}
+
+static uint64_t run_test(const fs::path& test_rom, const RunOptions& options)
+{
+    buffer memory(i8080::Bus::MEMORY_SIZE);
     load_binary(test_rom, memory);
 
     i8080::Bus bus(memory);
     i8080::Cpu cpu(bus, PROGRAM_START_OFFSET);
 
-    cpu.set_debug(debug);
+    cpu.set_debug(options.debug);
+
+    std::optional<i8080::Tracer> tracer;
+    if (options.trace) {
+        tracer.emplace(*options.trace, i8080::Tracer::Config { .registers = true });
+        cpu.set_tracer(&*tracer);
+    }
 
     bool test_finished = false;
-    bus.register_device(0, std::make_shared<TestControlDevice>(test_finished));
+    bus.register_device(0, std::make_shared<TestControlDevice>(test_finished, cpu));
     bus.register_device(1, std::make_shared<IODevice>(cpu, memory));
 
+    if (options.native) {
+        const i8080::NativeProgram* program = find_native_program(memory);
+        if (!program) {
+            throw std::runtime_error(fmt::format("No recompiled code for {}", test_rom.string()));
+        }
+
+        cpu.set_native_code(program->code);
+        while (!test_finished && !cpu.halt()) {
+            cpu.run(BATCH_SLICE_CYCLES);
+        }
+
+        return cpu.state().cycle;
+    }
+
+    if (options.cpm) {
+        i8080::Cpm cpm(cpu,
+                       bus,
+                       { .directory = options.cpm->directory,
+                         .arguments = options.cpm->arguments,
+                         .input = &std::cin });
+
+        while (!cpm.exited() && !cpu.halt()) {
+            cpu.run(BATCH_SLICE_CYCLES);
+        }
+
+        cpm.flush();
+        return cpu.state().cycle;
+    }
+
+    if (options.gdb_socket) {
+        i8080::GdbStub stub(cpu, bus, *options.gdb_socket);
+        fmt::println("Waiting for GDB on {}", options.gdb_socket->string());
+        stub.wait_for_debugger();
+
+        while (!test_finished && !cpu.halt()) {
+            stub.run(BATCH_SLICE_CYCLES);
+        }
+
+        return cpu.state().cycle;
+    }
+
+    if (options.realtime_hz) {
+        i8080::Pacer pacer(cpu, { .clock_hz = *options.realtime_hz });
+        while (!test_finished && !cpu.halt()) {
+            pacer.run(BATCH_SLICE_CYCLES);
+        }
+
+        const i8080::Pacer::Statistics& statistics = pacer.statistics();
+        fmt::println("\nPaced at {} Hz: {} slices, {} overruns, slept {} ms",
+                     *options.realtime_hz,
+                     statistics.slices,
+                     statistics.overruns,
+                     std::chrono::duration_cast<std::chrono::milliseconds>(statistics.slept)
+                         .count());
+        return cpu.state().cycle;
+    }
+
+    if (options.stop) {
+        run_stopping(cpu, bus, *options.stop, test_finished);
+        return cpu.state().cycle;
+    }
+
+    if (options.heatmap) {
+        i8080::MemoryHeatmap heatmap;
+        bus.set_heatmap(&heatmap);
+
+        while (!test_finished && !cpu.halt()) {
+            cpu.run(options.heatmap->window);
+            heatmap.close_window(cpu.state().cycle);
+        }
+
+        bus.set_heatmap(nullptr);
+        fmt::print("\n{}", heatmap.report());
+        heatmap.write_heatmap(options.heatmap->output);
+        return cpu.state().cycle;
+    }
+
+    const std::optional<ProfileOptions>& profile = options.profile;
+    if (!profile) {
+        while (!test_finished && !cpu.halt()) {
+            cpu.tick();
+        }
+
+        return cpu.state().cycle;
+    }
+
+    i8080::SymbolTable symbols = i8080::SymbolTable::from_listing(profile->listing);
+    i8080::CallGraph call_graph(cpu.state());
+    i8080::SamplingProfiler profiler(cpu, { .interval = profile->interval });
+
+    cpu.set_call_graph(&call_graph);
+    profiler.set_stack_walker([&call_graph](std::vector<uint16_t>& frames) {
+        call_graph.frames(frames);
+    });
+
     while (!test_finished && !cpu.halt()) {
-        cpu.tick();
+        profiler.run(profile->interval);
+    }
+
+    call_graph.finish(cpu.state().cycle);
+
+    if (profile->folded_output) {
+        fmt::print("\n{}", profiler.report(symbols));
+        fmt::output_file(profile->folded_output->string()).print("{}", profiler.folded(symbols));
+    }
+
+    if (profile->callgrind_output) {
+        fmt::print("\n{}", call_graph.report(symbols));
+        fmt::output_file(profile->callgrind_output->string())
+            .print("{}", call_graph.callgrind(symbols));
     }
 
     return cpu.state().cycle;
 }
 
+// The first word of the source column, skipping a label if the line has one
+static std::string listing_mnemonic(std::string_view source)
+{
+    if (!source.empty() && !std::isspace(static_cast<unsigned char>(source.front()))) {
+        size_t label_end = source.find_first_of(" \t");
+        source.remove_prefix(std::min(label_end, source.size()));
+    }
+
+    std::istringstream words { std::string(source) };
+    std::string mnemonic;
+    words >> mnemonic;
+    return mnemonic;
+}
+
+// Compares code and data separation and mnemonics with an assembler listing in the
+// test8080.txt layout, returns the number of mismatches
+static uint64_t check_listing(const i8080::Disassembler& disassembler, const fs::path& listing)
+{
+    static constexpr size_t ADDRESS_COLUMN = 1;
+    static constexpr size_t SOURCE_COLUMN = 16;
+
+    std::ifstream file(listing);
+    if (!file.is_open()) {
+        throw std::runtime_error(fmt::format("Could not open file: {}", listing.string()));
+    }
+
+    uint64_t mismatches = 0;
+    uint64_t instructions = 0;
+    std::string line;
+
+    while (std::getline(file, line)) {
+        if (line.size() <= SOURCE_COLUMN || line[0] != ' ' ||
+            !std::isxdigit(static_cast<unsigned char>(line[6]))) {
+            continue;
+        }
+
+        auto address =
+            static_cast<uint16_t>(std::stoul(line.substr(ADDRESS_COLUMN, 4), nullptr, 16));
+        std::string mnemonic = listing_mnemonic(std::string_view(line).substr(SOURCE_COLUMN));
+
+        if (mnemonic == "DB" || mnemonic == "DW" || mnemonic == "DS") {
+            if (disassembler.is_instruction(address)) {
+                fmt::println("{:04X}: listing has data, disassembled as code", address);
+                mismatches++;
+            }
+
+            continue;
+        }
+
+        instructions++;
+        const auto& metadata = i8080::get_opcode_metadata(disassembler.opcode(address).instruction);
+        std::string decoded = metadata.name.substr(0, metadata.name.find_first_of(" ,"));
+
+        if (!disassembler.is_instruction(address)) {
+            fmt::println("{:04X}: listing has {}, disassembled as data", address, mnemonic);
+            mismatches++;
+        } else if (decoded != mnemonic) {
+            fmt::println("{:04X}: listing has {}, disassembled as {}", address, mnemonic, decoded);
+            mismatches++;
+        }
+    }
+
+    fmt::println("{} listing instructions, {} mismatches", instructions, mismatches);
+    return mismatches;
+}
+
+// Prints a listing of the ROM, and compares it with the reference listing if there is one
+static uint64_t run_disasm(const fs::path& test_rom, const std::optional<fs::path>& reference)
+{
+    buffer memory(i8080::Bus::MEMORY_SIZE);
+    load_binary(test_rom, memory);
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Warm boot, BDOS and the program
+    i8080::Disassembler disassembler(memory, { 0x0000, 0x0005, PROGRAM_START_OFFSET });
+
+    std::optional<i8080::SymbolTable> symbols;
+    if (reference) {
+        symbols = i8080::SymbolTable::from_listing(*reference);
+    }
+
+    fmt::memory_buffer out;
+    disassembler.render(out,
+                        0,
+                        i8080::Disassembler::ADDRESS_SPACE - 1,
+                        symbols ? &*symbols : nullptr);
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::fwrite(out.data(), 1, out.size(), stdout);
+    fmt::println("\n{} instructions disassembled in {:.2f} ms",
+                 disassembler.instruction_count(),
+                 elapsed.count());
+
+    return reference ? check_listing(disassembler, *reference) : 0;
+}
+
+static void print_divergence(std::string_view name,
+                             const i8080::CoSimulator::Divergence& divergence)
+{
+    fmt::print("{} diverged at step {} (pc {:#06x}):\n{}",
+               name,
+               divergence.step,
+               divergence.pc,
+               divergence.description);
+}
+
+// Differentially runs random scenarios against the reference model on all cores, returns the
+// number of divergences
+static uint64_t run_cosim(uint64_t scenarios, uint64_t steps, i8080::Cpu::Timing timing)
+{
+    std::atomic<uint64_t> next_seed = 0;
+    std::atomic<uint64_t> divergences = 0;
+    std::mutex print_lock;
+
+    auto worker = [&]() {
+        for (uint64_t seed = next_seed++; seed < scenarios; seed = next_seed++) {
+            auto divergence = i8080::fuzz(seed, steps, timing);
+            if (!divergence) {
+                continue;
+            }
+
+            divergences++;
+            std::lock_guard lock(print_lock);
+            print_divergence(fmt::format("Seed {}", seed), *divergence);
+        }
+    };
+
+    std::vector<std::jthread> workers;
+    for (unsigned i = 0; i < std::max(1U, std::thread::hardware_concurrency()); i++) {
+        workers.emplace_back(worker);
+    }
+
+    workers.clear();
+    return divergences;
+}
+
+// Runs a ROM's recompiled blocks against the reference model, without devices attached
+static bool run_cosim_native(const fs::path& test_rom, uint64_t steps)
+{
+    buffer memory(i8080::Bus::MEMORY_SIZE);
+    load_binary(test_rom, memory);
+
+    const i8080::NativeProgram* program = find_native_program(memory);
+    if (!program) {
+        throw std::runtime_error(fmt::format("No recompiled code for {}", test_rom.string()));
+    }
+
+    // As a freshly constructed CPU starts
+    i8080::Cpu::State state {};
+    state.pc = PROGRAM_START_OFFSET;
+    state.interrupts_enabled = true;
+
+    i8080::CoSimulator cosim(memory, state, i8080::Cpu::Timing::exact, program->code);
+
+    auto divergence = cosim.run(steps, i8080::CoSimulator::Granularity::block);
+    if (divergence) {
+        print_divergence(test_rom.filename().string(), *divergence);
+    }
+
+    fmt::println("{} blocks co-simulated", cosim.steps());
+    return divergence.has_value();
+}
+
+// Runs a ROM forward under the time machine, then reverse-steps it back to the start, checking the
+// registers and memory at every instruction boundary against the way forward. Returns the number
+// of boundaries that differ.
+static uint64_t run_reverse(const fs::path& test_rom, uint64_t checkpoint_interval)
+{
+    buffer memory(i8080::Bus::MEMORY_SIZE);
+    load_binary(test_rom, memory);
+
+    i8080::Bus bus(memory);
+    i8080::Cpu cpu(bus, PROGRAM_START_OFFSET);
+
+    // Replays run the output again, so it is collected rather than printed
+    std::string console;
+    bool test_finished = false;
+    bus.register_device(0, std::make_shared<TestControlDevice>(test_finished, cpu));
+    bus.register_device(1, std::make_shared<IODevice>(cpu, memory, &console));
+
+    i8080::TimeMachine machine(cpu,
+                               bus,
+                               memory,
+                               { .checkpoint_interval = checkpoint_interval });
+
+    struct Boundary
+    {
+        i8080::Cpu::State state;
+        size_t memory_hash;
+    };
+
+    auto boundary = [&]() {
+        std::string_view bytes(reinterpret_cast<const char*>(memory.data()),
+                               i8080::Bus::ADDRESS_SPACE_SIZE);
+        return Boundary { .state = cpu.state(),
+                          .memory_hash = std::hash<std::string_view>()(bytes) };
+    };
+
+    // A ROM halting with interrupts enabled is woken through RST 1 right at its halt cycle
+    std::vector<Boundary> forward { boundary() };
+    uint64_t interrupts = 0;
+    while (!test_finished) {
+        if (!cpu.halt()) {
+            machine.tick();
+        } else if (cpu.state().interrupts_enabled) {
+            machine.interrupt(1);
+            interrupts++;
+        } else {
+            break;
+        }
+
+        forward.push_back(boundary());
+    }
+
+    size_t checkpoints = machine.checkpoint_count();
+    uint64_t mismatches = 0;
+    for (size_t i = forward.size() - 1; i > 0; i--) {
+        if (!machine.reverse_step()) {
+            fmt::println("Reverse step from cycle {} failed", forward[i].state.cycle);
+            return mismatches + i;
+        }
+
+        const Boundary& expected = forward[i - 1];
+        Boundary actual = boundary();
+        const i8080::Cpu::State& a = expected.state;
+        const i8080::Cpu::State& b = actual.state;
+        bool same = a.af == b.af && a.bc == b.bc && a.de == b.de && a.hl == b.hl &&
+                    a.sp == b.sp && a.pc == b.pc && a.cycle == b.cycle && a.halt == b.halt &&
+                    a.interrupts_enabled == b.interrupts_enabled &&
+                    a.interrupt_vector == b.interrupt_vector &&
+                    expected.memory_hash == actual.memory_hash;
+        if (!same) {
+            fmt::println("Instruction {} at {:#06x} (cycle {}) came back as pc {:#06x} (cycle {})",
+                         i - 1,
+                         a.pc,
+                         a.cycle,
+                         b.pc,
+                         b.cycle);
+            mismatches++;
+        }
+    }
+
+    fmt::println("{} instructions and {} interrupts reverse-stepped over {} checkpoints, {} "
+                 "mismatches",
+                 forward.size() - 1 - interrupts,
+                 interrupts,
+                 checkpoints,
+                 mismatches);
+    return mismatches;
+}
+
+// Interrupts through RST 1 every period cycles, counting the interrupts it raised
+static i8080::DeviceTask timer_device(i8080::Scheduler& scheduler,
+                                      uint64_t period,
+                                      uint64_t& raised)
+{
+    for (;;) {
+        co_await i8080::cycles(period);
+        scheduler.raise_irq(1);
+        raised++;
+    }
+}
+
+// Runs a ROM under the scheduler with a timer device attached, which is all that wakes it from a
+// halt. Returns the cycles it ran.
+static uint64_t run_timer(const fs::path& test_rom, uint64_t period)
+{
+    buffer memory(i8080::Bus::MEMORY_SIZE);
+    load_binary(test_rom, memory);
+
+    i8080::Bus bus(memory);
+    i8080::Cpu cpu(bus, PROGRAM_START_OFFSET);
+
+    bool test_finished = false;
+    bus.register_device(0, std::make_shared<TestControlDevice>(test_finished, cpu));
+    bus.register_device(1, std::make_shared<IODevice>(cpu, memory));
+
+    i8080::Scheduler scheduler(cpu, bus);
+    uint64_t raised = 0;
+    scheduler.spawn(timer_device(scheduler, period, raised));
+
+    while (!test_finished) {
+        if (cpu.state().cycle >= TIMER_MAX_CYCLES) {
+            throw std::runtime_error(
+                fmt::format("Still running after {} cycles", TIMER_MAX_CYCLES));
+        }
+
+        if (scheduler.run(BATCH_SLICE_CYCLES) == i8080::Cpu::StopReason::halt) {
+            throw std::runtime_error(
+                fmt::format("Halted at cycle {} with no device to wake it", cpu.state().cycle));
+        }
+    }
+
+    fmt::println("{} timer interrupts raised", raised);
+    return cpu.state().cycle;
+}
+
+// Runs a ROM on two CPUs that share its memory, the second starting 3 bytes after the first, and
+// checks that each of them stopped at the barrier after every quantum. Returns whether one did not.
+static bool run_system(const fs::path& test_rom, uint64_t quantum)
+{
+    buffer memory(i8080::Bus::MEMORY_SIZE);
+    load_binary(test_rom, memory);
+
+    i8080::System system(memory,
+                         { PROGRAM_START_OFFSET, PROGRAM_START_OFFSET + 3 },
+                         quantum);
+    system.share(SYSTEM_BALL_ADDRESS / i8080::Bus::PAGE_SIZE, 1);
+    system.run(SYSTEM_CYCLES);
+
+    uint64_t quanta = (SYSTEM_CYCLES + quantum - 1) / quantum;
+    bool failed = false;
+
+    for (size_t i = 0; i < system.size(); i++) {
+        uint64_t cycle = system.cpu(i).state().cycle;
+        if (cycle < quanta * quantum || cycle > quanta * (quantum + MAX_INSTRUCTION_CYCLES)) {
+            fmt::println("CPU {} ran {} cycles, not {} quanta of {}", i, cycle, quanta, quantum);
+            failed = true;
+        }
+    }
+
+    fmt::println("{} CPUs ran {} quanta of {} cycles, ball passed {} times",
+                 system.size(),
+                 quanta,
+                 quantum,
+                 memory[SYSTEM_BALL_ADDRESS]);
+    return failed;
+}
+
+// Checks text against the parts of the Prometheus text format the exporter uses: each family has
+// a HELP and a TYPE line ahead of its samples, counters end in _total, and every sample has its
+// family's name, well-formed labels and a number. Prints each problem and returns how many there
+// were.
+static uint64_t check_prometheus(std::string_view text, uint64_t& samples, uint64_t& families)
+{
+    static const std::regex help(R"(# HELP ([a-zA-Z_:][a-zA-Z0-9_:]*) \S.*)");
+    static const std::regex type(R"(# TYPE ([a-zA-Z_:][a-zA-Z0-9_:]*) (counter|gauge))");
+    static const std::regex sample(R"(([a-zA-Z_:][a-zA-Z0-9_:]*))"
+                                   R"(\{[a-zA-Z_]\w*="(?:[^"\\\n]|\\.)*")"
+                                   R"((?:,[a-zA-Z_]\w*="(?:[^"\\\n]|\\.)*")*\})"
+                                   R"( (-?[0-9]+(?:\.[0-9]+)?(?:e[+-]?[0-9]+)?))");
+
+    uint64_t errors = 0;
+    auto error = [&errors](size_t line, std::string_view problem) {
+        fmt::println("Line {}: {}", line, problem);
+        errors++;
+    };
+
+    if (!text.empty() && text.back() != '\n') {
+        error(0, "the text does not end with a newline");
+    }
+
+    std::vector<std::string> seen;
+    std::string helped;
+    std::string family;
+    size_t number = 0;
+    std::istringstream lines { std::string(text) };
+
+    for (std::string line; std::getline(lines, line);) {
+        number++;
+        std::smatch match;
+
+        if (std::regex_match(line, match, help)) {
+            helped = match[1];
+            if (std::ranges::find(seen, helped) != seen.end()) {
+                error(number, fmt::format("{} is described twice", helped));
+            }
+
+            seen.push_back(helped);
+            family.clear();
+        } else if (std::regex_match(line, match, type)) {
+            if (match[1] != helped) {
+                error(number, fmt::format("TYPE of {} without its HELP", match[1].str()));
+            } else if (match[2] == "counter" && !helped.ends_with("_total")) {
+                error(number, fmt::format("counter {} does not end in _total", helped));
+            }
+
+            family = match[1];
+            families++;
+        } else if (std::regex_match(line, match, sample)) {
+            if (match[1] != family) {
+                error(number, fmt::format("{} is not in a family of its own", match[1].str()));
+            }
+
+            samples++;
+        } else {
+            error(number, fmt::format("not a HELP, TYPE or sample line: {}", line));
+        }
+    }
+
+    return errors;
+}
+
+// Runs a ROM with metrics attached, writes them out in the Prometheus text format and checks
+// what was written. Returns the number of format errors. The CPU runs with fast timing, so the
+// block cache is counted too.
+static uint64_t run_metrics(const fs::path& test_rom, const fs::path& output)
+{
+    buffer memory(i8080::Bus::MEMORY_SIZE);
+    load_binary(test_rom, memory);
+
+    i8080::Bus bus(memory);
+    i8080::Cpu cpu(bus, PROGRAM_START_OFFSET, i8080::Cpu::Timing::fast);
+
+    i8080::Metrics metrics(test_rom.filename().string());
+    cpu.set_metrics(&metrics);
+    bus.set_metrics(&metrics);
+
+    bool test_finished = false;
+    bus.register_device(0, std::make_shared<TestControlDevice>(test_finished, cpu));
+    bus.register_device(1, std::make_shared<IODevice>(cpu, memory));
+
+    while (!test_finished && !cpu.halt()) {
+        cpu.run(BATCH_SLICE_CYCLES);
+    }
+
+    metrics.export_prometheus(output);
+
+    std::ifstream file(output);
+    std::string text { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    fmt::print("\n{}", text);
+
+    uint64_t samples = 0;
+    uint64_t families = 0;
+    uint64_t errors = check_prometheus(text, samples, families);
+    fmt::println("{} samples in {} families, {} format errors", samples, families, errors);
+    return errors;
+}
+
+// Fills a machine pool, empties it again and hands it machines it does not own, checking what
+// it does at every step. Returns the number of failed checks.
+static uint64_t run_pool(size_t capacity)
+{
+    i8080::MachinePool pool(capacity);
+    uint64_t checks = 0;
+    uint64_t failures = 0;
+    auto check = [&](bool passed, std::string_view what) {
+        checks++;
+        if (!passed) {
+            fmt::println("Failed: {}", what);
+            failures++;
+        }
+    };
+
+    auto rejects = [&pool](i8080::Machine* machine) {
+        try {
+            pool.destroy(machine);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+
+        return false;
+    };
+
+    std::vector<i8080::Machine*> machines;
+    for (size_t i = 0; i < capacity; i++) {
+        auto entry_point = static_cast<uint16_t>(PROGRAM_START_OFFSET + i);
+        machines.push_back(pool.create(entry_point));
+        check(machines.back() && machines.back()->cpu.state().pc == entry_point,
+              "create() returns a machine at its entry point");
+    }
+
+    std::vector<i8080::Machine*> distinct = machines;
+    std::ranges::sort(distinct);
+    check(std::ranges::adjacent_find(distinct) == distinct.end(), "every machine has a slot");
+    check(pool.size() == capacity, "size() counts every machine");
+    check(pool.create(PROGRAM_START_OFFSET) == nullptr, "create() returns nullptr when full");
+
+    // The slot freed last is reused first, and comes back zeroed
+    i8080::Machine* reused = machines[capacity / 2];
+    reused->memory[PROGRAM_START_OFFSET] = 0xff;
+    pool.destroy(reused);
+    check(pool.size() == capacity - 1, "destroy() frees the slot");
+    machines[capacity / 2] = pool.create(0);
+    check(machines[capacity / 2] == reused, "create() reuses the slot freed last");
+    check(reused->memory[PROGRAM_START_OFFSET] == 0, "a reused slot is zeroed");
+
+    auto foreign = std::make_unique<i8080::Machine>(0, i8080::Cpu::Timing::exact);
+    check(rejects(foreign.get()), "destroy() rejects a machine from elsewhere");
+    check(rejects(nullptr), "destroy() rejects nullptr");
+    check(rejects(reinterpret_cast<i8080::Machine*>(
+              reinterpret_cast<std::byte*>(machines[0]) + i8080::Machine::CACHE_LINE_SIZE)),
+          "destroy() rejects a pointer into the middle of a slot");
+
+    for (i8080::Machine* machine : machines) {
+        pool.destroy(machine);
+    }
+
+    check(pool.size() == 0, "destroying every machine empties the pool");
+    check(rejects(machines[0]), "destroy() rejects a machine destroyed already");
+
+    fmt::println("{} checks on a pool of {}, {} failures", checks, capacity, failures);
+    return failures;
+}
+
+// Talks to a GDB stub over its Unix domain socket the way GDB does, one packet at a time
+class GdbClient final
+{
+public:
+    explicit GdbClient(const fs::path& socket) :
+        _fd(::socket(AF_UNIX, SOCK_STREAM, 0))
+    {
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, socket.c_str(), sizeof(address.sun_path) - 1);
+
+        if (_fd < 0 ||
+            connect(_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            throw std::runtime_error(fmt::format("Could not connect to {}", socket.string()));
+        }
+    }
+
+    ~GdbClient() { close(_fd); }
+
+    GdbClient(const GdbClient&) = delete;
+    GdbClient& operator=(const GdbClient&) = delete;
+
+    // Sends the packet and returns the reply, or only waits for the acknowledgement when the
+    // guest is let run without the debugger waiting for it to stop
+    std::string request(std::string_view packet, bool wait_for_reply = true)
+    {
+        uint8_t checksum = 0;
+        for (char c : packet) {
+            checksum += static_cast<uint8_t>(c);
+        }
+
+        _write(fmt::format("${}#{:02x}", packet, checksum));
+        if (_read() != '+') {
+            throw std::runtime_error(fmt::format("{} was not acknowledged", packet));
+        }
+
+        if (!wait_for_reply) {
+            return {};
+        }
+
+        while (_read() != '$') {
+        }
+
+        std::string reply;
+        for (char c = _read(); c != '#'; c = _read()) {
+            reply.push_back(c);
+        }
+
+        _read();
+        _read();
+        _write("+");
+        return reply;
+    }
+
+private:
+    char _read()
+    {
+        char c = 0;
+        if (::read(_fd, &c, 1) != 1) {
+            throw std::runtime_error("The GDB stub closed the connection");
+        }
+
+        return c;
+    }
+
+    void _write(std::string_view data)
+    {
+        if (::write(_fd, data.data(), data.size()) != static_cast<ssize_t>(data.size())) {
+            throw std::runtime_error("Could not write to the GDB stub");
+        }
+    }
+
+    int _fd;
+};
+
+// Debugs a ROM through the GDB stub from a scripted client on another thread, checking every
+// reply and that the guest stops only where the debugger asked it to. The script is written
+// against test8080. Returns the number of mismatches.
+static uint64_t run_gdb_script(const fs::path& test_rom, const fs::path& socket)
+{
+    struct Exchange
+    {
+        std::string_view request;
+        std::string_view reply;
+    };
+
+    // Runs to the breakpoint on a STA TEMP0, then steps over the store with the byte watched
+    static constexpr std::array SCRIPT = {
+        Exchange { .request = "?", .reply = "S05" },
+        Exchange { .request = "Z0,52e,1", .reply = "OK" },
+        Exchange { .request = "c", .reply = "S05" },
+        Exchange { .request = "Z2,6bf,1", .reply = "OK" },
+        Exchange { .request = "s", .reply = "T05watch:6bf;" },
+        Exchange { .request = "m6bf,1", .reply = "aa" },
+        Exchange { .request = "z0,52e,1", .reply = "OK" },
+        Exchange { .request = "z2,6bf,1", .reply = "OK" },
+    };
+
+    buffer memory(i8080::Bus::MEMORY_SIZE);
+    load_binary(test_rom, memory);
+
+    i8080::Bus bus(memory);
+    i8080::Cpu cpu(bus, PROGRAM_START_OFFSET);
+
+    bool test_finished = false;
+    bus.register_device(0, std::make_shared<TestControlDevice>(test_finished, cpu));
+    bus.register_device(1, std::make_shared<IODevice>(cpu, memory));
+
+    i8080::GdbStub stub(cpu, bus, socket);
+
+    uint64_t mismatches = 0;
+    std::jthread client([&socket, &mismatches]() {
+        try {
+            GdbClient gdb(socket);
+            for (const Exchange& exchange : SCRIPT) {
+                std::string reply = gdb.request(exchange.request);
+                if (reply != exchange.reply) {
+                    fmt::println(
+                        "{}: expected {}, got {}", exchange.request, exchange.reply, reply);
+                    mismatches++;
+                }
+            }
+
+            gdb.request("c", false);
+        } catch (const std::exception& e) {
+            fmt::println("GDB client failed: {}", e.what());
+            mismatches++;
+        }
+    });
+
+    stub.wait_for_debugger();
+
+    uint64_t unexpected_stops = 0;
+    while (!test_finished && !cpu.halt()) {
+        if (stub.run(BATCH_SLICE_CYCLES) == i8080::Cpu::StopReason::stop && !test_finished) {
+            unexpected_stops++;
+        }
+    }
+
+    client.join();
+
+    fmt::println("{} packets exchanged, {} mismatches, {} stops the debugger did not ask for",
+                 SCRIPT.size() + 1,
+                 mismatches,
+                 unexpected_stops);
+    return mismatches + unexpected_stops;
+}
+
+#ifdef I8080_PROFILING
+// Runs a ROM with an opcode profile attached and prints it, then checks that the profile adds up
+// to the instructions and cycles the CPU counted. Returns whether it does not.
+static bool run_opcode_profile(const fs::path& test_rom, i8080::OpcodeProfile::Format format)
+{
+    buffer memory(i8080::Bus::MEMORY_SIZE);
+    load_binary(test_rom, memory);
+
+    i8080::Bus bus(memory);
+    i8080::Cpu cpu(bus, PROGRAM_START_OFFSET);
+
+    bool test_finished = false;
+    bus.register_device(0, std::make_shared<TestControlDevice>(test_finished, cpu));
+    bus.register_device(1, std::make_shared<IODevice>(cpu, memory));
+
+    i8080::OpcodeProfile profile(true);
+    cpu.set_profile(&profile);
+
+    while (!test_finished && !cpu.halt()) {
+        cpu.tick();
+    }
+
+    uint64_t executions = 0;
+    uint64_t cycles = 0;
+    for (size_t opcode = 0; opcode < 256; opcode++) {
+        executions += profile.executions(static_cast<i8080::Instruction>(opcode));
+        cycles += profile.cycles(static_cast<i8080::Instruction>(opcode));
+    }
+
+    fmt::print("\n{}", profile.report(format));
+    fmt::println("\n{} of {} instructions and {} of {} cycles profiled",
+                 executions,
+                 cpu.retired(),
+                 cycles,
+                 cpu.state().cycle);
+    return executions != cpu.retired() || cycles != cpu.state().cycle;
+}
+#endif
+
+static std::string_view outcome_name(Outcome outcome)
+{
+    switch (outcome) {
+    case Outcome::passed:
+        return "pass";
+    case Outcome::failed:
+        return "fail";
+    case Outcome::cycle_limit:
+        return "cycle limit";
+    case Outcome::timeout:
+        return "timeout";
+    case Outcome::error:
+        return "error";
+    }
+
+    return "unknown";
+}
+
+// The diagnostic ROMs report failures in their output rather than through an exit status
+static bool reports_failure(const std::string& console)
+{
+    return console.find("FAIL") != std::string::npos || console.find("ERROR") != std::string::npos;
+}
+
+static RomResult run_batch_rom(const fs::path& test_rom,
+                               const BatchOptions& options,
+                               i8080::ImageCache& images)
+{
+    RomResult result { .rom = test_rom };
+    auto start = std::chrono::steady_clock::now();
+
+    try {
+        std::optional<i8080::GuestMemory> mapped;
+        buffer copied;
+        std::span<uint8_t> memory;
+        if (options.shared_roms) {
+            mapped.emplace();
+            mapped->map(*images.load(test_rom, PROGRAM_START_OFFSET));
+            inject_test_hooks(*mapped);
+            memory = *mapped;
+        } else {
+            copied.resize(i8080::Bus::MEMORY_SIZE);
+            load_binary(test_rom, copied);
+            memory = copied;
+        }
+
+        i8080::Bus bus(memory);
+        i8080::Cpu cpu(bus,
+                       PROGRAM_START_OFFSET,
+                       options.fast ? i8080::Cpu::Timing::fast : i8080::Cpu::Timing::exact);
+
+        bool test_finished = false;
+        std::optional<i8080::Cpm> cpm;
+        if (options.cpm_directory) {
+            cpm.emplace(cpu,
+                        bus,
+                        i8080::Cpm::Config { .directory = *options.cpm_directory,
+                                             .console = [&result](std::string_view text) {
+                                                 result.console += text;
+                                             } });
+        } else {
+            bus.register_device(0, std::make_shared<TestControlDevice>(test_finished, cpu));
+            bus.register_device(1, std::make_shared<IODevice>(cpu, memory, &result.console));
+        }
+
+        const i8080::NativeProgram* program =
+            options.native ? find_native_program(memory) : nullptr;
+        if (program) {
+            cpu.set_native_code(program->code);
+        }
+
+        result.outcome = Outcome::cycle_limit;
+        while (!test_finished && !cpu.halt() && cpu.state().cycle < options.max_cycles) {
+            cpu.run(std::min(BATCH_SLICE_CYCLES, options.max_cycles - cpu.state().cycle));
+
+            if (std::chrono::steady_clock::now() - start > options.timeout) {
+                result.outcome = Outcome::timeout;
+                break;
+            }
+        }
+
+        if (cpm) {
+            cpm->flush();
+        }
+
+        if (test_finished || cpu.halt()) {
+            result.outcome = reports_failure(result.console) ? Outcome::failed : Outcome::passed;
+        }
+
+        result.cycles = cpu.state().cycle;
+    } catch (const std::exception& e) {
+        result.outcome = Outcome::error;
+        result.console = e.what();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.seconds = elapsed.count();
+    return result;
+}
+
+// Answers the workloads' polls, ready on every other status read, with data counting up
+class WorkloadPort : public i8080::Device
+{
+public:
+    explicit WorkloadPort(bool status) :
+        _status(status),
+        _value(0)
+    {}
+
+    void read(uint8_t& byte) override { byte = _status ? (++_value & 1) : _value++; }
+
+private:
+    bool _status;
+    uint8_t _value;
+};
+
+// Runs each workload to its end with both timings, returns the number of runs that did not halt
+static uint64_t run_workloads(const std::vector<i8080::WorkloadGenerator::Kind>& kinds,
+                              i8080::WorkloadGenerator::Config config)
+{
+    using i8080::WorkloadGenerator;
+
+    fmt::println("{:<15} {:<6} {:<12} {:>12} {:>14} {:>10}",
+                 "workload",
+                 "timing",
+                 "result",
+                 "instructions",
+                 "cycles",
+                 "MIPS");
+
+    uint64_t runs = 0;
+    uint64_t unfinished = 0;
+    for (WorkloadGenerator::Kind kind : kinds) {
+        config.kind = kind;
+        buffer program = WorkloadGenerator(config).generate();
+
+        for (i8080::Cpu::Timing timing : { i8080::Cpu::Timing::exact, i8080::Cpu::Timing::fast }) {
+            buffer memory(i8080::Bus::MEMORY_SIZE);
+            std::ranges::copy(program, memory.begin() + WorkloadGenerator::ORIGIN);
+
+            i8080::Bus bus(memory);
+            i8080::Cpu cpu(bus, WorkloadGenerator::ORIGIN, timing);
+            bus.register_device(WorkloadGenerator::STATUS_PORT,
+                                std::make_shared<WorkloadPort>(true));
+            bus.register_device(WorkloadGenerator::DATA_PORT,
+                                std::make_shared<WorkloadPort>(false));
+
+            auto start = std::chrono::steady_clock::now();
+            while (!cpu.halt() && cpu.state().cycle < WORKLOAD_MAX_CYCLES) {
+                cpu.run(BATCH_SLICE_CYCLES);
+            }
+
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            runs++;
+            unfinished += !cpu.halt();
+            fmt::println("{:<15} {:<6} {:<12} {:>12} {:>14} {:>10.2f}",
+                         WorkloadGenerator::kind_name(kind),
+                         (timing == i8080::Cpu::Timing::exact) ? "exact" : "fast",
+                         cpu.halt() ? "halted" : "cycle limit",
+                         cpu.retired(),
+                         cpu.state().cycle,
+                         cpu.retired() / elapsed.count() / 1e6);
+        }
+    }
+
+    fmt::println("\n{} of {} runs halted", runs - unfinished, runs);
+    return unfinished;
+}
+
+// Files are taken as they are, directories for the .com files directly inside them
+static std::vector<fs::path> collect_roms(const std::vector<fs::path>& paths)
+{
+    std::vector<fs::path> roms;
+    for (const fs::path& path : paths) {
+        if (!fs::is_directory(path)) {
+            roms.push_back(path);
+            continue;
+        }
+
+        std::vector<fs::path> found;
+        for (const fs::directory_entry& entry : fs::directory_iterator(path)) {
+            std::string extension = entry.path().extension().string();
+            std::ranges::transform(extension, extension.begin(), [](unsigned char c) {
+                return std::tolower(c);
+            });
+
+            if (entry.is_regular_file() && extension == ".com") {
+                found.push_back(entry.path());
+            }
+        }
+
+        std::ranges::sort(found);
+        roms.insert(roms.end(), found.begin(), found.end());
+    }
+
+    return roms;
+}
+
+static std::string json_escape(std::string_view text)
+{
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped.push_back('\\');
+            escaped.push_back(c);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += fmt::format("\\u{:04x}", c);
+        } else {
+            escaped.push_back(c);
+        }
+    }
+
+    return escaped;
+}
+
+static void write_batch_json(const fs::path& path,
+                             const std::vector<RomResult>& results,
+                             double seconds)
+{
+    auto out = fmt::output_file(path.string());
+    out.print("{{\n  \"seconds\": {:.6f},\n  \"roms\": [\n", seconds);
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const RomResult& result = results[i];
+        out.print("    {{\"rom\": \"{}\", \"result\": \"{}\", \"cycles\": {}, "
+                  "\"seconds\": {:.6f}, \"emulated_mhz\": {:.3f}, \"console\": \"{}\"}}{}\n",
+                  json_escape(result.rom.string()),
+                  outcome_name(result.outcome),
+                  result.cycles,
+                  result.seconds,
+                  result.emulated_mhz(),
+                  json_escape(result.console),
+                  (i + 1 < results.size()) ? "," : "");
+    }
+
+    out.print("  ]\n}}\n");
+}
+
+// Runs the ROMs on a pool of threads, returns the number that did not pass
+static uint64_t run_batch(const BatchOptions& options)
+{
+    std::vector<fs::path> roms = collect_roms(options.roms);
+    std::vector<RomResult> results(roms.size());
+    std::atomic<size_t> next_rom = 0;
+    std::mutex print_lock;
+    i8080::ImageCache images;
+
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&]() {
+        for (size_t i = next_rom++; i < roms.size(); i = next_rom++) {
+            results[i] = run_batch_rom(roms[i], options, images);
+
+            std::lock_guard lock(print_lock);
+            fmt::println("{:<11} {}", outcome_name(results[i].outcome), roms[i].string());
+        }
+    };
+
+    std::vector<std::jthread> workers;
+    for (size_t i = 0; i < std::min<size_t>(options.jobs, roms.size()); i++) {
+        workers.emplace_back(worker);
+    }
+
+    workers.clear();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double seconds = elapsed.count();
+
+    size_t name_width = 3;
+    for (const fs::path& rom : roms) {
+        name_width = std::max(name_width, rom.filename().string().size());
+    }
+
+    fmt::println("\n{:<{}} {:<11} {:>16} {:>10} {:>10}",
+                 "rom",
+                 name_width,
+                 "result",
+                 "cycles",
+                 "seconds",
+                 "MHz");
+
+    uint64_t unsuccessful = 0;
+    for (const RomResult& result : results) {
+        unsuccessful += (result.outcome != Outcome::passed);
+        fmt::println("{:<{}} {:<11} {:>16} {:>10.3f} {:>10.2f}",
+                     result.rom.filename().string(),
+                     name_width,
+                     outcome_name(result.outcome),
+                     result.cycles,
+                     result.seconds,
+                     result.emulated_mhz());
+    }
+
+    fmt::println("\n{} of {} ROMs passed in {:.3f} s",
+                 results.size() - unsuccessful,
+                 results.size(),
+                 seconds);
+
+    // The output of the failures, to see what went wrong without a rerun
+    for (const RomResult& result : results) {
+        if (result.outcome != Outcome::passed && !result.console.empty()) {
+            fmt::print("\n{}:\n{}\n", result.rom.string(), result.console);
+        }
+    }
+
+    if (options.json) {
+        write_batch_json(*options.json, results, seconds);
+    }
+
+    return unsuccessful;
+}
+
 int main(int argc, char* argv[])
 {
-    if (argc != 2) {
+    if (argc >= 3 && std::string(argv[1]) == "--cosim") {
+        uint64_t steps = (argc > 3) ? std::stoull(argv[3]) : DEFAULT_COSIM_STEPS;
+        auto timing = i8080::Cpu::Timing::exact;
+        if (argc > 4 && std::string(argv[4]) == "fast") {
+            timing = i8080::Cpu::Timing::fast;
+        } else if (argc > 4 && std::string(argv[4]) != "exact") {
+            fmt::println("Unknown timing: {}", argv[4]);
+            return 1;
+        }
+
+        uint64_t divergences = run_cosim(std::stoull(argv[2]), steps, timing);
+
+        fmt::println("{} divergent scenarios", divergences);
+        return divergences ? 3 : 0;
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--cosim-native") {
+        try {
+            uint64_t steps = (argc > 3) ? std::stoull(argv[3]) : DEFAULT_COSIM_STEPS;
+            return run_cosim_native(argv[2], steps) ? 3 : 0;
+        } catch (const std::exception& e) {
+            fmt::println("Co-simulation failed: {}\n", e.what());
+            return 2;
+        }
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--reverse") {
+        try {
+            uint64_t interval = (argc > 3) ? std::stoull(argv[3]) : DEFAULT_CHECKPOINT_INTERVAL;
+            return run_reverse(argv[2], interval) ? 3 : 0;
+        } catch (const std::exception& e) {
+            fmt::println("Reverse stepping failed: {}\n", e.what());
+            return 2;
+        }
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--timer") {
+        try {
+            uint64_t period = (argc > 3) ? std::stoull(argv[3]) : DEFAULT_TIMER_PERIOD;
+            fmt::println("\nCPU ran {} cycles", run_timer(argv[2], period));
+            return 0;
+        } catch (const std::exception& e) {
+            fmt::println("Test failed: {}\n", e.what());
+            return 2;
+        }
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--system") {
+        try {
+            uint64_t quantum = (argc > 3) ? std::stoull(argv[3])
+                                          : i8080::System::DEFAULT_QUANTUM;
+            return run_system(argv[2], quantum) ? 3 : 0;
+        } catch (const std::exception& e) {
+            fmt::println("Test failed: {}\n", e.what());
+            return 2;
+        }
+    }
+
+    if (argc == 4 && std::string(argv[1]) == "--metrics") {
+        try {
+            return run_metrics(argv[2], argv[3]) ? 3 : 0;
+        } catch (const std::exception& e) {
+            fmt::println("Test failed: {}\n", e.what());
+            return 2;
+        }
+    }
+
+    if (argc >= 2 && std::string(argv[1]) == "--pool") {
+        try {
+            size_t capacity = (argc > 2) ? std::stoull(argv[2]) : DEFAULT_POOL_CAPACITY;
+            return run_pool(capacity) ? 3 : 0;
+        } catch (const std::exception& e) {
+            fmt::println("Test failed: {}\n", e.what());
+            return 2;
+        }
+    }
+
+    if (argc == 4 && std::string(argv[1]) == "--gdb-script") {
+        try {
+            return run_gdb_script(argv[2], argv[3]) ? 3 : 0;
+        } catch (const std::exception& e) {
+            fmt::println("Test failed: {}\n", e.what());
+            return 2;
+        }
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--opcode-profile") {
+#ifdef I8080_PROFILING
+        auto format = i8080::OpcodeProfile::Format::text;
+        if (argc > 3 && std::string(argv[3]) == "json") {
+            format = i8080::OpcodeProfile::Format::json;
+        } else if (argc > 3 && std::string(argv[3]) != "text") {
+            fmt::println("Unknown format: {}", argv[3]);
+            return 1;
+        }
+
+        try {
+            return run_opcode_profile(argv[2], format) ? 3 : 0;
+        } catch (const std::exception& e) {
+            fmt::println("Test failed: {}\n", e.what());
+            return 2;
+        }
+#else
+        fmt::println("Opcode profiles need a build with I8080_PROFILING");
+        return 1;
+#endif
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--disasm") {
+        try {
+            std::optional<fs::path> reference;
+            if (argc > 3) {
+                reference = argv[3];
+            }
+
+            return run_disasm(argv[2], reference) ? 3 : 0;
+        } catch (const std::exception& e) {
+            fmt::println("Disassembly failed: {}\n", e.what());
+            return 2;
+        }
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--batch") {
+        BatchOptions options;
+        for (int i = 2; i < argc; i++) {
+            std::string argument = argv[i];
+            bool has_value = (i + 1 < argc);
+
+            if (argument == "--jobs" && has_value) {
+                options.jobs = std::max(std::stoul(argv[++i]), 1ul);
+            } else if (argument == "--max-cycles" && has_value) {
+                options.max_cycles = std::stoull(argv[++i]);
+            } else if (argument == "--timeout" && has_value) {
+                options.timeout = std::chrono::duration<double>(std::stod(argv[++i]));
+            } else if (argument == "--json" && has_value) {
+                options.json = argv[++i];
+            } else if (argument == "--cpm" && has_value) {
+                options.cpm_directory = argv[++i];
+            } else if (argument == "--native") {
+                options.native = true;
+            } else if (argument == "--fast") {
+                options.fast = true;
+            } else if (argument == "--shared-roms") {
+                options.shared_roms = true;
+            } else {
+                options.roms.emplace_back(argument);
+            }
+        }
+
+        try {
+            return run_batch(options) ? 3 : 0;
+        } catch (const std::exception& e) {
+            fmt::println("Batch failed: {}\n", e.what());
+            return 2;
+        }
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--workload") {
+        using i8080::WorkloadGenerator;
+
+        std::vector<WorkloadGenerator::Kind> kinds(WorkloadGenerator::KINDS.begin(),
+                                                   WorkloadGenerator::KINDS.end());
+        if (std::string(argv[2]) != "all") {
+            std::optional<WorkloadGenerator::Kind> kind = WorkloadGenerator::parse_kind(argv[2]);
+            if (!kind) {
+                fmt::println("Unknown workload: {}", argv[2]);
+                return 1;
+            }
+
+            kinds = { *kind };
+        }
+
+        WorkloadGenerator::Config config { .iterations = DEFAULT_WORKLOAD_ITERATIONS };
+        config.seed = (argc > 3) ? std::stoull(argv[3]) : config.seed;
+        config.length = (argc > 4) ? std::stoull(argv[4]) : config.length;
+        config.working_set = (argc > 5) ? std::stoull(argv[5], nullptr, 0) : config.working_set;
+
+        try {
+            return run_workloads(kinds, config) ? 3 : 0;
+        } catch (const std::exception& e) {
+            fmt::println("Workload failed: {}", e.what());
+            return 2;
+        }
+    }
+
+    RunOptions options;
+    const char* test_rom = argv[1];
+    if (argc >= 5 && std::string(argv[1]) == "--profile") {
+        options.profile = ProfileOptions { .listing = argv[3], .folded_output = argv[4] };
+        if (argc > 5) {
+            options.profile->interval = std::stoull(argv[5]);
+        }
+
+        test_rom = argv[2];
+    } else if (argc == 5 && std::string(argv[1]) == "--callgraph") {
+        options.profile = ProfileOptions { .listing = argv[3], .callgrind_output = argv[4] };
+        test_rom = argv[2];
+    } else if (argc >= 4 && std::string(argv[1]) == "--heatmap") {
+        options.heatmap = HeatmapOptions { .output = argv[3] };
+        if (argc > 4) {
+            options.heatmap->window = std::stoull(argv[4]);
+        }
+
+        test_rom = argv[2];
+    } else if (argc == 3 && std::string(argv[1]) == "--native") {
+        options.native = true;
+        test_rom = argv[2];
+    } else if (argc >= 4 && argc <= 5 &&
+               (std::string(argv[1]) == "--break" || std::string(argv[1]) == "--watch")) {
+        options.stop = StopOptions { .watch = (std::string(argv[1]) == "--watch"),
+                                     .address = static_cast<uint16_t>(
+                                         std::stoul(argv[3], nullptr, 0)) };
+        if (argc > 4) {
+            options.stop->condition = argv[4];
+        }
+
+        test_rom = argv[2];
+    } else if (argc >= 4 && std::string(argv[1]) == "--cpm") {
+        options.cpm = CpmOptions { .directory = argv[3],
+                                   .arguments = std::vector<std::string>(argv + 4, argv + argc) };
+        test_rom = argv[2];
+    } else if (argc == 4 && std::string(argv[1]) == "--gdb") {
+        options.gdb_socket = argv[3];
+        test_rom = argv[2];
+    } else if ((argc == 3 || argc == 4) && std::string(argv[1]) == "--realtime") {
+        options.realtime_hz = (argc == 4) ? std::stoull(argv[3]) : i8080::Pacer::DEFAULT_CLOCK_HZ;
+        test_rom = argv[2];
+    } else if (argc == 4 && std::string(argv[1]) == "--trace") {
+        options.trace = argv[3];
+        test_rom = argv[2];
+    } else if (argc != 2) {
         fmt::println("Usage: tester <test_rom>");
+        fmt::println("       tester --cosim <scenarios> [steps] [exact|fast]");
+        fmt::println("       tester --cosim-native <test_rom> [steps]");
+        fmt::println("       tester --reverse <test_rom> [checkpoint_interval]");
+        fmt::println("       tester --timer <test_rom> [period]");
+        fmt::println("       tester --system <test_rom> [quantum]");
+        fmt::println("       tester --profile <test_rom> <listing> <folded_output> [interval]");
+        fmt::println("       tester --callgraph <test_rom> <listing> <callgrind_output>");
+        fmt::println("       tester --opcode-profile <test_rom> [text|json]");
+        fmt::println("       tester --trace <test_rom> <trace_output>");
+        fmt::println("       tester --realtime <test_rom> [clock_hz]");
+        fmt::println("       tester --metrics <test_rom> <prometheus_output>");
+        fmt::println("       tester --heatmap <test_rom> <heatmap_output> [window_cycles]");
+        fmt::println("       tester --disasm <test_rom> [reference_listing]");
+        fmt::println("       tester --native <test_rom>");
+        fmt::println("       tester --break <test_rom> <address> [condition]");
+        fmt::println("       tester --watch <test_rom> <address> [condition]");
+        fmt::println("       tester --gdb <test_rom> <socket>");
+        fmt::println("       tester --gdb-script <test_rom> <socket>");
+        fmt::println("       tester --cpm <program> <directory> [arguments]...");
+        fmt::println("       tester --batch [--jobs <n>] [--max-cycles <n>] [--timeout <seconds>] "
+                     "[--json <output>] [--native] [--fast] [--shared-roms] [--cpm <directory>] "
+                     "<test_rom|directory>...");
+        fmt::println("       tester --workload <kind|all> [seed] [length] [working_set]");
+        fmt::println("       tester --pool [capacity]");
         return 1;
     }
 
     try {
-        fmt::println("\nCPU ran {} cycles", run_test(argv[1], false));
+        fmt::println("\nCPU ran {} cycles", run_test(test_rom, options));
     } catch (const std::exception& e) {
         fmt::println("Test failed: {}\n", e.what());
         return 2;
@@ -0,0 +1,48 @@
+# cmake -DTESTER=<tester> -DTRACEDUMP=<tracedump> -DROM=<test_rom> -DTRACE=<trace_file>
+#       -DRECORDS=<count> -P check_trace.cmake
+#
+# Records a trace of the ROM with the tester, decodes it with tracedump and checks that it holds
+# one record per instruction, each on a line in print_dissassembly's format followed by the
+# registers.
+execute_process(
+    COMMAND ${TESTER} --trace ${ROM} ${TRACE}
+    RESULT_VARIABLE RESULT
+    OUTPUT_QUIET
+)
+
+if(NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "Tracing ${ROM} failed: ${RESULT}")
+endif()
+
+execute_process(
+    COMMAND ${TRACEDUMP} ${TRACE}
+    RESULT_VARIABLE RESULT
+    OUTPUT_VARIABLE DUMP
+)
+
+if(NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "Decoding ${TRACE} failed: ${RESULT}")
+endif()
+
+set(HEX "[0-9a-f]")
+set(WORD "0x${HEX}${HEX}${HEX}${HEX}")
+set(INSTRUCTION "${WORD}    [A-Z][A-Z0-9]*( [A-Z]+(, [A-Z]+)?,?)?( ${WORD})?")
+# The registers follow a ';', which is turned into a '#' below so lines can become a list
+set(REGISTERS "    # cycle=[0-9]+ af=${WORD} bc=${WORD} de=${WORD} hl=${WORD} sp=${WORD}")
+
+string(REGEX REPLACE "\n$" "" DUMP "${DUMP}")
+string(REPLACE ";" "#" DUMP "${DUMP}")
+string(REPLACE "\n" ";" LINES "${DUMP}")
+list(LENGTH LINES COUNT)
+
+if(NOT COUNT EQUAL RECORDS)
+    message(FATAL_ERROR "Expected ${RECORDS} records, decoded ${COUNT}")
+endif()
+
+foreach(LINE IN LISTS LINES)
+    if(NOT LINE MATCHES "^${INSTRUCTION}${REGISTERS}$")
+        message(FATAL_ERROR "Not a decoded record: ${LINE}")
+    endif()
+endforeach()
+
+message(STATUS "${COUNT} records decoded")
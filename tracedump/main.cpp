@@ -0,0 +1,36 @@
+#include <i8080/trace.h>
+
+#include <fmt/core.h>
+
+#include <cstdio>
+#include <exception>
+
+// Flushing in chunks keeps the buffer small without paying for a write per record
+static constexpr size_t FLUSH_THRESHOLD = 1 << 16;
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2) {
+        fmt::println("Usage: tracedump <trace_file>");
+        return 1;
+    }
+
+    try {
+        fmt::memory_buffer out;
+        for (const i8080::TraceRecord& record : i8080::read_trace(argv[1])) {
+            i8080::decode_trace(out, record);
+
+            if (out.size() >= FLUSH_THRESHOLD) {
+                std::fwrite(out.data(), 1, out.size(), stdout);
+                out.clear();
+            }
+        }
+
+        std::fwrite(out.data(), 1, out.size(), stdout);
+    } catch (const std::exception& e) {
+        fmt::println(stderr, "Decoding failed: {}", e.what());
+        return 2;
+    }
+
+    return 0;
+}